@@ -27,6 +27,57 @@ struct ParasiteProcessor::CurveListener : public juce::AudioProcessorValueTreeSt
     ParasiteProcessor& proc;
 };
 
+// INTERNAL_RATE listener: a rate change re-prepares every DSP object, which
+// allocates — so it is deferred to the message thread, never done in the
+// callback that reported the change.
+struct ParasiteProcessor::EngineRateListener : public juce::AudioProcessorValueTreeState::Listener,
+                                               private juce::AsyncUpdater
+{
+    explicit EngineRateListener(ParasiteProcessor& p) : proc(p) {}
+    ~EngineRateListener() override { cancelPendingUpdate(); }
+
+    void parameterChanged(const juce::String&, float) override { triggerAsyncUpdate(); }
+
+    void handleAsyncUpdate() override
+    {
+        const double hostRate = proc.getSampleRate();
+        if (hostRate <= 0.0
+            || engineFactorFor(hostRate, proc.internalRateParam->load() > 0.5f) == proc.engineFactor)
+            return;
+        proc.suspendProcessing(true);
+        proc.prepareToPlay(hostRate, proc.getBlockSize());
+        proc.suspendProcessing(false);
+    }
+
+    ParasiteProcessor& proc;
+};
+
+// MULTICORE listener: worker threads are started and stopped on the
+// message thread, so the pool only exists while multi-core is on.
+struct ParasiteProcessor::MulticoreListener : public juce::AudioProcessorValueTreeState::Listener,
+                                              private juce::AsyncUpdater
+{
+    explicit MulticoreListener(ParasiteProcessor& p) : proc(p) {}
+    ~MulticoreListener() override { cancelPendingUpdate(); }
+
+    void parameterChanged(const juce::String&, float) override { triggerAsyncUpdate(); }
+    void handleAsyncUpdate() override { proc.updateVoicePool(); }
+
+    ParasiteProcessor& proc;
+};
+
+// Any parameter change: the per-block derived state (voice snapshot, FX
+// coefficients) must be recomputed. Runs on whatever thread set the value,
+// so it only advances the atomic generation.
+struct ParasiteProcessor::GenerationListener : public juce::AudioProcessorValueTreeState::Listener
+{
+    explicit GenerationListener(ParasiteProcessor& p) : proc(p) {}
+
+    void parameterChanged(const juce::String&, float) override { proc.voiceParams.bumpGeneration(); }
+
+    ParasiteProcessor& proc;
+};
+
 ParasiteProcessor::ParasiteProcessor()
     : AudioProcessor(BusesProperties()
                      .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
@@ -44,11 +95,13 @@ ParasiteProcessor::ParasiteProcessor()
     voiceParams.mod2Harmonics = &mod2Harmonics;
     voiceParams.carHarmonics  = &carHarmonics;
 
-    // 8 voices for polyphony — idle voices cost nothing (early return in renderNextBlock)
+    // Full voice pool allocated once; POLYPHONY only bounds how many of them
+    // the allocator may use. Only the allocator's active voices are rendered.
     synth.addSound(new bb::FMSound());
-    for (int i = 0; i < 8; ++i)
+    for (int i = 0; i < bb::FMSynth::kMaxVoices; ++i)
         synth.addVoice(new bb::FMVoice(voiceParams));
     synth.setNoteStealingEnabled(true);
+    synth.setBlockParams(&voiceBlockParams);
 
     // Register curve listeners AFTER param layout is built and pointers cached.
     // Then push initial internal state into the params so defaults stay in sync.
@@ -57,6 +110,17 @@ ParasiteProcessor::ParasiteProcessor()
     // Matches the post-preset-load pattern: no undo entries from the sync.
     undoManager.clearUndoHistory();
 
+    engineRateListener = std::make_unique<EngineRateListener>(*this);
+    apvts.addParameterListener("INTERNAL_RATE", engineRateListener.get());
+
+    multicoreListener = std::make_unique<MulticoreListener>(*this);
+    apvts.addParameterListener("MULTICORE", multicoreListener.get());
+
+    generationListener = std::make_unique<GenerationListener>(*this);
+    for (auto* param : getParameters())
+        if (auto* withId = dynamic_cast<juce::AudioProcessorParameterWithID*>(param))
+            apvts.addParameterListener(withId->paramID, generationListener.get());
+
     buildPresetRegistry();
     loadFavorites();
 
@@ -72,6 +136,11 @@ ParasiteProcessor::ParasiteProcessor()
 ParasiteProcessor::~ParasiteProcessor()
 {
     licenseManager.removeListener(this);
+    apvts.removeParameterListener("INTERNAL_RATE", engineRateListener.get());
+    apvts.removeParameterListener("MULTICORE", multicoreListener.get());
+    for (auto* param : getParameters())
+        if (auto* withId = dynamic_cast<juce::AudioProcessorParameterWithID*>(param))
+            apvts.removeParameterListener(withId->paramID, generationListener.get());
     // Explicit unregister so APVTS doesn't call into freed listener
     if (curveListener)
     {
@@ -196,6 +265,21 @@ void ParasiteProcessor::cacheParameterPointers()
     voiceParams.env2S         = apvts.getRawParameterValue("ENV2_S");
     voiceParams.env2R         = apvts.getRawParameterValue("ENV2_R");
 
+    voiceParams.mod3On        = apvts.getRawParameterValue("MOD3_ON");
+    voiceParams.opAlgo        = apvts.getRawParameterValue("OP_ALGO");
+    voiceParams.mod3Wave      = apvts.getRawParameterValue("MOD3_WAVE");
+    voiceParams.mod3KB        = apvts.getRawParameterValue("MOD3_KB");
+    voiceParams.mod3Level     = apvts.getRawParameterValue("MOD3_LEVEL");
+    voiceParams.mod3Coarse    = apvts.getRawParameterValue("MOD3_COARSE");
+    voiceParams.mod3Fine      = apvts.getRawParameterValue("MOD3_FINE");
+    voiceParams.mod3FixedFreq = apvts.getRawParameterValue("MOD3_FIXED_FREQ");
+    voiceParams.mod3Multi     = apvts.getRawParameterValue("MOD3_MULTI");
+    voiceParams.mod3Feedback  = apvts.getRawParameterValue("MOD3_FB");
+    voiceParams.env4A         = apvts.getRawParameterValue("ENV4_A");
+    voiceParams.env4D         = apvts.getRawParameterValue("ENV4_D");
+    voiceParams.env4S         = apvts.getRawParameterValue("ENV4_S");
+    voiceParams.env4R         = apvts.getRawParameterValue("ENV4_R");
+
     voiceParams.carWave      = apvts.getRawParameterValue("CAR_WAVE");
     voiceParams.carCoarse    = apvts.getRawParameterValue("CAR_COARSE");
     voiceParams.carFine      = apvts.getRawParameterValue("CAR_FINE");
@@ -204,6 +288,10 @@ void ParasiteProcessor::cacheParameterPointers()
     voiceParams.carKB        = apvts.getRawParameterValue("CAR_KB");
     voiceParams.carNoise     = apvts.getRawParameterValue("CAR_NOISE");
     voiceParams.carSpread    = apvts.getRawParameterValue("CAR_SPREAD");
+    voiceParams.unison       = apvts.getRawParameterValue("UNISON");
+    voiceParams.unisonDetune = apvts.getRawParameterValue("UNISON_DETUNE");
+    voiceParams.unisonBlend  = apvts.getRawParameterValue("UNISON_BLEND");
+    voiceParams.unisonWidth  = apvts.getRawParameterValue("UNISON_WIDTH");
     voiceParams.env3A        = apvts.getRawParameterValue("ENV3_A");
     voiceParams.env3D      = apvts.getRawParameterValue("ENV3_D");
     voiceParams.env3S      = apvts.getRawParameterValue("ENV3_S");
@@ -241,6 +329,17 @@ void ParasiteProcessor::cacheParameterPointers()
     voiceParams.plasma     = apvts.getRawParameterValue("PLASMA");
     voiceParams.macroTime  = apvts.getRawParameterValue("MACRO_TIME");
     voiceParams.octave     = apvts.getRawParameterValue("OCTAVE");
+    voiceParams.modRate    = apvts.getRawParameterValue("MOD_RATE");
+    voiceParams.oversampling = apvts.getRawParameterValue("OVERSAMPLE");
+    voiceParams.antialias  = apvts.getRawParameterValue("ANTIALIAS");
+    voiceParams.noteCache  = apvts.getRawParameterValue("NOTE_CACHE");
+    voiceParams.renderCache = &noteCache;
+    internalRateParam = apvts.getRawParameterValue("INTERNAL_RATE");
+    polyphonyParam = apvts.getRawParameterValue("POLYPHONY");
+    voiceStealParam = apvts.getRawParameterValue("VOICE_STEAL");
+    notePriorityParam = apvts.getRawParameterValue("MONO_PRIORITY");
+    multicoreParam = apvts.getRawParameterValue("MULTICORE");
+    multicoreVoicesParam = apvts.getRawParameterValue("MULTICORE_VOICES");
 
     // FX on/off pointers
     dlyOnParam   = apvts.getRawParameterValue("DLY_ON");
@@ -363,6 +462,39 @@ ParasiteProcessor::createParameterLayout()
         groups.push_back(std::move(g));
     }
 
+    // --- Groupe Modulateur 3 (mode 4 opérateurs) ---
+    // MOD3_ON remplace FM_ALGO par un des 8 graphes de OperatorGraph.h
+    // (op 1 = carrier, op 2 = Mod1, op 3 = Mod2, op 4 = Mod3 avec feedback)
+    {
+        auto g = std::make_unique<juce::AudioProcessorParameterGroup>("mod3", "Modulator 3", "|");
+        g->addChild(std::make_unique<SnappedParameterBool>("MOD3_ON", "4-Op Mode", false));
+        g->addChild(std::make_unique<juce::AudioParameterChoice>("OP_ALGO", "4-Op Algorithm",
+            juce::StringArray{ "4>3>2>1", "(3+4)>2>1", "3>2>1 + 4>1", "2>1 + 4>3>1",
+                               "2>1 | 4>3", "4>(1|2|3)", "4>3 | 2 | 1", "1 | 2 | 3 | 4" }, 0));
+        g->addChild(std::make_unique<juce::AudioParameterChoice>("MOD3_WAVE", "Mod3 Wave",
+            juce::StringArray{ "Sine", "Saw", "Square", "Triangle", "Pulse" }, 0));
+        g->addChild(std::make_unique<SnappedParameterBool>("MOD3_KB", "Mod3 KB", true));
+        g->addChild(std::make_unique<juce::AudioParameterFloat>("MOD3_LEVEL", "Mod3 Level",
+            juce::NormalisableRange<float>(0.0f, 1.0f), 0.3f));
+        g->addChild(std::make_unique<juce::AudioParameterInt>("MOD3_COARSE", "Mod3 Coarse", 0, 48, 1));
+        g->addChild(std::make_unique<juce::AudioParameterFloat>("MOD3_FINE", "Mod3 Fine",
+            juce::NormalisableRange<float>(-1000.0f, 1000.0f, 0.1f), 0.0f));
+        g->addChild(std::make_unique<juce::AudioParameterFloat>("MOD3_FIXED_FREQ", "Mod3 Fixed Freq",
+            juce::NormalisableRange<float>(20.0f, 16000.0f, 0.0f, 0.3f), 440.0f));
+        g->addChild(std::make_unique<juce::AudioParameterInt>("MOD3_MULTI", "Mod3 Multi", 0, 5, 4));
+        g->addChild(std::make_unique<juce::AudioParameterFloat>("MOD3_FB", "Mod3 Feedback",
+            juce::NormalisableRange<float>(0.0f, 1.0f), 0.0f));
+        g->addChild(std::make_unique<juce::AudioParameterFloat>("ENV4_A", "Env4 Attack",
+            juce::NormalisableRange<float>(0.0f, 5.0f, 0.0f, 0.3f), 0.01f));
+        g->addChild(std::make_unique<juce::AudioParameterFloat>("ENV4_D", "Env4 Decay",
+            juce::NormalisableRange<float>(0.0f, 5.0f, 0.0f, 0.3f), 0.3f));
+        g->addChild(std::make_unique<juce::AudioParameterFloat>("ENV4_S", "Env4 Sustain",
+            juce::NormalisableRange<float>(0.0f, 1.0f), 0.7f));
+        g->addChild(std::make_unique<juce::AudioParameterFloat>("ENV4_R", "Env4 Release",
+            juce::NormalisableRange<float>(0.0f, 8.0f, 0.0f, 0.3f), 0.3f));
+        groups.push_back(std::move(g));
+    }
+
     // --- Groupe Carrier ---
     {
         auto g = std::make_unique<juce::AudioProcessorParameterGroup>("carrier", "Carrier", "|");
@@ -389,6 +521,14 @@ ParasiteProcessor::createParameterLayout()
             juce::NormalisableRange<float>(0.0f, 1.0f), 0.0f));
         g->addChild(std::make_unique<juce::AudioParameterFloat>("CAR_SPREAD", "Carrier Spread",
             juce::NormalisableRange<float>(0.0f, 1.0f), 0.0f));
+        // Unison : copies du carrier par voix, une seule passe de modulateurs
+        g->addChild(std::make_unique<juce::AudioParameterInt>("UNISON", "Unison Voices", 1, 8, 1));
+        g->addChild(std::make_unique<juce::AudioParameterFloat>("UNISON_DETUNE", "Unison Detune",
+            juce::NormalisableRange<float>(0.0f, 1.0f), 0.25f));
+        g->addChild(std::make_unique<juce::AudioParameterFloat>("UNISON_BLEND", "Unison Blend",
+            juce::NormalisableRange<float>(0.0f, 1.0f), 0.75f));
+        g->addChild(std::make_unique<juce::AudioParameterFloat>("UNISON_WIDTH", "Unison Width",
+            juce::NormalisableRange<float>(0.0f, 1.0f), 0.5f));
         groups.push_back(std::move(g));
     }
 
@@ -590,6 +730,17 @@ ParasiteProcessor::createParameterLayout()
             juce::NormalisableRange<float>(1.0f, 10.0f, 0.01f, 0.5f), 1.0f));
         g->addChild(std::make_unique<SnappedParameterBool>("MONO", "Mono", true));
         g->addChild(std::make_unique<SnappedParameterBool>("RETRIG", "Retrigger", true));
+        // Mono: which held key sounds (order matches bb::FMSynth::NotePriority).
+        // With Retrigger off, note changes are legato (no envelope restart).
+        g->addChild(std::make_unique<juce::AudioParameterChoice>("MONO_PRIORITY", "Note Priority",
+            juce::StringArray{ "Last", "Low", "High" }, 0));
+        // Voices the allocator may use (the pool is always kMaxVoices deep)
+        g->addChild(std::make_unique<juce::AudioParameterInt>("POLYPHONY", "Polyphony",
+            1, bb::FMSynth::kMaxVoices, 8));
+        // Which voice a new note takes once all of them are playing
+        // (order matches bb::FMSynth::StealPolicy)
+        g->addChild(std::make_unique<juce::AudioParameterChoice>("VOICE_STEAL", "Voice Stealing",
+            juce::StringArray{ "Oldest", "Quietest", "Same note" }, 0));
         g->addChild(std::make_unique<juce::AudioParameterFloat>("PORTA", "Portamento",
             juce::NormalisableRange<float>(0.0f, 1.0f, 0.001f, 0.5f), 0.0f));
         g->addChild(std::make_unique<juce::AudioParameterFloat>("DISP_AMT", "HemoFold",
@@ -603,6 +754,33 @@ ParasiteProcessor::createParameterLayout()
         g->addChild(std::make_unique<juce::AudioParameterFloat>("MACRO_TIME", "Time",
             juce::NormalisableRange<float>(0.0f, 1.0f), 0.5f));
         g->addChild(std::make_unique<juce::AudioParameterInt>("OCTAVE", "Octave", -4, 4, 0));
+        // Modulation resolution (pitch / cutoff / drift control points).
+        // Offline renders always run per-sample regardless of this choice.
+        g->addChild(std::make_unique<juce::AudioParameterChoice>("MOD_RATE", "Mod Rate",
+            juce::StringArray{ "Per-sample", "8", "16", "32" }, 2));
+        // Voice oversampling for the carrier + nonlinear post-chain
+        // (filter, fold, drive). Adds the decimator latency.
+        g->addChild(std::make_unique<juce::AudioParameterChoice>("OVERSAMPLE", "Oversampling",
+            juce::StringArray{ "1x", "2x", "4x" }, 0));
+        // Antiderivative anti-aliasing on the fold stages and the drive:
+        // most of the aliasing gone at 1x for a fraction of the cost of
+        // oversampling, at the price of a slight top-end roll-off.
+        g->addChild(std::make_unique<SnappedParameterBool>("ANTIALIAS", "Anti-alias", false));
+        // Replay repeated deterministic notes (drums) from a render cache
+        // instead of re-synthesizing them. Notes start from a settled state
+        // (no parameter glide from the previous note) when enabled.
+        g->addChild(std::make_unique<SnappedParameterBool>("NOTE_CACHE", "Note Cache", false));
+        // High host rates (88.2k+): run synth + FX at 44.1/48k and upsample
+        // the output. Switching re-prepares the engine, so not automatable.
+        g->addChild(std::make_unique<juce::AudioParameterChoice>("INTERNAL_RATE", "Internal Rate",
+            juce::StringArray{ "Host", "44.1/48k" }, 0,
+            juce::AudioParameterChoiceAttributes().withAutomatable(false)));
+        // Spread the voices over a real-time worker pool once this many are
+        // playing. Offline bounces spread them whenever the pool is on.
+        g->addChild(std::make_unique<SnappedParameterBool>("MULTICORE", "Multi-core", false));
+        g->addChild(std::make_unique<juce::AudioParameterInt>("MULTICORE_VOICES", "Multi-core Voices",
+            2, bb::FMSynth::kMaxVoices, 4,
+            juce::AudioParameterIntAttributes().withAutomatable(false)));
         groups.push_back(std::move(g));
     }
 
@@ -655,26 +833,66 @@ ParasiteProcessor::createParameterLayout()
 }
 
 // --- Préparation audio ---
+// Taux interne : l'hôte / 2 ou / 4 quand l'option est active et que le
+// résultat reste ≥ 44.1 kHz (88.2/96k → /2, 176.4/192k → /4)
+int ParasiteProcessor::engineFactorFor(double hostRate, bool internalRate) noexcept
+{
+    if (!internalRate)
+        return 1;
+    if (hostRate >= 176400.0 * 0.999)
+        return 4;
+    if (hostRate >= 88200.0 * 0.999)
+        return 2;
+    return 1;
+}
+
 void ParasiteProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
-    synth.setCurrentPlaybackSampleRate(sampleRate);
+    // Synth + FX tournent au taux interne ; seuls le stage shaping et la
+    // sortie restent au taux hôte
+    engineFactor = engineFactorFor(sampleRate, internalRateParam->load() > 0.5f);
+    const double engineRate = sampleRate / engineFactor;
+    const int engineBlock = engineFactor > 1 ? samplesPerBlock / engineFactor + 1 : samplesPerBlock;
+    engineCapacity = engineBlock;
+    engineBuffer.setSize(2, engineBlock);
+    engineMidi.ensureSize(2048);
+    subBlockMidi.ensureSize(2048);
+    subBlockPhase = 0;
+    upsampleScratch.setSize(2, engineBlock * engineFactor);
+    upsamplerL.reset();
+    upsamplerR.reset();
+    numPendingOut = 0;
+
+    synth.setCurrentPlaybackSampleRate(engineRate);
+    noteCache.prepare(engineRate);
+
+    // Workers only while MULTICORE is on (job buffers sized to engineBlock)
+    updateVoicePool();
 
     for (int i = 0; i < synth.getNumVoices(); ++i)
     {
         if (auto* fmVoice = dynamic_cast<bb::FMVoice*>(synth.getVoice(i)))
-            fmVoice->prepareToPlay(sampleRate, samplesPerBlock);
+            fmVoice->prepareToPlay(engineRate, engineBlock);
     }
+    // Export hors ligne : même bruit d'un rendu à l'autre (en temps réel,
+    // chaque voix garde son flux libre)
+    if (isNonRealtime())
+        synth.setNoiseSeed(0x5EED0001u);
 
     // Prepare global LFOs
     for (int i = 0; i < 3; ++i)
-        globalLFO[i].prepare(sampleRate);
+        globalLFO[i].prepare(engineRate);
 
     // Prepare post-synth FX
-    stereoDelay.prepare(sampleRate, samplesPerBlock);
-    plateReverb.prepare(sampleRate, samplesPerBlock);
-    liquidChorus.prepare(sampleRate, samplesPerBlock);
-    rubberComb.prepare(sampleRate, samplesPerBlock);
-    volumeShaper.prepare(sampleRate);
+    stereoDelay.prepare(engineRate, engineBlock);
+    plateReverb.prepare(engineRate, engineBlock);
+    liquidChorus.prepare(engineRate, engineBlock);
+    rubberComb.prepare(engineRate, engineBlock);
+    volumeShaper.prepare(engineRate);
+
+    // prepare() a réécrit des dérivés (coefficients au nouveau taux) :
+    // tout sous-système refait les siens au premier bloc
+    appliedGen = {};
 
     // Stage shaping timing (sample-accurate — independent of host transport)
     stageCycleSamples = static_cast<int64_t>(bb::license::kStageCycleSeconds * sampleRate);
@@ -692,6 +910,35 @@ void ParasiteProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
     voiceParams.stageB.store(1.0f, std::memory_order_relaxed);
     plateReverb.setAuxScale(1.0f);
     stereoDelay.setAuxScale(1.0f);
+
+    reportedOversampling = -1;
+    updateLatency();
+}
+
+void ParasiteProcessor::updateVoicePool()
+{
+    const bool wanted = multicoreParam->load() > 0.5f && engineCapacity > 0;
+    const int numWorkers = wanted ? juce::jlimit(0, bb::VoiceWorkerPool::kMaxWorkers,
+                                                 juce::SystemStats::getNumCpus() - 1)
+                                  : 0;
+
+    // Detached from the synth (under its lock) while threads come and go
+    synth.setWorkerPool(nullptr, 0);
+    voicePool.start(numWorkers);
+    if (numWorkers > 0)
+        synth.setWorkerPool(&voicePool, engineCapacity);
+}
+
+// Latence totale au taux hôte : décimateur des voix (au taux interne) puis
+// interpolateur de sortie
+void ParasiteProcessor::updateLatency()
+{
+    const int index = juce::jlimit(0, 2, static_cast<int>(voiceParams.oversampling->load()));
+    if (index == reportedOversampling)
+        return;
+    reportedOversampling = index;
+    setLatencySamples(bb::OversamplingDecimator::latency(1 << index) * engineFactor
+                      + bb::OversamplingInterpolator::latency(engineFactor));
 }
 
 // Sample-accurate envelope for periodic attenuation. Returns 1.0f when
@@ -748,8 +995,155 @@ void ParasiteProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     // attenuation cannot be bypassed from a single multiply patch.
     const float stageG = computeStageEnvelope(buffer.getNumSamples());
     const float s30    = std::pow(stageG, 0.30f);
-    voiceParams.stageA.store(s30, std::memory_order_relaxed);
+    if (voiceParams.stageA.exchange(s30, std::memory_order_relaxed) != s30)
+        voiceParams.bumpGeneration();
+
+    // Bounce / offline export: per-sample modulation (HQ)
+    const bool hq = isNonRealtime();
+    if (voiceParams.hqRender.exchange(hq, std::memory_order_relaxed) != hq)
+        voiceParams.bumpGeneration();
+
+    synth.setPolyphony(static_cast<int>(polyphonyParam->load()));
+    synth.setStealPolicy(static_cast<bb::FMSynth::StealPolicy>(static_cast<int>(voiceStealParam->load())));
+    synth.setMonoMode(voiceParams.mono->load() > 0.5f,
+                      static_cast<bb::FMSynth::NotePriority>(static_cast<int>(notePriorityParam->load())),
+                      /*legato*/ voiceParams.retrig->load() < 0.5f);
+
+    // Multi-core voices: from MULTICORE_VOICES live, always when bouncing
+    synth.setParallelVoiceThreshold(multicoreParam->load() < 0.5f ? 0
+                                    : isNonRealtime() ? 2
+                                    : static_cast<int>(multicoreVoicesParam->load()));
+
+    // Voice oversampling: report the decimator delay to the host (PDC)
+    updateLatency();
+
+    if (engineFactor > 1)
+        renderEngineResampled(buffer, midiMessages, stageG);
+    else
+        renderEngine(buffer, midiMessages, stageG);
 
+    // End of the host block: idle voice workers may go back to sleep
+    voicePool.endBlock();
+
+    const int numSamples = buffer.getNumSamples();
+
+    // --- Output stage trim (site 5: final compounding factor) ---
+    // When licensed, s10 = 1.0^0.1 = 1.0 → no-op. When unlicensed and inside
+    // the quiet window, all five site factors collapse the signal to silence.
+    {
+        const float s10 = std::pow(stageG, 0.10f);
+        stageMaster.store(s10, std::memory_order_relaxed);
+        if (s10 < 0.9999f)
+        {
+            if (s10 < 1.0e-4f)
+                buffer.clear();
+            else
+                buffer.applyGain(s10);
+        }
+    }
+
+    // Push L+R channels to visual buffers for GUI oscilloscope/FFT
+    if (buffer.getNumChannels() > 0)
+        visualBuffer.pushBlock(buffer.getReadPointer(0), numSamples);
+    if (buffer.getNumChannels() > 1)
+        visualBufferR.pushBlock(buffer.getReadPointer(1), numSamples);
+}
+
+// Internal-rate path: the engine renders ceil(remaining / factor) samples
+// into engineBuffer, the half-band interpolators bring them to the host
+// rate. A block size that isn't a multiple of the factor leaves up to
+// factor - 1 host samples over; they open the next block. MIDI positions
+// are mapped onto the internal sample that produces them.
+void ParasiteProcessor::renderEngineResampled(juce::AudioBuffer<float>& buffer,
+                                              juce::MidiBuffer& midiMessages, float stageG)
+{
+    const int numOut = buffer.getNumSamples();
+    const int numCh  = juce::jmin(2, buffer.getNumChannels());
+    const int factor = engineFactor;
+
+    // Leftover host samples from the previous block's last internal sample
+    int written = juce::jmin(numPendingOut, numOut);
+    for (int ch = 0; ch < numCh; ++ch)
+        std::copy(pendingOut[ch], pendingOut[ch] + written, buffer.getWritePointer(ch));
+    for (int ch = 0; ch < 2; ++ch)
+        std::copy(pendingOut[ch] + written, pendingOut[ch] + numPendingOut, pendingOut[ch]);
+    numPendingOut -= written;
+
+    bool firstChunk = true;
+    while (written < numOut)
+    {
+        const int numIn = juce::jmin(engineCapacity, (numOut - written + factor - 1) / factor);
+        const int chunkEnd = written + numIn * factor;
+
+        engineMidi.clear();
+        for (const auto metadata : midiMessages)
+        {
+            const int pos = metadata.samplePosition;
+            if ((pos < written && !firstChunk) || pos >= chunkEnd)
+                continue;
+            engineMidi.addEvent(metadata.getMessage(),
+                                juce::jlimit(0, numIn - 1, (pos - written) / factor));
+        }
+
+        engineBuffer.setSize(2, numIn, false, false, true);
+        engineBuffer.clear();
+        renderEngine(engineBuffer, engineMidi, stageG);
+
+        upsamplerL.process(engineBuffer.getReadPointer(0), upsampleScratch.getWritePointer(0), numIn, factor);
+        upsamplerR.process(engineBuffer.getReadPointer(1), upsampleScratch.getWritePointer(1), numIn, factor);
+
+        const int toCopy = juce::jmin(numIn * factor, numOut - written);
+        for (int ch = 0; ch < numCh; ++ch)
+            std::copy(upsampleScratch.getReadPointer(ch), upsampleScratch.getReadPointer(ch) + toCopy,
+                      buffer.getWritePointer(ch) + written);
+        for (int ch = 0; ch < 2; ++ch)
+            std::copy(upsampleScratch.getReadPointer(ch) + toCopy,
+                      upsampleScratch.getReadPointer(ch) + numIn * factor, pendingOut[ch]);
+        numPendingOut = numIn * factor - toCopy;
+
+        written += toCopy;
+        firstChunk = false;
+    }
+}
+
+// Synth + FX on `buffer` at the engine rate (host rate unless INTERNAL_RATE
+// resamples). `buffer` arrives cleared. Whatever the host block size, the
+// work is sliced on a fixed grid of kEngineSubBlock samples: global LFOs,
+// FX parameters and MIDI-driven state advance at the same resolution and at
+// the same absolute positions at 32-sample live blocks and 2048-sample
+// bounces alike. A host block that ends mid-cell leaves a partial sub-block;
+// the next one completes the cell.
+void ParasiteProcessor::renderEngine(juce::AudioBuffer<float>& buffer,
+                                     juce::MidiBuffer& midiMessages, float stageG)
+{
+    const int numSamples = buffer.getNumSamples();
+    auto midiIt = midiMessages.cbegin();
+
+    for (int start = 0; start < numSamples;)
+    {
+        const int len = juce::jmin(kEngineSubBlock - subBlockPhase, numSamples - start);
+
+        // Events of this sub-block, re-based to its first sample
+        subBlockMidi.clear();
+        for (; midiIt != midiMessages.cend() && (*midiIt).samplePosition < start + len; ++midiIt)
+        {
+            const auto metadata = *midiIt;
+            subBlockMidi.addEvent(metadata.data, metadata.numBytes,
+                                  juce::jmax(0, metadata.samplePosition - start));
+        }
+
+        // Non-owning view on the sub-block (channel pointers kept inline)
+        juce::AudioBuffer<float> sub(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, len);
+        renderSubBlock(sub, subBlockMidi, stageG);
+
+        start += len;
+        subBlockPhase = (subBlockPhase + len) % kEngineSubBlock;
+    }
+}
+
+void ParasiteProcessor::renderSubBlock(juce::AudioBuffer<float>& buffer,
+                                       juce::MidiBuffer& midiMessages, float stageG)
+{
     // Serviced at the top of the block so a preset change that landed
     // between blocks starts from a clean slate: every voice is silenced
     // (with tail-off so the anti-click fade in FMVoice handles the pop),
@@ -776,8 +1170,8 @@ void ParasiteProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     // MIDI CC handling:
     //   CC1  (mod wheel)  → carrier fine-tune offset (+100 cents at full)
     //   CC11 (expression) → voice output multiplier
-    // CC64 (sustain pedal) and CC123 (all-notes-off) are handled by JUCE's
-    // Synthesiser default controller routing — no custom code needed.
+    // CC64 (sustain pedal) is handled by bb::FMSynth and CC123 (all-notes-off)
+    // by JUCE's Synthesiser MIDI dispatch — no custom code needed.
     for (const auto metadata : midiMessages)
     {
         const auto& msg = metadata.getMessage();
@@ -785,26 +1179,10 @@ void ParasiteProcessor::processBlock(juce::AudioBuffer<float>& buffer,
         {
             const int cc  = msg.getControllerNumber();
             const float v = msg.getControllerValue() / 127.0f;
-            if (cc == 1)
-                voiceParams.modWheel.store(v, std::memory_order_relaxed);
-            else if (cc == 11)
-                voiceParams.expression.store(v, std::memory_order_relaxed);
-        }
-    }
-
-    // Mono mode enforcement: when enabled, any new note-on releases the
-    // currently-playing voices so polyphony is reduced to one. allowTailOff
-    // keeps the transition click-free — the briefly-overlapping release
-    // segment bridges the two notes musically (legato-style).
-    if (voiceParams.mono && voiceParams.mono->load() > 0.5f)
-    {
-        for (const auto metadata : midiMessages)
-        {
-            if (metadata.getMessage().isNoteOn())
-            {
-                synth.allNotesOff(0, /*allowTailOff*/ true);
-                break;
-            }
+            if (cc == 1 && voiceParams.modWheel.exchange(v, std::memory_order_relaxed) != v)
+                voiceParams.bumpGeneration();
+            else if (cc == 11 && voiceParams.expression.exchange(v, std::memory_order_relaxed) != v)
+                voiceParams.bumpGeneration();
         }
     }
 
@@ -830,7 +1208,8 @@ void ParasiteProcessor::processBlock(juce::AudioBuffer<float>& buffer,
         for (int l = 0; l < 3; ++l)
             if (lfoCache[l].vel->load() > 0.5f)
                 anyVel = true;
-        voiceParams.velSwap.store(anyVel, std::memory_order_relaxed);
+        if (voiceParams.velSwap.exchange(anyVel, std::memory_order_relaxed) != anyVel)
+            voiceParams.bumpGeneration();
 
         float lastVel = voiceParams.lastVelocity.load(std::memory_order_relaxed);
 
@@ -890,6 +1269,14 @@ void ParasiteProcessor::processBlock(juce::AudioBuffer<float>& buffer,
             }
         }
 
+        // Sommes inchangées (LFO non routés, ou à l'arrêt) : la génération
+        // ne bouge pas, les dérivés du bloc précédent restent valides
+        if (!std::equal(std::begin(modSums), std::end(modSums), std::begin(lastModSums)))
+        {
+            std::copy(std::begin(modSums), std::end(modSums), std::begin(lastModSums));
+            voiceParams.bumpGeneration();
+        }
+
         // Store into voiceParams for FMVoice to read
         voiceParams.lfoModPitch.store(modSums[static_cast<int>(bb::LFODest::Pitch)],
                                        std::memory_order_relaxed);
@@ -1021,7 +1408,17 @@ void ParasiteProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                                            std::memory_order_relaxed);
     }
 
-    voiceParams.stageB.store(std::pow(stageG, 0.25f), std::memory_order_relaxed);
+    const float stageB = std::pow(stageG, 0.25f);
+    if (voiceParams.stageB.exchange(stageB, std::memory_order_relaxed) != stageB)
+        voiceParams.bumpGeneration();
+
+    // Toutes les entrées du bloc sont publiées : génération du bloc
+    const uint64_t gen = voiceParams.generation.load(std::memory_order_acquire);
+
+    // Paramètres de voix figés : lus et dérivés une seule fois, et seulement
+    // si un réglage a changé depuis la dernière capture
+    if (consumeGeneration(appliedGen.voices, gen))
+        voiceBlockParams.capture(voiceParams);
     synth.renderNextBlock(buffer, midiMessages, 0, buffer.getNumSamples());
 
     int numSamples = buffer.getNumSamples();
@@ -1029,37 +1426,43 @@ void ParasiteProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     // --- Post-synth FX: Liquid Chorus (texture) ---
     if (liqOnParam->load() > 0.5f && buffer.getNumChannels() >= 2)
     {
-        float liqDepth = juce::jlimit(0.0f, 1.0f, liqDepthParam->load()
-                         + voiceParams.lfoModLiqDepth.load(std::memory_order_relaxed));
-        float liqMix   = juce::jlimit(0.0f, 1.0f, liqMixParam->load()
-                         + voiceParams.lfoModLiqMix.load(std::memory_order_relaxed));
-        float liqRate = juce::jlimit(0.05f, 3.0f, liqRateParam->load()
-                       + voiceParams.lfoModLiqRate.load(std::memory_order_relaxed));
-        float liqTone = juce::jlimit(0.0f, 1.0f, liqToneParam->load()
-                        + voiceParams.lfoModLiqTone.load(std::memory_order_relaxed));
-        float liqFeed = juce::jlimit(0.0f, 1.0f, liqFeedParam->load()
-                        + voiceParams.lfoModLiqFeed.load(std::memory_order_relaxed));
-        liquidChorus.setParameters(liqRate, liqDepth,
-                                   liqTone, liqFeed,
-                                   liqMix);
+        if (consumeGeneration(appliedGen.chorus, gen))
+        {
+            float liqDepth = juce::jlimit(0.0f, 1.0f, liqDepthParam->load()
+                             + voiceParams.lfoModLiqDepth.load(std::memory_order_relaxed));
+            float liqMix   = juce::jlimit(0.0f, 1.0f, liqMixParam->load()
+                             + voiceParams.lfoModLiqMix.load(std::memory_order_relaxed));
+            float liqRate = juce::jlimit(0.05f, 3.0f, liqRateParam->load()
+                           + voiceParams.lfoModLiqRate.load(std::memory_order_relaxed));
+            float liqTone = juce::jlimit(0.0f, 1.0f, liqToneParam->load()
+                            + voiceParams.lfoModLiqTone.load(std::memory_order_relaxed));
+            float liqFeed = juce::jlimit(0.0f, 1.0f, liqFeedParam->load()
+                            + voiceParams.lfoModLiqFeed.load(std::memory_order_relaxed));
+            liquidChorus.setParameters(liqRate, liqDepth,
+                                       liqTone, liqFeed,
+                                       liqMix);
+        }
         liquidChorus.process(buffer.getWritePointer(0), buffer.getWritePointer(1), numSamples);
     }
 
     // --- Post-synth FX: Rubber Comb (texture) ---
     if (rubOnParam->load() > 0.5f && buffer.getNumChannels() >= 2)
     {
-        float rubWarp = juce::jlimit(0.0f, 1.0f, rubWarpParam->load()
-                        + voiceParams.lfoModRubWarp.load(std::memory_order_relaxed));
-        float rubMix  = juce::jlimit(0.0f, 1.0f, rubMixParam->load()
-                        + voiceParams.lfoModRubMix.load(std::memory_order_relaxed));
-        float rubTone = juce::jlimit(0.0f, 1.0f, rubToneParam->load()
-                       + voiceParams.lfoModRubTone.load(std::memory_order_relaxed));
-        float rubStretch = juce::jlimit(0.0f, 1.0f, rubStretchParam->load()
-                           + voiceParams.lfoModRubStretch.load(std::memory_order_relaxed));
-        float rubFeed = juce::jlimit(0.0f, 1.0f, rubFeedParam->load()
-                        + voiceParams.lfoModRubFeed.load(std::memory_order_relaxed));
-        rubberComb.setParameters(rubTone, rubStretch,
-                                 rubWarp, rubMix, rubFeed);
+        if (consumeGeneration(appliedGen.comb, gen))
+        {
+            float rubWarp = juce::jlimit(0.0f, 1.0f, rubWarpParam->load()
+                            + voiceParams.lfoModRubWarp.load(std::memory_order_relaxed));
+            float rubMix  = juce::jlimit(0.0f, 1.0f, rubMixParam->load()
+                            + voiceParams.lfoModRubMix.load(std::memory_order_relaxed));
+            float rubTone = juce::jlimit(0.0f, 1.0f, rubToneParam->load()
+                           + voiceParams.lfoModRubTone.load(std::memory_order_relaxed));
+            float rubStretch = juce::jlimit(0.0f, 1.0f, rubStretchParam->load()
+                               + voiceParams.lfoModRubStretch.load(std::memory_order_relaxed));
+            float rubFeed = juce::jlimit(0.0f, 1.0f, rubFeedParam->load()
+                            + voiceParams.lfoModRubFeed.load(std::memory_order_relaxed));
+            rubberComb.setParameters(rubTone, rubStretch,
+                                     rubWarp, rubMix, rubFeed);
+        }
         rubberComb.process(buffer.getWritePointer(0), buffer.getWritePointer(1), numSamples);
     }
 
@@ -1079,43 +1482,48 @@ void ParasiteProcessor::processBlock(juce::AudioBuffer<float>& buffer,
         // DlyTime shifts the beat index (rounded) so modulation still has a
         // musical effect — it steps rhythmically through adjacent divisions.
         int dlySyncIdx = static_cast<int>(dlySyncParam->load());
-        float dlyTime;
-        if (dlySyncIdx > 0)
+        // Synchronisé, le tempo de l'hôte entre dans le réglage sans passer
+        // par la génération : refait à chaque bloc
+        if (dlySyncIdx > 0 || consumeGeneration(appliedGen.delay, gen))
         {
-            static constexpr float beatsQN[] = {
-                4.0f, 2.0f, 1.0f, 0.5f, 0.25f, 0.125f,   // 1/1 .. 1/32
-                2.0f / 3.0f, 1.0f / 3.0f, 1.0f / 6.0f    // 1/4T, 1/8T, 1/16T
-            };
-            const float lfoMod = voiceParams.lfoModDlyTime.load(std::memory_order_relaxed);
-            const int idxOffset = static_cast<int>(std::lround(lfoMod * 4.0f));
-            const int effectiveIdx = juce::jlimit(1, 9, dlySyncIdx + idxOffset);
-            float bpm = 120.0f;
-            if (auto* ph = getPlayHead())
+            float dlyTime;
+            if (dlySyncIdx > 0)
             {
-                auto pos = ph->getPosition();
-                if (pos.hasValue() && pos->getBpm().hasValue())
-                    bpm = static_cast<float>(*pos->getBpm());
+                static constexpr float beatsQN[] = {
+                    4.0f, 2.0f, 1.0f, 0.5f, 0.25f, 0.125f,   // 1/1 .. 1/32
+                    2.0f / 3.0f, 1.0f / 3.0f, 1.0f / 6.0f    // 1/4T, 1/8T, 1/16T
+                };
+                const float lfoMod = voiceParams.lfoModDlyTime.load(std::memory_order_relaxed);
+                const int idxOffset = static_cast<int>(std::lround(lfoMod * 4.0f));
+                const int effectiveIdx = juce::jlimit(1, 9, dlySyncIdx + idxOffset);
+                float bpm = 120.0f;
+                if (auto* ph = getPlayHead())
+                {
+                    auto pos = ph->getPosition();
+                    if (pos.hasValue() && pos->getBpm().hasValue())
+                        bpm = static_cast<float>(*pos->getBpm());
+                }
+                const float beats = beatsQN[effectiveIdx - 1];
+                dlyTime = juce::jlimit(0.01f, 2.0f, (60.0f / bpm) * beats);
             }
-            const float beats = beatsQN[effectiveIdx - 1];
-            dlyTime = juce::jlimit(0.01f, 2.0f, (60.0f / bpm) * beats);
-        }
-        else
-        {
-            dlyTime = juce::jlimit(0.01f, 2.0f, dlyTimeParam->load()
-                        + voiceParams.lfoModDlyTime.load(std::memory_order_relaxed) * 0.5f);
+            else
+            {
+                dlyTime = juce::jlimit(0.01f, 2.0f, dlyTimeParam->load()
+                            + voiceParams.lfoModDlyTime.load(std::memory_order_relaxed) * 0.5f);
+            }
+            float dlyFeed = juce::jlimit(0.0f, 0.99f, dlyFeedParam->load()
+                            + voiceParams.lfoModDlyFeed.load(std::memory_order_relaxed));
+            float dlyMix  = juce::jlimit(0.0f, 1.0f, dlyMixParam->load()
+                            + voiceParams.lfoModDlyMix.load(std::memory_order_relaxed));
+            float dlyDamp   = juce::jlimit(0.0f, 1.0f, dlyDampParam->load()
+                              + voiceParams.lfoModDlyDamp.load(std::memory_order_relaxed));
+            float dlySpread = juce::jlimit(0.0f, 1.0f, dlySpreadParam->load()
+                              + voiceParams.lfoModDlySpread.load(std::memory_order_relaxed));
+            stereoDelay.setParameters(dlyTime, dlyFeed,
+                                      dlyDamp, dlyMix,
+                                      dlyPingParam->load() > 0.5f,
+                                      dlySpread);
         }
-        float dlyFeed = juce::jlimit(0.0f, 0.99f, dlyFeedParam->load()
-                        + voiceParams.lfoModDlyFeed.load(std::memory_order_relaxed));
-        float dlyMix  = juce::jlimit(0.0f, 1.0f, dlyMixParam->load()
-                        + voiceParams.lfoModDlyMix.load(std::memory_order_relaxed));
-        float dlyDamp   = juce::jlimit(0.0f, 1.0f, dlyDampParam->load()
-                          + voiceParams.lfoModDlyDamp.load(std::memory_order_relaxed));
-        float dlySpread = juce::jlimit(0.0f, 1.0f, dlySpreadParam->load()
-                          + voiceParams.lfoModDlySpread.load(std::memory_order_relaxed));
-        stereoDelay.setParameters(dlyTime, dlyFeed,
-                                  dlyDamp, dlyMix,
-                                  dlyPingParam->load() > 0.5f,
-                                  dlySpread);
         stereoDelay.process(buffer.getWritePointer(0), buffer.getWritePointer(1), numSamples);
     }
 
@@ -1128,18 +1536,21 @@ void ParasiteProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     plateReverb.setAuxScale(std::pow(stageG, 0.15f));
     if (revWasOn && buffer.getNumChannels() >= 2)
     {
-        float revSize = juce::jlimit(0.0f, 1.0f, revSizeParam->load()
-                        + voiceParams.lfoModRevSize.load(std::memory_order_relaxed));
-        float revMix  = juce::jlimit(0.0f, 1.0f, revMixParam->load()
-                        + voiceParams.lfoModRevMix.load(std::memory_order_relaxed));
-        float revDamp  = juce::jlimit(0.0f, 1.0f, revDampParam->load()
-                         + voiceParams.lfoModRevDamp.load(std::memory_order_relaxed));
-        float revWidth = juce::jlimit(0.0f, 1.0f, revWidthParam->load()
-                         + voiceParams.lfoModRevWidth.load(std::memory_order_relaxed));
-        float revPdly  = juce::jlimit(0.0f, 200.0f, revPdlyParam->load()
-                         + voiceParams.lfoModRevPdly.load(std::memory_order_relaxed) * 200.0f);
-        plateReverb.setParameters(revSize, revDamp, revMix,
-                                  revWidth, revPdly);
+        if (consumeGeneration(appliedGen.reverb, gen))
+        {
+            float revSize = juce::jlimit(0.0f, 1.0f, revSizeParam->load()
+                            + voiceParams.lfoModRevSize.load(std::memory_order_relaxed));
+            float revMix  = juce::jlimit(0.0f, 1.0f, revMixParam->load()
+                            + voiceParams.lfoModRevMix.load(std::memory_order_relaxed));
+            float revDamp  = juce::jlimit(0.0f, 1.0f, revDampParam->load()
+                             + voiceParams.lfoModRevDamp.load(std::memory_order_relaxed));
+            float revWidth = juce::jlimit(0.0f, 1.0f, revWidthParam->load()
+                             + voiceParams.lfoModRevWidth.load(std::memory_order_relaxed));
+            float revPdly  = juce::jlimit(0.0f, 200.0f, revPdlyParam->load()
+                             + voiceParams.lfoModRevPdly.load(std::memory_order_relaxed) * 200.0f);
+            plateReverb.setParameters(revSize, revDamp, revMix,
+                                      revWidth, revPdly);
+        }
         plateReverb.process(buffer.getWritePointer(0), buffer.getWritePointer(1), numSamples);
     }
 
@@ -1178,27 +1589,6 @@ void ParasiteProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                 buffer.getWritePointer(ch)[i] *= gain;
         }
     }
-
-    // --- Output stage trim (site 5: final compounding factor) ---
-    // When licensed, s10 = 1.0^0.1 = 1.0 → no-op. When unlicensed and inside
-    // the quiet window, all five site factors collapse the signal to silence.
-    {
-        const float s10 = std::pow(stageG, 0.10f);
-        stageMaster.store(s10, std::memory_order_relaxed);
-        if (s10 < 0.9999f)
-        {
-            if (s10 < 1.0e-4f)
-                buffer.clear();
-            else
-                buffer.applyGain(s10);
-        }
-    }
-
-    // Push L+R channels to visual buffers for GUI oscilloscope/FFT
-    if (buffer.getNumChannels() > 0)
-        visualBuffer.pushBlock(buffer.getReadPointer(0), numSamples);
-    if (buffer.getNumChannels() > 1)
-        visualBufferR.pushBlock(buffer.getReadPointer(1), numSamples);
 }
 
 // --- Programmes (presets) ---
@@ -7,6 +7,8 @@
 #include <juce_audio_utils/juce_audio_utils.h>
 #include <juce_dsp/juce_dsp.h>
 #include "dsp/FMVoice.h"
+#include "dsp/FMSynth.h"
+#include "dsp/NoteCache.h"
 #include "dsp/LFO.h"
 #include "dsp/StereoDelay.h"
 #include "dsp/PlateReverb.h"
@@ -125,6 +127,68 @@ private:
     // Pointeurs atomiques cachés vers les paramètres (pour accès rapide dans processBlock)
     bb::VoiceParams voiceParams;
     void cacheParameterPointers();
+    // Instantané de voiceParams, recapturé quand la génération a bougé et
+    // partagé par les voix
+    bb::VoiceBlockParams voiceBlockParams;
+
+    // Génération des réglages (voiceParams.generation) : tout paramètre
+    // APVTS l'avance via ce listener. Chaque sous-système retient la
+    // dernière génération appliquée et ne refait ses dérivés qu'à un écart.
+    struct GenerationListener;
+    std::unique_ptr<GenerationListener> generationListener;
+    static constexpr uint64_t kStaleGeneration = ~uint64_t{0};
+    struct AppliedGenerations
+    {
+        uint64_t voices = kStaleGeneration;
+        uint64_t chorus = kStaleGeneration;
+        uint64_t comb   = kStaleGeneration;
+        uint64_t delay  = kStaleGeneration;
+        uint64_t reverb = kStaleGeneration;
+    } appliedGen;
+    // Vrai (et retient g) si le sous-système n'a pas encore vu la génération g
+    static bool consumeGeneration(uint64_t& seen, uint64_t g) noexcept
+    {
+        if (seen == g)
+            return false;
+        seen = g;
+        return true;
+    }
+    // Dernières sommes LFO publiées : on n'avance la génération qu'à un écart
+    float lastModSums[static_cast<int>(bb::LFODest::Count)] {};
+
+    // Suréchantillonnage des voix : latence du décimateur (+ interpolateur
+    // du taux interne) reportée à l'hôte quand le facteur change
+    // (-1 = à reporter)
+    int reportedOversampling = -1;
+    void updateLatency();
+
+    // --- Taux interne (INTERNAL_RATE) ---
+    // Aux taux hôte ≥ 88.2 kHz, synth + FX tournent à l'hôte / 2 ou / 4 et
+    // la sortie est interpolée par demi-bandes (HalfBand.h)
+    static int engineFactorFor(double hostRate, bool internalRate) noexcept;
+    void renderEngine(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages, float stageG);
+    void renderSubBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages, float stageG);
+    void renderEngineResampled(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages, float stageG);
+
+    std::atomic<float>* internalRateParam = nullptr;
+    int engineFactor = 1;                      // taux hôte / taux interne
+    int engineCapacity = 0;                    // échantillons internes max par rendu
+    juce::AudioBuffer<float> engineBuffer;     // sortie du moteur (taux interne)
+    juce::AudioBuffer<float> upsampleScratch;  // sortie interpolée (taux hôte)
+    juce::MidiBuffer engineMidi;
+
+    // Découpage fixe du moteur, indépendant de la taille de bloc hôte
+    // (aligné sur le sous-bloc de contrôle des voix)
+    static constexpr int kEngineSubBlock = bb::FMVoice::kControlBlock;
+    juce::MidiBuffer subBlockMidi;
+    int subBlockPhase = 0;                     // position dans la cellule courante
+    bb::OversamplingInterpolator upsamplerL, upsamplerR;
+    // Échantillons hôte en trop du dernier rendu, émis au bloc suivant
+    float pendingOut[2][bb::OversamplingInterpolator::kMaxFactor] {};
+    int numPendingOut = 0;
+
+    struct EngineRateListener;
+    std::unique_ptr<EngineRateListener> engineRateListener;
 
     // Curve↔Param sync (harmonic tables, shaper steps, LFO tables)
     void setupCurveParamListeners();
@@ -135,7 +199,18 @@ private:
     struct CurveListener;
     std::unique_ptr<CurveListener> curveListener;
 
-    juce::Synthesiser synth;
+    bb::FMSynth synth;
+    bb::NoteCache noteCache;   // partagé par les voix (NOTE_CACHE)
+    std::atomic<float>* polyphonyParam = nullptr;
+    std::atomic<float>* voiceStealParam = nullptr;
+    std::atomic<float>* notePriorityParam = nullptr;
+    bb::VoiceWorkerPool voicePool;   // rendu des voix multi-cœur (MULTICORE)
+    std::atomic<float>* multicoreParam = nullptr;
+    std::atomic<float>* multicoreVoicesParam = nullptr;
+    // Thread message : workers démarrés si MULTICORE, arrêtés sinon
+    void updateVoicePool();
+    struct MulticoreListener;
+    std::unique_ptr<MulticoreListener> multicoreListener;
     int currentPreset = -1;  // -1 = uninitialised; set by loadPresetAt or setStateInformation
     bool isUserPresetLoaded = false;
     juce::String currentUserPresetName;
@@ -0,0 +1,83 @@
+// Adaa.h — Anti-aliasing par primitive (ADAA du premier ordre)
+// Pour une non-linéarité f de primitive F, on sort la moyenne de f sur le
+// segment entre deux échantillons :
+//     y[n] = (F(x[n]) − F(x[n−1])) / (x[n] − x[n−1])
+// soit un filtre rectangulaire appliqué au signal continu avant
+// l'échantillonnage. L'essentiel du repliement disparaît à 1× pour le prix
+// d'une évaluation de F. Contrepartie : un demi-échantillon de retard et
+// une légère atténuation près de Nyquist (la partie linéaire voit une
+// moyenne de deux échantillons).
+#pragma once
+#include <cmath>
+#include "FastMath.h"
+
+namespace bb {
+namespace adaa {
+
+// sin(k·x) : la différence des primitives se factorise exactement,
+// cos a − cos b = −2·sin((a+b)/2)·sin((a−b)/2), d'où
+//     y = sin(k·m) · sinc(k·Δ/2)   (m = milieu, Δ = écart)
+// Aucune division par un petit Δ : stable en float, pas de cas limite.
+inline float sinFirstOrder(float x, float x1, float k) noexcept
+{
+    const float m = 0.5f * (x + x1);
+    const float h = 0.5f * k * (x - x1);
+    const float sinc = std::fabs(h) < 1.0e-3f ? 1.0f - h * h * (1.0f / 6.0f)
+                                               : dspmath::sin(h) / h;
+    return dspmath::sin(k * m) * sinc;
+}
+
+// ln cosh(x), primitive de tanh, sans débordement pour les grands |x|
+inline double logCosh(double x) noexcept
+{
+    const double ax = std::fabs(x);
+    return ax + std::log1p(std::exp(-2.0 * ax)) - 0.693147180559945309;
+}
+
+// tanh avec ADAA. La différence de primitives s'annule quand Δ → 0 : on
+// calcule en double et on retombe sur tanh(milieu) sous kMinDelta (l'écart
+// entre les deux est alors en O(Δ²)).
+class Tanh
+{
+public:
+    void reset(float x = 0.0f) noexcept
+    {
+        x1 = x;
+        f1Valid = false;
+    }
+
+    float process(float x) noexcept
+    {
+        if (!f1Valid)
+            f1 = logCosh(x1);
+
+        const double f  = logCosh(x);
+        const double dx = static_cast<double>(x) - static_cast<double>(x1);
+        const float y = std::fabs(dx) > kMinDelta
+            ? static_cast<float>((f - f1) / dx)
+            : dspmath::tanh(0.5f * (x + x1));
+
+        x1 = x;
+        f1 = f;
+        f1Valid = true;
+        return y;
+    }
+
+    // Suit l'entrée sans calculer (étage contourné) : pas de saut quand
+    // l'ADAA reprend la main
+    void track(float x) noexcept
+    {
+        x1 = x;
+        f1Valid = false;
+    }
+
+private:
+    static constexpr double kMinDelta = 1.0e-5;
+
+    float  x1 = 0.0f;
+    double f1 = 0.0;
+    bool   f1Valid = false;
+};
+
+} // namespace adaa
+} // namespace bb
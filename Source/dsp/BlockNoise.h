@@ -0,0 +1,85 @@
+// BlockNoise.h — Bruit blanc à compteur, rempli par blocs
+// Chaque échantillon est un hachage de (clé du flux, index) : aucun
+// échantillon ne dépend du précédent, contrairement à un xorshift où
+// chaque tirage attend le résultat du tirage d'avant. fill() est donc
+// une boucle sans dépendance que le compilateur vectorise, et deux flux
+// de clés différentes sont décorrélés (une clé par voix et par canal).
+//
+// Flux par défaut : unique par instance (compteur global, comme les seeds
+// de drift d'Oscillator). seed() repart d'un flux choisi : mêmes seeds,
+// même bruit, pour des rendus reproductibles.
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+namespace bb {
+
+class BlockNoise
+{
+public:
+    BlockNoise() noexcept : BlockNoise(nextStream()) {}
+    explicit BlockNoise(uint32_t stream) noexcept { seed(stream); }
+
+    // Début du flux `stream`
+    void seed(uint32_t stream) noexcept
+    {
+        key = mix(stream);
+        position = 0;
+    }
+
+    // Flux numéro `index` dérivé d'une seed commune (voix, canal, ...)
+    static uint32_t streamFor(uint32_t seedValue, uint32_t index) noexcept
+    {
+        return mix(seedValue + index * 0x9E3779B9u);
+    }
+
+    // Un échantillon dans [-1, 1)
+    float next() noexcept { return sample(key, position++); }
+
+    // numSamples échantillons consécutifs du flux
+    void fill(float* dst, int numSamples) noexcept
+    {
+        const uint32_t k = key;
+        const uint32_t p = position;
+        for (int i = 0; i < numSamples; ++i)
+            dst[i] = sample(k, p + static_cast<uint32_t>(i));
+        position += static_cast<uint32_t>(numSamples);
+    }
+
+    void skip(int numSamples) noexcept { position += static_cast<uint32_t>(numSamples); }
+
+    // Accès brut pour les noyaux qui rangent les flux en lanes (VoiceBank)
+    uint32_t getKey() const noexcept { return key; }
+    uint32_t getPosition() const noexcept { return position; }
+    void setPosition(uint32_t p) noexcept { position = p; }
+
+    // Échantillon `index` du flux de clé `k`
+    static float sample(uint32_t k, uint32_t index) noexcept
+    {
+        const uint32_t h = mix(index * 0x9E3779B9u + k);
+        return static_cast<float>(static_cast<int32_t>(h)) * (1.0f / 2147483648.0f);
+    }
+
+private:
+    // Finaliseur 32 bits (lowbias32, C. Wellons) : avalanche complète
+    static uint32_t mix(uint32_t x) noexcept
+    {
+        x ^= x >> 16;
+        x *= 0x7FEB352Du;
+        x ^= x >> 15;
+        x *= 0x846CA68Bu;
+        x ^= x >> 16;
+        return x;
+    }
+
+    static uint32_t nextStream() noexcept
+    {
+        static std::atomic<uint32_t> counter { 0x9ABCDEF0 };
+        return counter.fetch_add(0x9E3779B9, std::memory_order_relaxed);
+    }
+
+    uint32_t key = 0;
+    uint32_t position = 0;
+};
+
+} // namespace bb
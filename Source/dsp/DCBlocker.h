@@ -35,6 +35,8 @@ public:
     }
 
 private:
+    friend class VoiceBank; // accès SoA direct à l'état (rendu par lanes)
+
     double R = 0.9999;
     double x1 = 0.0; // échantillon d'entrée précédent
     double y1 = 0.0; // échantillon de sortie précédent
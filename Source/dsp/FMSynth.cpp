@@ -0,0 +1,694 @@
+// FMSynth.cpp — Allocation des voix (pile libre, liste active, vol),
+// application des événements à l'échantillon et rendu groupé
+#include "FMSynth.h"
+#include <algorithm>
+
+namespace bb {
+
+FMSynth::FMSynth()
+{
+    for (auto& channel : noteVoice)
+        channel.fill(-1);
+}
+
+void FMSynth::setLaneRenderingEnabled(bool shouldUseLanes) noexcept
+{
+    for (auto& bank : banks)
+        bank.setEnabled(shouldUseLanes);
+}
+
+uint64_t FMSynth::getNumLaneVoiceBlocks() const noexcept
+{
+    uint64_t total = 0;
+    for (const auto& bank : banks)
+        total += bank.getNumLaneVoiceBlocks();
+    return total;
+}
+
+void FMSynth::setWorkerPool(VoiceWorkerPool* pool, int maxBlockSize)
+{
+    const juce::ScopedLock sl(lock);
+    workerPool = pool;
+    jobCapacity = pool != nullptr ? maxBlockSize : 0;
+    for (auto& buffer : jobBuffers)
+        buffer.setSize(2, juce::jmax(1, jobCapacity));
+}
+
+void FMSynth::setBlockParams(const VoiceBlockParams* snapshot)
+{
+    const juce::ScopedLock sl(lock);
+    blockParams = snapshot;
+    refreshVoices();
+    for (int i = 0; i < numIndexed; ++i)
+        if (auto* voice = fmVoices[static_cast<size_t>(i)])
+            voice->setBlockParams(snapshot);
+}
+
+void FMSynth::setNoiseSeed(uint32_t seed)
+{
+    const juce::ScopedLock sl(lock);
+    refreshVoices();
+    for (int i = 0; i < numIndexed; ++i)
+        if (auto* voice = fmVoices[static_cast<size_t>(i)])
+            voice->seedNoise(BlockNoise::streamFor(seed, static_cast<uint32_t>(i)));
+}
+
+void FMSynth::setPolyphony(int numVoices) noexcept
+{
+    numVoices = juce::jlimit(1, kMaxVoices, numVoices);
+    if (numVoices == polyphony)
+        return;
+
+    const juce::ScopedLock sl(lock);
+    refreshVoices();
+
+    for (int i = numVoices; i < numIndexed; ++i)
+        if (listed[static_cast<size_t>(i)] && fmVoices[static_cast<size_t>(i)]->isVoiceActive())
+            fmVoices[static_cast<size_t>(i)]->stopNote(0.0f, true);
+
+    polyphony = numVoices;
+    rebuildFreeList();
+}
+
+void FMSynth::setMonoMode(bool shouldBeMono, NotePriority priority, bool legato) noexcept
+{
+    notePriority = priority;
+    monoLegato = legato;
+    if (shouldBeMono == mono)
+        return;
+
+    allNotesOff(0, true);
+    mono = shouldBeMono;
+}
+
+//==============================================================================
+// Pile libre et liste active
+
+void FMSynth::refreshVoices() noexcept
+{
+    const int count = juce::jmin(voices.size(), kMaxVoices);
+    if (count == numIndexed)
+        return;
+
+    numIndexed = count;
+    numListed = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        auto* voice = dynamic_cast<FMVoice*>(voices.getUnchecked(i));
+        fmVoices[static_cast<size_t>(i)] = voice;
+        if (voice != nullptr)
+            voice->setBlockParams(blockParams);
+        listed[static_cast<size_t>(i)] = voice != nullptr && voice->isVoiceActive();
+        if (listed[static_cast<size_t>(i)])
+            activeList[static_cast<size_t>(numListed++)] = i;
+    }
+    rebuildFreeList();
+}
+
+// Voix 0 au sommet : à vide, les notes prennent les voix dans l'ordre
+void FMSynth::rebuildFreeList() noexcept
+{
+    numFree = 0;
+    for (int i = juce::jmin(polyphony, numIndexed) - 1; i >= 0; --i)
+        if (fmVoices[static_cast<size_t>(i)] != nullptr && !listed[static_cast<size_t>(i)])
+            freeList[static_cast<size_t>(numFree++)] = i;
+}
+
+int FMSynth::popFreeVoice() noexcept
+{
+    return numFree > 0 ? freeList[static_cast<size_t>(--numFree)] : -1;
+}
+
+void FMSynth::markActive(int index) noexcept
+{
+    if (listed[static_cast<size_t>(index)])
+        return;
+
+    // La voix mono est prise directement, sans passer par la pile
+    if (mono)
+    {
+        const auto freeEnd = freeList.begin() + numFree;
+        numFree -= static_cast<int>(freeEnd - std::remove(freeList.begin(), freeEnd, index));
+    }
+
+    listed[static_cast<size_t>(index)] = true;
+    activeList[static_cast<size_t>(numListed++)] = index;
+}
+
+int FMSynth::findRingingVoice(int midiChannel, int midiNoteNumber) const noexcept
+{
+    const int index = noteVoice[static_cast<size_t>(midiChannel - 1)][static_cast<size_t>(midiNoteNumber)];
+    if (index < 0 || index >= numIndexed)
+        return -1;
+
+    // La table n'est pas effacée à la fin des notes : on vérifie que la
+    // voix joue encore cette note
+    const auto* voice = fmVoices[static_cast<size_t>(index)];
+    if (voice->getCurrentlyPlayingNote() != midiNoteNumber || !voice->isPlayingChannel(midiChannel))
+        return -1;
+    return index;
+}
+
+// Parmi les voix allouables (toutes actives, sinon la pile ne serait pas
+// vide) ; une voix terminée plus tôt dans le bloc est reprise d'abord.
+int FMSynth::chooseVoiceToSteal(int midiNoteNumber) const noexcept
+{
+    std::array<const FMVoice*, kMaxVoices> usable;
+    std::array<int, kMaxVoices> usableIndex;
+    int numUsable = 0;
+
+    for (int k = 0; k < numListed; ++k)
+    {
+        const int i = activeList[static_cast<size_t>(k)];
+        if (i >= polyphony)
+            continue;
+        if (!fmVoices[static_cast<size_t>(i)]->isVoiceActive())
+            return i;
+        usable[static_cast<size_t>(numUsable)] = fmVoices[static_cast<size_t>(i)];
+        usableIndex[static_cast<size_t>(numUsable++)] = i;
+    }
+
+    if (numUsable == 0)
+        return -1;
+
+    if (stealPolicy == StealPolicy::Quietest)
+    {
+        int best = 0;
+        for (int u = 1; u < numUsable; ++u)
+        {
+            const float level = usable[static_cast<size_t>(u)]->getTrackedLevel();
+            const float bestLevel = usable[static_cast<size_t>(best)]->getTrackedLevel();
+            if (level < bestLevel
+                || (level == bestLevel && usable[static_cast<size_t>(u)]->wasStartedBefore(*usable[static_cast<size_t>(best)])))
+                best = u;
+        }
+        return usableIndex[static_cast<size_t>(best)];
+    }
+
+    // Oldest (et SameNote sans voix sur la note) : même heuristique que
+    // juce::Synthesiser, la plus ancienne d'abord, notes extrêmes tenues
+    // protégées. Tri d'indices dans un tableau fixe, sans allocation.
+    std::array<int, kMaxVoices> order;
+    for (int u = 0; u < numUsable; ++u)
+        order[static_cast<size_t>(u)] = u;
+    std::sort(order.begin(), order.begin() + numUsable, [&](int a, int b)
+    {
+        return usable[static_cast<size_t>(a)]->wasStartedBefore(*usable[static_cast<size_t>(b)]);
+    });
+
+    const FMVoice* low = nullptr;   // note la plus grave, hors release
+    const FMVoice* top = nullptr;   // note la plus aiguë, hors release
+    for (int u = 0; u < numUsable; ++u)
+    {
+        const auto* voice = usable[static_cast<size_t>(u)];
+        if (voice->isPlayingButReleased())
+            continue;
+        const int note = voice->getCurrentlyPlayingNote();
+        if (low == nullptr || note < low->getCurrentlyPlayingNote())
+            low = voice;
+        if (top == nullptr || note > top->getCurrentlyPlayingNote())
+            top = voice;
+    }
+
+    // Une seule note tenue : la grave est prioritaire
+    if (top == low)
+        top = nullptr;
+
+    auto oldestWhere = [&](auto&& predicate) -> int
+    {
+        for (int k = 0; k < numUsable; ++k)
+        {
+            const int u = order[static_cast<size_t>(k)];
+            if (predicate(usable[static_cast<size_t>(u)]))
+                return usableIndex[static_cast<size_t>(u)];
+        }
+        return -1;
+    };
+    auto unprotected = [&](const FMVoice* v) { return v != low && v != top; };
+
+    // Même note d'abord, puis relâchée, puis sans touche enfoncée, puis
+    // n'importe quelle voix non protégée
+    int index = oldestWhere([&](const FMVoice* c) { return c->getCurrentlyPlayingNote() == midiNoteNumber; });
+    if (index < 0)
+        index = oldestWhere([&](const FMVoice* c) { return unprotected(c) && c->isPlayingButReleased(); });
+    if (index < 0)
+        index = oldestWhere([&](const FMVoice* c) { return unprotected(c) && !c->isKeyDown(); });
+    if (index < 0)
+        index = oldestWhere(unprotected);
+    if (index < 0)
+        index = oldestWhere([&](const FMVoice* c) { return c == (top != nullptr ? top : low); });
+    return index;
+}
+
+//==============================================================================
+// Événements MIDI : chaque handler rattrape (catchUp) les voix qu'il
+// modifie jusqu'à l'échantillon de l'événement, les autres attendent la
+// fin du bloc.
+
+void FMSynth::noteOn(int midiChannel, int midiNoteNumber, float velocity)
+{
+    if (!juce::isPositiveAndBelow(midiChannel - 1, 16) || !juce::isPositiveAndBelow(midiNoteNumber, 128))
+        return;
+
+    const juce::ScopedLock sl(lock);
+    refreshVoices();
+
+    if (mono)
+    {
+        monoNoteOn(midiChannel, midiNoteNumber, velocity);
+        return;
+    }
+
+    for (auto* sound : sounds)
+    {
+        if (!sound->appliesToNote(midiNoteNumber) || !sound->appliesToChannel(midiChannel))
+            continue;
+
+        // Une note rejouée coupe (en release) la voix qui la joue encore,
+        // ou la relance directement en SameNote
+        int index = findRingingVoice(midiChannel, midiNoteNumber);
+        if (index >= 0 && !(stealPolicy == StealPolicy::SameNote && index < polyphony))
+        {
+            catchUp(index);
+            stopVoice(fmVoices[static_cast<size_t>(index)], 1.0f, true);
+            index = -1;
+        }
+
+        if (index < 0)
+            index = popFreeVoice();
+        if (index < 0 && isNoteStealingEnabled())
+            index = chooseVoiceToSteal(midiNoteNumber);
+        if (index < 0)
+            continue;
+
+        auto* voice = fmVoices[static_cast<size_t>(index)];
+        catchUp(index);
+        markActive(index);
+        startVoice(voice, sound, midiChannel, midiNoteNumber, velocity);
+        voice->setSustainPedalDown(sustainDown[static_cast<size_t>(midiChannel - 1)]);
+        noteVoice[static_cast<size_t>(midiChannel - 1)][static_cast<size_t>(midiNoteNumber)] = static_cast<int16_t>(index);
+    }
+}
+
+void FMSynth::noteOff(int midiChannel, int midiNoteNumber, float velocity, bool allowTailOff)
+{
+    if (!juce::isPositiveAndBelow(midiChannel - 1, 16) || !juce::isPositiveAndBelow(midiNoteNumber, 128))
+        return;
+
+    const juce::ScopedLock sl(lock);
+    if (mono)
+    {
+        monoNoteOff(midiChannel, midiNoteNumber, velocity, allowTailOff);
+        return;
+    }
+
+    const int index = findRingingVoice(midiChannel, midiNoteNumber);
+    if (index < 0)
+        return;
+
+    auto* voice = fmVoices[static_cast<size_t>(index)];
+    voice->setKeyDown(false);
+    if (!(voice->isSustainPedalDown() || voice->isSostenutoPedalDown()))
+    {
+        catchUp(index);
+        stopVoice(voice, velocity, allowTailOff);
+    }
+}
+
+void FMSynth::allNotesOff(int midiChannel, bool allowTailOff)
+{
+    const juce::ScopedLock sl(lock);
+    refreshVoices();
+
+    for (int k = 0; k < numListed; ++k)
+    {
+        const int i = activeList[static_cast<size_t>(k)];
+        auto* voice = fmVoices[static_cast<size_t>(i)];
+        if (voice->isVoiceActive() && (midiChannel <= 0 || voice->isPlayingChannel(midiChannel)))
+        {
+            catchUp(i);
+            voice->stopNote(1.0f, allowTailOff);
+        }
+    }
+
+    sustainDown.fill(false);
+    monoStackSize = 0;
+    monoNote = -1;
+}
+
+//==============================================================================
+// Mono : la voix 0 suit la pile des touches tenues
+
+void FMSynth::monoNoteOn(int midiChannel, int midiNoteNumber, float velocity)
+{
+    if (numIndexed == 0 || fmVoices[0] == nullptr)
+        return;
+
+    auto* voice = fmVoices[0];
+    const bool inPhrase = monoStackSize > 0 && voice->isVoiceActive();
+
+    // Touche déjà dans la pile (MIDI répété) : remise au sommet
+    const auto stackEnd = monoStack.begin() + monoStackSize;
+    monoStackSize -= static_cast<int>(stackEnd - std::remove(monoStack.begin(), stackEnd, static_cast<int8_t>(midiNoteNumber)));
+    monoStack[static_cast<size_t>(monoStackSize++)] = static_cast<int8_t>(midiNoteNumber);
+    monoVelocity[static_cast<size_t>(midiNoteNumber)] = velocity;
+
+    const int target = pickMonoNote();
+    if (inPhrase && target == monoNote)
+        return;   // note non prioritaire : elle attend dans la pile
+
+    catchUp(0);
+    if (inPhrase && monoLegato)
+        voice->glideToNote(target);
+    else
+        startMonoVoice(midiChannel, target);
+    monoNote = target;
+}
+
+void FMSynth::monoNoteOff(int midiChannel, int midiNoteNumber, float velocity, bool allowTailOff)
+{
+    const auto stackEnd = monoStack.begin() + monoStackSize;
+    const auto newEnd = std::remove(monoStack.begin(), stackEnd, static_cast<int8_t>(midiNoteNumber));
+    if (newEnd == stackEnd)
+        return;
+    monoStackSize = static_cast<int>(newEnd - monoStack.begin());
+
+    auto* voice = fmVoices[0];
+    if (midiNoteNumber != monoNote || voice == nullptr || !voice->isVoiceActive())
+        return;
+
+    catchUp(0);
+
+    // Retour à la touche encore tenue
+    if (monoStackSize > 0)
+    {
+        const int target = pickMonoNote();
+        if (monoLegato)
+            voice->glideToNote(target);
+        else
+            startMonoVoice(midiChannel, target);
+        monoNote = target;
+        return;
+    }
+
+    voice->setKeyDown(false);
+    if (!(voice->isSustainPedalDown() || voice->isSostenutoPedalDown()))
+        stopVoice(voice, velocity, allowTailOff);
+}
+
+void FMSynth::startMonoVoice(int midiChannel, int midiNoteNumber)
+{
+    for (auto* sound : sounds)
+    {
+        if (!sound->appliesToNote(midiNoteNumber) || !sound->appliesToChannel(midiChannel))
+            continue;
+
+        auto* voice = fmVoices[0];
+        markActive(0);
+        startVoice(voice, sound, midiChannel, midiNoteNumber, monoVelocity[static_cast<size_t>(midiNoteNumber)]);
+        voice->setSustainPedalDown(sustainDown[static_cast<size_t>(midiChannel - 1)]);
+        return;
+    }
+}
+
+int FMSynth::pickMonoNote() const noexcept
+{
+    const auto first = monoStack.begin();
+    const auto last = monoStack.begin() + monoStackSize;
+    switch (notePriority)
+    {
+        case NotePriority::Low:  return *std::min_element(first, last);
+        case NotePriority::High: return *std::max_element(first, last);
+        case NotePriority::Last: break;
+    }
+    return monoStack[static_cast<size_t>(monoStackSize - 1)];
+}
+
+void FMSynth::handlePitchWheel(int midiChannel, int wheelValue)
+{
+    const juce::ScopedLock sl(lock);
+    for (int k = 0; k < numListed; ++k)
+    {
+        const int i = activeList[static_cast<size_t>(k)];
+        auto* voice = fmVoices[static_cast<size_t>(i)];
+        if (voice->isVoiceActive() && voice->isPlayingChannel(midiChannel))
+        {
+            catchUp(i);
+            voice->pitchWheelMoved(wheelValue);
+        }
+    }
+}
+
+void FMSynth::handleController(int midiChannel, int controllerNumber, int controllerValue)
+{
+    const juce::ScopedLock sl(lock);
+
+    switch (controllerNumber)
+    {
+        case 0x40:
+            handleSustainPedal(midiChannel, controllerValue >= 64);
+            break;
+        case 0x42:
+            // La sostenuto de JUCE peut couper des voix : rattrapées avant
+            for (int k = 0; k < numListed; ++k)
+                if (fmVoices[static_cast<size_t>(activeList[static_cast<size_t>(k)])]->isPlayingChannel(midiChannel))
+                    catchUp(activeList[static_cast<size_t>(k)]);
+            handleSostenutoPedal(midiChannel, controllerValue >= 64);
+            break;
+        case 0x43:
+            handleSoftPedal(midiChannel, controllerValue >= 64);
+            break;
+        default:
+            break;
+    }
+
+    // FMVoice::controllerMoved est vide (les CC passent par VoiceParams) :
+    // pas de rattrapage, sinon chaque CC découperait à nouveau le bloc
+    for (int k = 0; k < numListed; ++k)
+    {
+        auto* voice = fmVoices[static_cast<size_t>(activeList[static_cast<size_t>(k)])];
+        if (midiChannel <= 0 || voice->isPlayingChannel(midiChannel))
+            voice->controllerMoved(controllerNumber, controllerValue);
+    }
+}
+
+void FMSynth::handleSustainPedal(int midiChannel, bool isDown)
+{
+    if (!juce::isPositiveAndBelow(midiChannel - 1, 16))
+        return;
+
+    const juce::ScopedLock sl(lock);
+    sustainDown[static_cast<size_t>(midiChannel - 1)] = isDown;
+
+    for (int k = 0; k < numListed; ++k)
+    {
+        const int i = activeList[static_cast<size_t>(k)];
+        auto* voice = fmVoices[static_cast<size_t>(i)];
+        if (!voice->isVoiceActive() || !voice->isPlayingChannel(midiChannel))
+            continue;
+
+        if (isDown)
+        {
+            if (voice->isKeyDown())
+                voice->setSustainPedalDown(true);
+        }
+        else
+        {
+            voice->setSustainPedalDown(false);
+            // Touche déjà relâchée : la note tenue par la pédale part en release
+            if (!(voice->isKeyDown() || voice->isSostenutoPedalDown()))
+            {
+                catchUp(i);
+                stopVoice(voice, 1.0f, true);
+            }
+        }
+    }
+}
+
+//==============================================================================
+// Passe de rendu
+
+void FMSynth::renderNextBlock(juce::AudioBuffer<float>& outputAudio, const juce::MidiBuffer& midiData,
+                              int startSample, int numSamples)
+{
+    const juce::ScopedLock sl(lock);
+    beginPass(outputAudio, startSample, numSamples);
+
+    for (const auto metadata : midiData)
+    {
+        if (metadata.samplePosition < startSample)
+            continue;
+        if (metadata.samplePosition >= passEnd)
+            break;
+
+        eventPos = metadata.samplePosition;
+        handleMidiEvent(metadata.getMessage());
+    }
+
+    finishPass();
+}
+
+void FMSynth::renderVoices(juce::AudioBuffer<float>& outputAudio,
+                           int startSample, int numSamples)
+{
+    beginPass(outputAudio, startSample, numSamples);
+    finishPass();
+}
+
+void FMSynth::beginPass(juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples) noexcept
+{
+    refreshVoices();
+
+    passOutput = &outputAudio;
+    passStart = startSample;
+    passEnd = startSample + numSamples;
+    eventPos = startSample;
+    inPass = true;
+
+    for (int k = 0; k < numListed; ++k)
+        cursor[static_cast<size_t>(activeList[static_cast<size_t>(k)])] = startSample;
+}
+
+// Hors passe (note jouée entre deux blocs), rien à rattraper : la voix
+// démarre au début du bloc suivant
+void FMSynth::catchUp(int index) noexcept
+{
+    if (!inPass)
+        return;
+
+    auto& pos = cursor[static_cast<size_t>(index)];
+    if (pos >= eventPos)
+        return;
+
+    FMVoice* voice = fmVoices[static_cast<size_t>(index)];
+    if (voice->isVoiceActive())
+        banks[0].render(&voice, 1, *passOutput, pos, eventPos - pos);
+    pos = eventPos;
+}
+
+void FMSynth::finishPass() noexcept
+{
+    eventPos = passEnd;
+
+    // Voix intactes depuis le début du bloc : rendu groupé. Le cache de
+    // notes est partagé sans verrou : ses voix restent en tête de liste,
+    // donc dans le job du thread audio. Voix déjà rattrapées : fin du bloc
+    // voix par voix.
+    int numBatch = 0;
+    int numCached = 0;
+    for (int k = 0; k < numListed; ++k)
+    {
+        const int i = activeList[static_cast<size_t>(k)];
+        auto* voice = fmVoices[static_cast<size_t>(i)];
+        if (!voice->isVoiceActive())
+            continue;
+
+        if (cursor[static_cast<size_t>(i)] != passStart)
+        {
+            catchUp(i);
+        }
+        else if (voice->usesNoteCache())
+        {
+            batchVoices[static_cast<size_t>(numBatch++)] = batchVoices[static_cast<size_t>(numCached)];
+            batchVoices[static_cast<size_t>(numCached++)] = voice;
+        }
+        else
+        {
+            batchVoices[static_cast<size_t>(numBatch++)] = voice;
+        }
+    }
+
+    renderBatch(numBatch, numCached);
+    inPass = false;
+
+    // Voix terminées : retour sur la pile libre (hors polyphonie, elles
+    // attendent qu'elle remonte)
+    int numKept = 0;
+    for (int k = 0; k < numListed; ++k)
+    {
+        const int i = activeList[static_cast<size_t>(k)];
+        if (fmVoices[static_cast<size_t>(i)]->isVoiceActive())
+        {
+            activeList[static_cast<size_t>(numKept++)] = i;
+            continue;
+        }
+
+        listed[static_cast<size_t>(i)] = false;
+        if (i < polyphony)
+            freeList[static_cast<size_t>(numFree++)] = i;
+    }
+    numListed = numKept;
+}
+
+void FMSynth::renderBatch(int numBatch, int numCached) noexcept
+{
+    if (numBatch == 0)
+        return;
+
+    const int numSamples = passEnd - passStart;
+    const bool parallel = workerPool != nullptr
+                       && parallelThreshold > 0
+                       && numBatch >= parallelThreshold
+                       && numSamples <= jobCapacity
+                       && passOutput->getNumChannels() <= 2;
+    const int numJobs = parallel ? planJobs(numBatch, numCached) : 1;
+
+    if (numJobs <= 1)
+    {
+        banks[0].render(batchVoices.data(), numBatch, *passOutput, passStart, numSamples);
+        return;
+    }
+
+    workerPool->run(numJobs, &FMSynth::runJob, this);
+
+    for (int j = 1; j < numJobs; ++j)
+        for (int ch = 0; ch < passOutput->getNumChannels(); ++ch)
+            passOutput->addFrom(ch, passStart, jobBuffers[static_cast<size_t>(j)], ch, 0, numSamples);
+}
+
+// Découpe batchVoices en tranches contiguës (les groupes de lanes restent
+// entiers autant que possible) ; le job 0 prend au moins les voix cachées.
+int FMSynth::planJobs(int numActive, int numCached) noexcept
+{
+    const int numJobs = juce::jmin(workerPool->getNumWorkers() + 1, kMaxJobs,
+                                   numActive / kMinVoicesPerJob);
+    int first = 0;
+    for (int j = 0; j < numJobs; ++j)
+    {
+        int end = (j + 1) * numActive / numJobs;
+        if (j == 0)
+            end = juce::jmax(end, numCached);
+        end = juce::jmax(end, first);
+        jobs[static_cast<size_t>(j)] = { first, end - first };
+        first = end;
+    }
+    return numJobs;
+}
+
+void FMSynth::runJob(void* context, int jobIndex) noexcept
+{
+    static_cast<FMSynth*>(context)->renderJob(jobIndex);
+}
+
+void FMSynth::renderJob(int jobIndex) noexcept
+{
+    const auto& job = jobs[static_cast<size_t>(jobIndex)];
+    auto& bank = banks[static_cast<size_t>(jobIndex)];
+    FMVoice* const* voicesOfJob = batchVoices.data() + job.first;
+    const int numSamples = passEnd - passStart;
+
+    // Job 0 : directement dans la sortie ; les autres dans leur tampon
+    if (jobIndex == 0)
+    {
+        bank.render(voicesOfJob, job.count, *passOutput, passStart, numSamples);
+        return;
+    }
+
+    auto& buffer = jobBuffers[static_cast<size_t>(jobIndex)];
+    juce::AudioBuffer<float> view(buffer.getArrayOfWritePointers(), passOutput->getNumChannels(), 0, numSamples);
+    view.clear();
+    if (job.count > 0)
+        bank.render(voicesOfJob, job.count, view, 0, numSamples);
+}
+
+} // namespace bb
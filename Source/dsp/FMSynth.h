@@ -0,0 +1,183 @@
+// FMSynth.h — juce::Synthesiser spécialisé pour les FMVoice
+// juce::Synthesiser ne sert plus que de conteneur (voix, son, API MIDI).
+// L'allocation et le découpage sont remplacés :
+//
+//  - pas de découpage du bloc aux événements MIDI : chaque voix garde un
+//    curseur et n'est rendue jusqu'à l'instant d'un événement que si cet
+//    événement la concerne (note-on, note-off, pédale, pitch bend...). Le
+//    reste du bloc est rendu d'un seul tenant, par paquets via VoiceBank
+//    (lanes SIMD) ;
+//  - voix libres dans une pile (O(1)), voix actives dans une liste, note
+//    → voix dans une table : ni note-on ni note-off ne parcourt les voix ;
+//  - pédale de sustain gérée ici, vol de voix selon une StealPolicy.
+//
+// Les voix sont toutes créées au démarrage (jusqu'à kMaxVoices) ; la
+// polyphonie ne fait que borner celles que l'allocation peut choisir.
+//
+// Avec un VoiceWorkerPool et assez de voix actives, les paquets sont
+// répartis entre le thread audio et les workers : chaque job a son
+// VoiceBank et son tampon, sommés ensuite dans l'ordre des jobs (résultat
+// indépendant de l'ordonnancement).
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <array>
+#include <cstdint>
+#include "FMVoice.h"
+#include "VoiceBank.h"
+#include "VoiceWorkerPool.h"
+
+namespace bb {
+
+class FMSynth : public juce::Synthesiser
+{
+public:
+    static constexpr int kMaxVoices = 128;
+    static constexpr int kMaxJobs = VoiceWorkerPool::kMaxWorkers + 1;
+    // En dessous, un job coûte plus en synchronisation qu'il ne rapporte
+    static constexpr int kMinVoicesPerJob = 2;
+
+    // Voix prise quand toutes sont occupées
+    enum class StealPolicy
+    {
+        Oldest,     // heuristique JUCE : la plus ancienne, notes extrêmes tenues protégées
+        Quietest,   // le plus faible niveau suivi (FMVoice::getTrackedLevel)
+        SameNote    // la voix qui joue déjà la note est relancée, sinon Oldest
+    };
+
+    // Note jouée en mono quand plusieurs touches sont tenues
+    enum class NotePriority { Last, Low, High };
+
+    FMSynth();
+
+    // Désactivable pour comparer avec le rendu scalaire (tests, debug)
+    void setLaneRenderingEnabled(bool shouldUseLanes) noexcept;
+    bool isLaneRenderingEnabled() const noexcept { return banks[0].isEnabled(); }
+    // Voix rendues par le noyau lanes, une par bloc (somme des bancs)
+    uint64_t getNumLaneVoiceBlocks() const noexcept;
+
+    // Thread message : pool partagé (nullptr = rendu sur le seul thread
+    // audio) et taille max d'un rendu, pour les tampons des jobs. À
+    // l'appelant de signaler la fin de chaque bloc hôte (pool->endBlock())
+    void setWorkerPool(VoiceWorkerPool* pool, int maxBlockSize);
+    // Thread audio, par bloc : nombre de voix actives à partir duquel le
+    // rendu est réparti (0 = jamais)
+    void setParallelVoiceThreshold(int minActiveVoices) noexcept { parallelThreshold = minActiveVoices; }
+
+    // Thread message : instantané de paramètres partagé par toutes les
+    // voix, que l'appelant capture avant chaque renderNextBlock (nullptr =
+    // chaque voix lit VoiceParams elle-même)
+    void setBlockParams(const VoiceBlockParams* snapshot);
+
+    // Thread message : bruit reproductible, chaque voix repart d'un flux
+    // dérivé de seed et de son index (même seed, mêmes notes → même rendu)
+    void setNoiseSeed(uint32_t seed);
+
+    // Thread audio : seules les numVoices premières voix reçoivent des
+    // notes. En baisse, les voix en trop passent en release.
+    void setPolyphony(int numVoices) noexcept;
+    int getPolyphony() const noexcept { return polyphony; }
+
+    void setStealPolicy(StealPolicy newPolicy) noexcept { stealPolicy = newPolicy; }
+    StealPolicy getStealPolicy() const noexcept { return stealPolicy; }
+
+    // Thread audio, par bloc. Mono : une seule voix (la voix 0) et une pile
+    // des touches tenues. En legato, changer de note ne relance ni les
+    // enveloppes ni les phases (glide depuis la hauteur courante) ; sinon
+    // chaque note relance la voix. Relâcher la note jouée revient à la
+    // touche tenue prioritaire. Changer de mode relâche toutes les notes.
+    void setMonoMode(bool shouldBeMono, NotePriority priority, bool legato) noexcept;
+    bool isMonoMode() const noexcept { return mono; }
+
+    // Remplace juce::Synthesiser::renderNextBlock : les événements sont
+    // appliqués à leur échantillon exact, sans découper le bloc
+    void renderNextBlock(juce::AudioBuffer<float>& outputAudio, const juce::MidiBuffer& midiData,
+                         int startSample, int numSamples);
+
+    void noteOn(int midiChannel, int midiNoteNumber, float velocity) override;
+    void noteOff(int midiChannel, int midiNoteNumber, float velocity, bool allowTailOff) override;
+    void allNotesOff(int midiChannel, bool allowTailOff) override;
+    void handlePitchWheel(int midiChannel, int wheelValue) override;
+    void handleController(int midiChannel, int controllerNumber, int controllerValue) override;
+    void handleSustainPedal(int midiChannel, bool isDown) override;
+
+protected:
+    void renderVoices(juce::AudioBuffer<float>& outputAudio,
+                      int startSample, int numSamples) override;
+
+private:
+    // Voix [first, first + count) de batchVoices
+    struct Job { int first = 0, count = 0; };
+
+    // Index des FMVoice, pile libre et liste active (si des voix ont été
+    // ajoutées depuis le dernier appel)
+    void refreshVoices() noexcept;
+    void rebuildFreeList() noexcept;
+    int popFreeVoice() noexcept;
+    void markActive(int index) noexcept;
+    int findRingingVoice(int midiChannel, int midiNoteNumber) const noexcept;
+    int chooseVoiceToSteal(int midiNoteNumber) const noexcept;
+
+    void monoNoteOn(int midiChannel, int midiNoteNumber, float velocity);
+    void monoNoteOff(int midiChannel, int midiNoteNumber, float velocity, bool allowTailOff);
+    // Lance la voix mono sur la note (relance les enveloppes)
+    void startMonoVoice(int midiChannel, int midiNoteNumber);
+    int pickMonoNote() const noexcept;
+
+    // Rend la voix jusqu'à l'événement en cours (eventPos)
+    void catchUp(int index) noexcept;
+    void beginPass(juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples) noexcept;
+    void finishPass() noexcept;
+    void renderBatch(int numBatch, int numCached) noexcept;
+
+    int planJobs(int numActive, int numCached) noexcept;
+    static void runJob(void* context, int jobIndex) noexcept;
+    void renderJob(int jobIndex) noexcept;
+
+    int polyphony = kMaxVoices;
+    const VoiceBlockParams* blockParams = nullptr;
+    StealPolicy stealPolicy = StealPolicy::Oldest;
+
+    // Voix indexées ; une voix qui n'est pas une FMVoice reste nullptr et
+    // n'est jamais allouée (le processor n'ajoute que des FMVoice)
+    int numIndexed = 0;
+    std::array<FMVoice*, kMaxVoices> fmVoices {};
+
+    std::array<int, kMaxVoices> freeList {};     // sommet = freeList[numFree - 1]
+    int numFree = 0;
+    std::array<int, kMaxVoices> activeList {};   // voix non libres, dans l'ordre d'activation
+    int numListed = 0;
+    std::array<bool, kMaxVoices> listed {};
+
+    // Dernière voix lancée par (canal, note), -1 si aucune
+    std::array<std::array<int16_t, 128>, 16> noteVoice;
+    std::array<bool, 16> sustainDown {};
+
+    // Mono : touches tenues dans l'ordre d'appui, vélocité de chacune
+    bool mono = false;
+    bool monoLegato = true;
+    NotePriority notePriority = NotePriority::Last;
+    std::array<int8_t, 128> monoStack {};
+    int monoStackSize = 0;
+    std::array<float, 128> monoVelocity {};
+    int monoNote = -1;   // note de la voix mono (tenue ou en release)
+
+    // Passe de rendu en cours (sortie et bloc lus aussi par les jobs),
+    // curseur de rendu par voix
+    juce::AudioBuffer<float>* passOutput = nullptr;
+    int passStart = 0;
+    int passEnd = 0;
+    int eventPos = 0;
+    bool inPass = false;
+    std::array<int, kMaxVoices> cursor {};
+
+    std::array<VoiceBank, kMaxJobs> banks;
+    std::array<FMVoice*, kMaxVoices> batchVoices {};
+
+    VoiceWorkerPool* workerPool = nullptr;
+    int parallelThreshold = 0;
+    int jobCapacity = 0;
+    std::array<juce::AudioBuffer<float>, kMaxJobs> jobBuffers;
+    std::array<Job, kMaxJobs> jobs {};
+};
+
+} // namespace bb
@@ -2,7 +2,14 @@
 // Tout le signal path est ici : modulation, routing, effets, sortie
 #include "FMVoice.h"
 #include "FMSound.h"
+#include "FastMath.h"
+#include "NoteCache.h"
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstring>
+#include <type_traits>
+#include <utility>
 
 namespace bb {
 
@@ -10,9 +17,82 @@ namespace bb {
 static constexpr double kTwoPi = 2.0 * 3.14159265358979323846;
 // Index de modulation maximum (en radians) — 12 rad = gros son FM
 static constexpr double kMaxModIndex = 12.0;
+// --- Tables de dispatch des noyaux spécialisés ---
+// Index = flags encodés en bits ; chaque entrée est une instanciation
+// distincte des templates de FMVoice.
+struct FMVoice::KernelTables
+{
+    static constexpr int kNumAlgos = 6;
+
+    template <std::size_t... I>
+    static constexpr std::array<ControlKernel, sizeof...(I)> makeControl(std::index_sequence<I...>)
+    {
+        return {{ &FMVoice::renderControlKernel<((I >> 1) & 1) != 0, (I & 1) != 0>... }};
+    }
+
+    template <std::size_t... I>
+    static constexpr std::array<ModulatorKernel, sizeof...(I)> makeModulators(std::index_sequence<I...>)
+    {
+        return {{ &FMVoice::renderModulators<static_cast<int>(I >> 2), ((I >> 1) & 1) != 0, (I & 1) != 0>... }};
+    }
+
+    template <std::size_t... I>
+    static constexpr std::array<ModulatorKernel, sizeof...(I)> makeOperators(std::index_sequence<I...>)
+    {
+        return {{ &FMVoice::renderOperators<static_cast<int>(I >> 3), static_cast<unsigned>((I & 7) << 1)>... }};
+    }
+
+    template <std::size_t... I>
+    static constexpr std::array<PostChainKernel, sizeof...(I)> makePostChain(std::index_sequence<I...>)
+    {
+        return {{ &FMVoice::renderPostChain<1 << (I >> 5),
+                                             ((I >> 4) & 1) != 0, ((I >> 3) & 1) != 0,
+                                             ((I >> 2) & 1) != 0, ((I >> 1) & 1) != 0,
+                                             (I & 1) != 0>... }};
+    }
+
+    template <std::size_t... I>
+    static constexpr std::array<CarrierKernel, sizeof...(I)> makeCarrier(std::index_sequence<I...>)
+    {
+        return {{ &FMVoice::renderCarrier<1 << (I >> 1), (I & 1) != 0>... }};
+    }
+
+    template <std::size_t... I>
+    static constexpr std::array<CarrierKernel, sizeof...(I)> makeUnisonCarrier(std::index_sequence<I...>)
+    {
+        return {{ &FMVoice::renderUnisonCarrier<1 << (I >> 1), (I & 1) != 0>... }};
+    }
+
+    // Index de suréchantillonnage : 0 = 1×, 1 = 2×, 2 = 4×
+    static constexpr int kNumOversampling = 3;
+    static int oversamplingIndex(int factor) noexcept { return factor == 4 ? 2 : factor == 2 ? 1 : 0; }
+
+    static const std::array<ControlKernel, 4>               control;    // [pitchEnv][filt]
+    static const std::array<ModulatorKernel, kNumAlgos * 4> modulators; // [algo][mod1][mod2]
+    static const std::array<ModulatorKernel, opgraph::kNumAlgos * 8> operators; // [opAlgo][mod3][mod2][mod1]
+    static const std::array<PostChainKernel, kNumOversampling * 32> postChain; // [os][noise][mix][xor][filt][fold]
+    static const std::array<CarrierKernel, kNumOversampling * 2>    carrier;   // [os][sync]
+    static const std::array<CarrierKernel, kNumOversampling * 2>    unisonCarrier; // [os][sync]
+};
+
+const std::array<FMVoice::ControlKernel, 4> FMVoice::KernelTables::control
+    = makeControl(std::make_index_sequence<4>());
+const std::array<FMVoice::ModulatorKernel, FMVoice::KernelTables::kNumAlgos * 4> FMVoice::KernelTables::modulators
+    = makeModulators(std::make_index_sequence<kNumAlgos * 4>());
+const std::array<FMVoice::ModulatorKernel, opgraph::kNumAlgos * 8> FMVoice::KernelTables::operators
+    = makeOperators(std::make_index_sequence<opgraph::kNumAlgos * 8>());
+const std::array<FMVoice::PostChainKernel, FMVoice::KernelTables::kNumOversampling * 32> FMVoice::KernelTables::postChain
+    = makePostChain(std::make_index_sequence<kNumOversampling * 32>());
+const std::array<FMVoice::CarrierKernel, FMVoice::KernelTables::kNumOversampling * 2> FMVoice::KernelTables::carrier
+    = makeCarrier(std::make_index_sequence<kNumOversampling * 2>());
+const std::array<FMVoice::CarrierKernel, FMVoice::KernelTables::kNumOversampling * 2> FMVoice::KernelTables::unisonCarrier
+    = makeUnisonCarrier(std::make_index_sequence<kNumOversampling * 2>());
+
 FMVoice::FMVoice(VoiceParams& p)
     : params(p)
 {
+    controlKernel = KernelTables::control[0];
+    carrierKernel = KernelTables::carrier[0];
 }
 
 bool FMVoice::canPlaySound(juce::SynthesiserSound* sound)
@@ -20,130 +100,177 @@ bool FMVoice::canPlaySound(juce::SynthesiserSound* sound)
     return dynamic_cast<FMSound*>(sound) != nullptr;
 }
 
+void FMVoice::seedNoise(uint32_t seed) noexcept
+{
+    hot.noiseL.seed(BlockNoise::streamFor(seed, 0));
+    hot.noiseR.seed(BlockNoise::streamFor(seed, 1));
+    hot.mod1Osc.seedNoise(BlockNoise::streamFor(seed, 2));
+    hot.mod2Osc.seedNoise(BlockNoise::streamFor(seed, 3));
+    hot.carrierOsc.seedNoise(BlockNoise::streamFor(seed, 4));
+    hot.carrierOscR.seedNoise(BlockNoise::streamFor(seed, 5));
+    mod3.osc.seedNoise(BlockNoise::streamFor(seed, 6));
+}
+
 void FMVoice::prepareToPlay(double sr, int /*samplesPerBlock*/)
 {
     sampleRate = sr;
-
-    mod1Osc.prepare(sr);
-    mod2Osc.prepare(sr);
-    carrierOsc.prepare(sr);
-    carrierOscR.prepare(sr);
-
-    env1.prepare(sr);
-    env2.prepare(sr);
-    env3.prepare(sr);
-    pitchEnv.prepare(sr);
-
-    lfo1.prepare(sr);
-    lfo2.prepare(sr);
-
-    filterL.prepare(sr);
-    filterR.prepare(sr);
-    dcBlockerL.prepare(sr);
-    dcBlockerR.prepare(sr);
-    hemoFoldL.prepare(sr);
-    hemoFoldR.prepare(sr);
+    appliedSerial = kStaleSerial;
+
+    hot.mod1Osc.prepare(sr);
+    hot.mod2Osc.prepare(sr);
+    hot.carrierOsc.prepare(sr);
+    hot.carrierOscR.prepare(sr);
+    unisonStack.prepare(sr);
+    mod3.osc.prepare(sr);
+    mod3.env.prepare(sr);
+
+    hot.env1.prepare(sr);
+    hot.env2.prepare(sr);
+    hot.env3.prepare(sr);
+    hot.pitchEnv.prepare(sr);
+
+    hot.lfo1.prepare(sr);
+    hot.lfo2.prepare(sr);
+
+    hot.filterL.prepare(sr);
+    hot.filterR.prepare(sr);
+    hot.dcBlockerL.prepare(sr);
+    hot.dcBlockerR.prepare(sr);
+    hot.hemoFoldL.prepare(sr);
+    hot.hemoFoldR.prepare(sr);
+    hot.driveShaperL.reset();
+    hot.driveShaperR.reset();
 
     // LFO rates fixes
-    lfo1.setRate(3.5f);  // LFO1 pour tremor (pitch) et flux (mod index)
-    lfo1.setWaveType(LFOWaveType::Sine);
-    lfo2.setRate(2.0f);  // LFO2 pour vein (filter)
-    lfo2.setWaveType(LFOWaveType::Sine);
-
-    // SmoothedValues : temps de lissage 20ms (anti-zipper noise)
-    smoothVolume.reset(sr, 0.02);
-    smoothCutoff.reset(sr, 0.02);
-    smoothMod1Level.reset(sr, 0.02);
-    smoothMod2Level.reset(sr, 0.02);
-    smoothCarNoise.reset(sr, 0.02);
-    smoothCarSpread.reset(sr, 0.02);
-    smoothDrive.reset(sr, 0.010);      // 10ms — saturation curvature zips hard
-    smoothFold.reset(sr, 0.010);       // 10ms — wavefolder amount
+    hot.lfo1.setRate(3.5f);  // LFO1 pour tremor (pitch) et flux (mod index)
+    hot.lfo1.setWaveType(LFOWaveType::Sine);
+    hot.lfo2.setRate(2.0f);  // LFO2 pour vein (filter)
+    hot.lfo2.setWaveType(LFOWaveType::Sine);
+
+    // Smoothers : temps de lissage 20ms (anti-zipper noise)
+    auto& sm = hot.smoothers;
+    for (int k : { SmoothVolume, SmoothCutoff, SmoothMod1Level, SmoothMod2Level,
+                   SmoothCarNoise, SmoothCarSpread, SmoothMod3Level })
+        sm.reset(k, sr, 0.02);
+    sm.reset(SmoothDrive, sr, 0.010);      // 10ms — saturation curvature zips hard
+    sm.reset(SmoothFold, sr, 0.010);       // 10ms — wavefolder amount
 
     // Global LFO sums: 5ms ramps — short enough to feel immediate, long
     // enough to kill block-rate steps on fast LFO rates.
-    smoothGLfoPitch.reset(sr, 0.005);
-    smoothGLfoCutoff.reset(sr, 0.005);
-    smoothGLfoRes.reset(sr, 0.005);
-    smoothGLfoVolume.reset(sr, 0.005);
-    smoothGLfoDrive.reset(sr, 0.005);
-    smoothGLfoMod1Lvl.reset(sr, 0.005);
-    smoothGLfoMod2Lvl.reset(sr, 0.005);
-    smoothGLfoNoise.reset(sr, 0.005);
-    smoothGLfoSpread.reset(sr, 0.005);
-    smoothGLfoFold.reset(sr, 0.005);
+    for (int k = SmoothGLfoPitch; k <= SmoothGLfoFold; ++k)
+        sm.reset(k, sr, 0.005);
 
     // Reset filter coefficient cache
-    lastFilterCutoff = -1.0f;
-    lastFilterRes    = -1.0f;
+    hot.lastFilterCutoff = -1.0f;
+    hot.lastFilterRes    = -1.0f;
 
     // Anti-click fade: ~5ms
-    stealFadeLength = std::max(1, static_cast<int>(sr * 0.005));
-    stealFadeSamples = 0;
+    hot.stealFadeLength = std::max(1, static_cast<int>(sr * 0.005));
+    hot.stealFadeSamples = 0;
 
     // Anti-click fade-in: ~3ms
-    noteFadeInLength = std::max(1, static_cast<int>(sr * 0.003));
-    noteFadeInSamples = 0;
+    hot.noteFadeInLength = std::max(1, static_cast<int>(sr * 0.003));
+    hot.noteFadeInSamples = 0;
+
+    // Étages suréchantillonnés préparés au taux de base ; beginBlock()
+    // applique le facteur demandé
+    osFactor = 1;
+    hot.lastPhaseMod = 0.0;
+    decimatorL.reset();
+    decimatorR.reset();
+
+    // Le cache est re-préparé avec les voix : les entrées ne sont plus valides
+    cacheMode = CacheMode::Off;
+    cacheEntry = nullptr;
+}
+
+void FMVoice::setOversampling(int factor)
+{
+    osFactor = factor;
+    const double osRate = sampleRate * static_cast<double>(factor);
+
+    // Tout ce qui tourne après les modulateurs : leurs coefficients
+    // dépendent du taux. Les phases des carriers sont conservées.
+    hot.carrierOsc.setSampleRate(osRate);
+    hot.carrierOscR.setSampleRate(osRate);
+    unisonStack.setSampleRate(osRate);
+    hot.filterL.prepare(osRate);
+    hot.filterR.prepare(osRate);
+    hot.dcBlockerL.prepare(osRate);
+    hot.dcBlockerR.prepare(osRate);
+    hot.hemoFoldL.prepare(osRate);
+    hot.hemoFoldR.prepare(osRate);
+    hot.lastFilterCutoff = -1.0f;
+    hot.lastFilterRes    = -1.0f;
+
+    hot.lastPhaseMod = 0.0;
+    decimatorL.reset();
+    decimatorR.reset();
 }
 
 void FMVoice::startNote(int midiNoteNumber, float velocity,
                          juce::SynthesiserSound*, int currentPitchWheelPosition)
 {
-    noteVelocity = velocity;
+    leaveCache();
+
+    hot.noteVelocity = velocity;
+    trackedLevel = 1.0f;
     params.lastVelocity.store(velocity, std::memory_order_relaxed);
-    stealFadeSamples = 0;  // cancel any in-progress steal fade
+    hot.stealFadeSamples = 0;  // cancel any in-progress steal fade
 
-    // Convertir note MIDI → fréquence : f = 440 × 2^((note-69)/12)
-    // Global octave shift applied here (saved per preset, like Serum)
-    int octaveShift = static_cast<int>(params.octave ? params.octave->load() : 0.0f);
-    noteFreqHz = 440.0 * std::pow(2.0, (midiNoteNumber - 69 + octaveShift * 12) / 12.0);
-    targetNoteFreq = noteFreqHz;
+    noteFreqHz = noteToFrequency(midiNoteNumber);
+    hot.targetNoteFreq = noteFreqHz;
 
     // Portamento : glide en mono si porta > 0
     bool isMono = params.mono->load() > 0.5f;
     bool shouldRetrig = params.retrig->load() > 0.5f;
-    float portaTime = params.porta ? params.porta->load() : 0.0f;
-    portaTime = juce::jlimit(0.0f, 1.0f, portaTime
-                + params.lfoModPorta.load(std::memory_order_relaxed));
+    float portaTime = getPortamentoTime();
 
     // Serum-style: portamento only in mono mode, always glides from last note
     float lastFreq = params.lastNoteFreqHz.load(std::memory_order_relaxed);
     if (!isMono || portaTime < 0.001f || lastFreq <= 0.0f)
-        currentFreq = noteFreqHz;
+        hot.currentFreq = noteFreqHz;
     else
-        currentFreq = static_cast<double>(lastFreq);
+        hot.currentFreq = static_cast<double>(lastFreq);
     params.lastNoteFreqHz.store(static_cast<float>(noteFreqHz), std::memory_order_relaxed);
 
-    // Portamento: exponential smoothing with time in seconds.
-    // portaTime 0-1 maps to 0-2 seconds glide time.
-    if (portaTime > 0.001f)
-    {
-        double glideTimeSec = static_cast<double>(portaTime) * 2.0; // 0-1 → 0-2s
-        portamentoRate = std::exp(-1.0 / (glideTimeSec * sampleRate));
-    }
-    else
-    {
-        portamentoRate = 0.0;
-    }
+    setPortamento(portaTime);
 
     // Pitch wheel
     pitchWheelMoved(currentPitchWheelPosition);
 
+    // Note rejouable depuis le cache : voix au repos et phases remises à
+    // zéro, donc même point de départ à chaque frappe. La décision finale
+    // (patch déterministe, entrée existante) se prend au premier rendu.
+    const bool cacheOn = params.renderCache != nullptr && params.noteCache != nullptr
+                         && params.noteCache->load() > 0.5f;
+    cacheMode = (cacheOn && !hot.env3.isActive() && (shouldRetrig || !isMono))
+                    ? CacheMode::Armed : CacheMode::Off;
+
     // Reset oscillator phases for clean attack (retrigger or poly mode)
     if (shouldRetrig || !isMono)
     {
-        mod1Osc.resetPhase();
-        mod2Osc.resetPhase();
-        carrierOsc.resetPhase();
-        carrierOscR.resetPhase();
-
-        if (!env3.isActive())
+        hot.mod1Osc.resetPhase();
+        hot.mod2Osc.resetPhase();
+        hot.carrierOsc.resetPhase();
+        hot.carrierOscR.resetPhase();
+        unisonStack.resetPhases();
+        mod3.osc.resetPhase();
+
+        if (!hot.env3.isActive())
         {
             // Voice was idle — hard-reset envelopes (no pop, voice is silent)
-            env1.reset();
-            env2.reset();
-            env3.reset();
-            pitchEnv.reset();
+            hot.env1.reset();
+            hot.env2.reset();
+            hot.env3.reset();
+            hot.pitchEnv.reset();
+            mod3.env.reset();
+            // Drop the previous note's tail from the decimator history
+            decimatorL.reset();
+            decimatorR.reset();
+            hot.lastPhaseMod = 0.0;
+            hot.driveShaperL.reset();
+            hot.driveShaperR.reset();
         }
         // If env3 IS active (voice stealing), don't reset — ADSR retriggers
         // smoothly from the current level, avoiding pops.
@@ -155,38 +282,91 @@ void FMVoice::startNote(int midiNoteNumber, float velocity,
     // here would silently override the time macro for every note (the
     // cache optimisation then skips the re-push when macro values haven't
     // changed from the last note's scaled cache).
-    mod2FeedbackSample = 0.0f;
-    env1.noteOn();
-    env2.noteOn();
-    env3.noteOn();
-    pitchEnv.noteOn();
+    hot.mod2FeedbackSample = 0.0f;
+    mod3.feedbackSample = 0.0f;
+    hot.env1.noteOn();
+    hot.env2.noteOn();
+    hot.env3.noteOn();
+    hot.pitchEnv.noteOn();
+    mod3.env.noteOn();
 
     // Anti-click fade-in for the first samples of the new note
-    noteFadeInSamples = noteFadeInLength;
+    hot.noteFadeInSamples = hot.noteFadeInLength;
+}
+
+void FMVoice::glideToNote(int midiNoteNumber)
+{
+    // La note change en cours de lecture : retour au rendu direct
+    leaveCache();
+
+    // currentFreq est conservée : le glide part de la hauteur entendue,
+    // y compris au milieu d'un glide précédent
+    noteFreqHz = noteToFrequency(midiNoteNumber);
+    hot.targetNoteFreq = noteFreqHz;
+    params.lastNoteFreqHz.store(static_cast<float>(noteFreqHz), std::memory_order_relaxed);
+    setPortamento(getPortamentoTime());
+}
+
+double FMVoice::noteToFrequency(int midiNoteNumber) const
+{
+    // Convertir note MIDI → fréquence : f = 440 × 2^((note-69)/12)
+    // Global octave shift applied here (saved per preset, like Serum)
+    int octaveShift = static_cast<int>(params.octave ? params.octave->load() : 0.0f);
+    return 440.0 * std::pow(2.0, (midiNoteNumber - 69 + octaveShift * 12) / 12.0);
+}
+
+float FMVoice::getPortamentoTime() const
+{
+    float portaTime = params.porta ? params.porta->load() : 0.0f;
+    return juce::jlimit(0.0f, 1.0f, portaTime
+                        + params.lfoModPorta.load(std::memory_order_relaxed));
+}
+
+void FMVoice::setPortamento(float portaTime)
+{
+    // Portamento: exponential smoothing with time in seconds.
+    // portaTime 0-1 maps to 0-2 seconds glide time.
+    if (portaTime > 0.001f)
+    {
+        double glideTimeSec = static_cast<double>(portaTime) * 2.0; // 0-1 → 0-2s
+        hot.portamentoRate = std::exp(-1.0 / (glideTimeSec * sampleRate));
+    }
+    else
+    {
+        hot.portamentoRate = 0.0;
+    }
 }
 
 void FMVoice::stopNote(float /*velocity*/, bool allowTailOff)
 {
+    // Le relâchement dépend de sa position : retour au rendu direct
+    leaveCache();
+
     // Standard ADSR: every envelope responds to noteOff, including pitch.
     // At sustain=0 with long decay, release then starts from 0 and ramps
     // from 0 → 0 (silent, no click). Users expect the release knob to
     // always have an effect, which requires always calling noteOff.
-    env1.noteOff();
-    env2.noteOff();
-    env3.noteOff();
-    pitchEnv.noteOff();
+    hot.env1.noteOff();
+    hot.env2.noteOff();
+    hot.env3.noteOff();
+    hot.pitchEnv.noteOff();
+    mod3.env.noteOff();
 
     if (!allowTailOff)
     {
         // Voice stealing: short fade-out
-        stealFadeSamples = stealFadeLength;
+        hot.stealFadeSamples = hot.stealFadeLength;
     }
 }
 
 void FMVoice::pitchWheelMoved(int newPitchWheelValue)
 {
+    // Le rattrapage doit se faire avec l'ancien bend
+    if (cacheMode == CacheMode::Play)
+        leaveCachePlayback();
+
     // Pitch wheel : ±2 semitones (standard)
-    pitchBendSemitones = (newPitchWheelValue - 8192) / 8192.0 * 2.0;
+    hot.pitchBendSemitones = (newPitchWheelValue - 8192) / 8192.0 * 2.0;
 }
 
 void FMVoice::controllerMoved(int /*controllerNumber*/, int /*newControllerValue*/)
@@ -198,12 +378,48 @@ void FMVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer,
 {
     juce::ScopedNoDenormals noDenormals;
 
-    if (!env3.isActive())
+    if (!hot.env3.isActive())
     {
         clearCurrentNote();
         return;
     }
 
+    beginBlock(numSamples);
+    renderPrepared(outputBuffer, startSample, numSamples);
+}
+
+void FMVoice::renderPrepared(juce::AudioBuffer<float>& outputBuffer,
+                             int startSample, int numSamples)
+{
+    if (cacheMode != CacheMode::Off)
+    {
+        const int numPlayed = renderFromCache(outputBuffer, startSample, numSamples);
+        startSample += numPlayed;
+        numSamples  -= numPlayed;
+    }
+
+    for (int offset = 0; offset < numSamples; offset += kControlBlock)
+    {
+        const int n = std::min(kControlBlock, numSamples - offset);
+        renderControl(n);
+        if (!renderAudio(outputBuffer, startSample + offset, n))
+            return;
+        if (cacheMode == CacheMode::Record)
+            recordCached(n);
+    }
+
+    cullIfInaudible();
+    if (!hot.env3.isActive())
+    {
+        leaveCache();
+        clearCurrentNote();
+    }
+}
+
+void VoiceBlockParams::capture(const VoiceParams& params) noexcept
+{
+    ++serial;
+
     // --- Lire les paramètres une fois par bloc ---
     // Macros (read first, used by mod levels below)
     float vortexP      = juce::jlimit(0.0f, 1.0f,
@@ -246,6 +462,21 @@ void FMVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer,
     float mod2FixedHz    = params.mod2FixedFreq->load();
     int   mod2MultiVal   = static_cast<int>(params.mod2Multi->load());
 
+    // Mod3 / graphe 4 opérateurs : absents (nullptr) = mode classique
+    bool  opMatrix       = params.mod3On != nullptr && params.mod3On->load() > 0.5f;
+    int   opAlgo         = params.opAlgo
+        ? juce::jlimit(0, opgraph::kNumAlgos - 1, static_cast<int>(params.opAlgo->load())) : 0;
+    auto mod3WaveIdx     = params.mod3Wave ? juce::jlimit(0, static_cast<int>(WaveType::Noise),
+                                                 static_cast<int>(params.mod3Wave->load())) : 0;
+    bool  mod3KB         = params.mod3KB ? params.mod3KB->load() > 0.5f : true;
+    float mod3LevelP     = (params.mod3Level ? params.mod3Level->load() : 0.0f) * plasmaMul;
+    int   mod3CoarseIdx  = params.mod3Coarse
+        ? juce::jlimit(0, kMaxCoarseIdx, static_cast<int>(params.mod3Coarse->load())) : 1;
+    float mod3FineCents  = params.mod3Fine ? params.mod3Fine->load() : 0.0f;
+    float mod3FixedHz    = params.mod3FixedFreq ? params.mod3FixedFreq->load() : 440.0f;
+    int   mod3MultiVal   = params.mod3Multi ? static_cast<int>(params.mod3Multi->load()) : 4;
+    float mod3Feedback   = params.mod3Feedback ? params.mod3Feedback->load() : 0.0f;
+
     auto carWaveIdx      = static_cast<int>(params.carWave->load());
     int   carCoarseIdx   = params.carCoarse
         ? juce::jlimit(0, kMaxCoarseIdx,
@@ -258,81 +489,36 @@ void FMVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer,
     float carFixedHz     = params.carFixedFreq ? params.carFixedFreq->load() : 440.0f;
     int   carMultiVal    = params.carMulti ? static_cast<int>(params.carMulti->load()) : 4;
     bool  carKB          = params.carKB ? params.carKB->load() > 0.5f : true;
-    float carNoiseP      = params.carNoise ? params.carNoise->load() : 0.0f;
-    float carSpreadP     = params.carSpread ? params.carSpread->load() : 0.0f;
-
-    float tremorAmount = juce::jlimit(0.0f, 1.0f, params.tremor->load()
-                         + params.lfoModTremor.load(std::memory_order_relaxed));
-    float veinAmount   = juce::jlimit(0.0f, 1.0f, params.vein->load()
-                         + params.lfoModVein.load(std::memory_order_relaxed));
-    float fluxAmount   = juce::jlimit(0.0f, 1.0f, params.flux->load()
-                         + params.lfoModFlux.load(std::memory_order_relaxed));
+    int   unisonVoices   = params.unison
+        ? juce::jlimit(1, UnisonStack::kMaxVoices, static_cast<int>(params.unison->load())) : 1;
 
     // Global LFO modulation sums (from PluginProcessor) — all smoothed so
-    // their per-sample contribution is continuous. We read the atomic once
-    // per block and set the smoothing target; the per-sample loop pulls
-    // .getNextValue() to get a ramped value.
-    smoothGLfoPitch.setTargetValue(params.lfoModPitch.load(std::memory_order_relaxed));
-    smoothGLfoCutoff.setTargetValue(params.lfoModCutoff.load(std::memory_order_relaxed));
-    smoothGLfoRes.setTargetValue(params.lfoModRes.load(std::memory_order_relaxed));
-    smoothGLfoMod1Lvl.setTargetValue(params.lfoModMod1Lvl.load(std::memory_order_relaxed));
-    smoothGLfoMod2Lvl.setTargetValue(params.lfoModMod2Lvl.load(std::memory_order_relaxed));
-    smoothGLfoVolume.setTargetValue(params.lfoModVolume.load(std::memory_order_relaxed));
-    smoothGLfoDrive.setTargetValue(params.lfoModDrive.load(std::memory_order_relaxed));
-    smoothGLfoNoise.setTargetValue(params.lfoModNoise.load(std::memory_order_relaxed));
-    smoothGLfoSpread.setTargetValue(params.lfoModSpread.load(std::memory_order_relaxed));
-    smoothGLfoFold.setTargetValue(params.lfoModFold.load(std::memory_order_relaxed));
-    // HemoFold's setAmount is per-block only, so we sample a scalar for the
-    // fold amount this block. SmoothedValue::getCurrentValue() does NOT
-    // advance the ramp — only getNextValue() (per-sample) and skip(N) do —
-    // so we step it explicitly by the block size before reading. Without
-    // this the smoother stays stuck at 0 and the LFO never reaches the
-    // target value, which is why mapping an LFO onto Fold appeared inert.
-    smoothGLfoFold.skip(numSamples);
-    const float gLfoModFoldBlock = smoothGLfoFold.getCurrentValue();
-
-    bool xorEnabled    = params.xorOn->load() > 0.5f;
-    bool syncEnabled   = params.syncOn->load() > 0.5f;
-    int  fmAlgo        = static_cast<int>(params.fmAlgo->load());
+    // their per-sample contribution is continuous. Read once per block
+    // here; each voice sets them as its smoothing targets.
+    lfoPitch   = params.lfoModPitch.load(std::memory_order_relaxed);
+    lfoCutoff  = params.lfoModCutoff.load(std::memory_order_relaxed);
+    lfoRes     = params.lfoModRes.load(std::memory_order_relaxed);
+    lfoMod1Lvl = params.lfoModMod1Lvl.load(std::memory_order_relaxed);
+    lfoMod2Lvl = params.lfoModMod2Lvl.load(std::memory_order_relaxed);
+    lfoVolume  = params.lfoModVolume.load(std::memory_order_relaxed);
+    lfoDrive   = params.lfoModDrive.load(std::memory_order_relaxed);
+    lfoNoise   = params.lfoModNoise.load(std::memory_order_relaxed);
+    lfoSpread  = params.lfoModSpread.load(std::memory_order_relaxed);
+    lfoFold    = params.lfoModFold.load(std::memory_order_relaxed);
 
     bool pitchEnvEnabled = params.pitchEnvOn->load() > 0.5f;
-    float pitchEnvAmt  = pitchEnvEnabled
-        ? juce::jlimit(-96.0f, 96.0f, params.pitchEnvAmt->load()
-              + params.lfoModPEnvAmt.load(std::memory_order_relaxed) * 96.0f)
-        : 0.0f;
-
-    bool filtEnabled   = params.filtOn->load() > 0.5f;
-    float cutoffBase   = params.filtCutoff->load();
-    float resonance    = params.filtRes->load();
-    auto filterMode    = static_cast<FilterMode>(juce::jlimit(0, 3, static_cast<int>(params.filtType->load())));
-    float volumeParam  = params.volume->load();
-    float driveParam   = params.drive->load();
-    float dispAmount   = params.dispAmt->load();
-    float driftParam   = juce::jlimit(0.0f, 1.0f,
-                           (params.carDrift ? params.carDrift->load() : 0.0f)
-                           + params.lfoModCarDrift.load(std::memory_order_relaxed));
-
-    // Wire harmonic tables to oscillators (for Custom waveform)
-    mod1Osc.setHarmonicTable(params.mod1Harmonics);
-    mod2Osc.setHarmonicTable(params.mod2Harmonics);
-    carrierOsc.setHarmonicTable(params.carHarmonics);
-    carrierOscR.setHarmonicTable(params.carHarmonics);
-
-    // Configurer les oscillateurs
-    mod1Osc.setWaveType(static_cast<WaveType>(mod1WaveIdx));
-    mod2Osc.setWaveType(static_cast<WaveType>(mod2WaveIdx));
-    carrierOsc.setWaveType(static_cast<WaveType>(carWaveIdx));
-    carrierOscR.setWaveType(static_cast<WaveType>(carWaveIdx));
-
-    // SmoothedValues : targets pour ce bloc
-    smoothVolume.setTargetValue(volumeParam);
-    smoothCutoff.setTargetValue(cutoffBase);
-    smoothMod1Level.setTargetValue(mod1LevelP);
-    smoothMod2Level.setTargetValue(mod2LevelP);
-    smoothCarNoise.setTargetValue(carNoiseP);
-    smoothCarSpread.setTargetValue(carSpreadP);
-    smoothDrive.setTargetValue(driveParam);
-    smoothFold.setTargetValue(dispAmount);
+    int  fmAlgo          = static_cast<int>(params.fmAlgo->load());
+
+    // Smoothers : targets pour ce bloc
+    volume    = params.volume->load();
+    cutoff    = params.filtCutoff->load();
+    mod1Level = mod1LevelP;
+    mod2Level = mod2LevelP;
+    mod3Level = mod3LevelP;
+    carNoise  = params.carNoise ? params.carNoise->load() : 0.0f;
+    carSpread = params.carSpread ? params.carSpread->load() : 0.0f;
+    drive     = params.drive->load();
+    fold      = params.dispAmt->load();
 
     // Envelope time macro: 0.5 = 1x, 0 = 0.25x, 1 = 4x (exponential).
     // LFO mod is additive in the unit-interval knob space, so a ±1 LFO
@@ -343,49 +529,29 @@ void FMVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer,
         + params.lfoModMacroTime.load(std::memory_order_relaxed));
     float timeMul = std::pow(4.0f, macroTimePos * 2.0f - 1.0f);
 
-    // Mettre à jour les paramètres d'enveloppe (+ LFO modulation + time macro).
-    // Skip the JUCE ADSR recompute when nothing changed since last block.
-    auto pushIfChanged = [](auto& env, AdsrCache& cache,
-                             float a, float d, float s, float r)
-    {
-        constexpr float eps = 1e-4f;
-        if (std::abs(a - cache.a) > eps || std::abs(d - cache.d) > eps
-            || std::abs(s - cache.s) > eps || std::abs(r - cache.r) > eps)
-        {
-            env.setParameters(a, d, s, r);
-            cache.a = a; cache.d = d; cache.s = s; cache.r = r;
-        }
-    };
-
-    pushIfChanged(env1, lastEnv1,
-        std::max(0.0f, (params.env1A->load() + params.lfoModEnv1A.load(std::memory_order_relaxed) * 5.0f) * timeMul),
-        std::max(0.0f, (params.env1D->load() + params.lfoModEnv1D.load(std::memory_order_relaxed) * 5.0f) * timeMul),
-        juce::jlimit(0.0f, 1.0f, params.env1S->load() + params.lfoModEnv1S.load(std::memory_order_relaxed)),
-        std::max(0.0f, (params.env1R->load() + params.lfoModEnv1R.load(std::memory_order_relaxed) * 8.0f) * timeMul));
-    pushIfChanged(env2, lastEnv2,
-        std::max(0.0f, (params.env2A->load() + params.lfoModEnv2A.load(std::memory_order_relaxed) * 5.0f) * timeMul),
-        std::max(0.0f, (params.env2D->load() + params.lfoModEnv2D.load(std::memory_order_relaxed) * 5.0f) * timeMul),
-        juce::jlimit(0.0f, 1.0f, params.env2S->load() + params.lfoModEnv2S.load(std::memory_order_relaxed)),
-        std::max(0.0f, (params.env2R->load() + params.lfoModEnv2R.load(std::memory_order_relaxed) * 8.0f) * timeMul));
-    pushIfChanged(env3, lastEnv3,
-        std::max(0.0f, (params.env3A->load() + params.lfoModEnv3A.load(std::memory_order_relaxed) * 5.0f) * timeMul),
-        std::max(0.0f, (params.env3D->load() + params.lfoModEnv3D.load(std::memory_order_relaxed) * 5.0f) * timeMul),
-        juce::jlimit(0.0f, 1.0f, params.env3S->load() + params.lfoModEnv3S.load(std::memory_order_relaxed)),
-        std::max(0.0f, (params.env3R->load() + params.lfoModEnv3R.load(std::memory_order_relaxed) * 8.0f) * timeMul));
-    pushIfChanged(pitchEnv, lastPitchEnv,
-        std::max(0.0f, (params.pitchEnvA->load() + params.lfoModPEnvA.load(std::memory_order_relaxed) * 5.0f) * timeMul),
-        std::max(0.0f, (params.pitchEnvD->load() + params.lfoModPEnvD.load(std::memory_order_relaxed) * 5.0f) * timeMul),
-        juce::jlimit(0.0f, 1.0f, params.pitchEnvS->load() + params.lfoModPEnvS.load(std::memory_order_relaxed)),
-        std::max(0.0f, (params.pitchEnvR->load() + params.lfoModPEnvR.load(std::memory_order_relaxed) * 8.0f) * timeMul));
-
-    // HemoFold (wavefolder) + global LFO fold mod
-    float foldAmt = juce::jlimit(0.0f, 1.0f, dispAmount + gLfoModFoldBlock);
-    hemoFoldL.setAmount(foldAmt);
-    hemoFoldR.setAmount(foldAmt);
-
-    // XOR mask
-    uint16_t xorMask = xorEnabled ? 0x5A5A : 0x0000;
-    xorDist.setMask(xorMask);
+    // Paramètres d'enveloppe (+ LFO modulation + time macro)
+    env1 = { std::max(0.0f, (params.env1A->load() + params.lfoModEnv1A.load(std::memory_order_relaxed) * 5.0f) * timeMul),
+             std::max(0.0f, (params.env1D->load() + params.lfoModEnv1D.load(std::memory_order_relaxed) * 5.0f) * timeMul),
+             juce::jlimit(0.0f, 1.0f, params.env1S->load() + params.lfoModEnv1S.load(std::memory_order_relaxed)),
+             std::max(0.0f, (params.env1R->load() + params.lfoModEnv1R.load(std::memory_order_relaxed) * 8.0f) * timeMul) };
+    env2 = { std::max(0.0f, (params.env2A->load() + params.lfoModEnv2A.load(std::memory_order_relaxed) * 5.0f) * timeMul),
+             std::max(0.0f, (params.env2D->load() + params.lfoModEnv2D.load(std::memory_order_relaxed) * 5.0f) * timeMul),
+             juce::jlimit(0.0f, 1.0f, params.env2S->load() + params.lfoModEnv2S.load(std::memory_order_relaxed)),
+             std::max(0.0f, (params.env2R->load() + params.lfoModEnv2R.load(std::memory_order_relaxed) * 8.0f) * timeMul) };
+    env3 = { std::max(0.0f, (params.env3A->load() + params.lfoModEnv3A.load(std::memory_order_relaxed) * 5.0f) * timeMul),
+             std::max(0.0f, (params.env3D->load() + params.lfoModEnv3D.load(std::memory_order_relaxed) * 5.0f) * timeMul),
+             juce::jlimit(0.0f, 1.0f, params.env3S->load() + params.lfoModEnv3S.load(std::memory_order_relaxed)),
+             std::max(0.0f, (params.env3R->load() + params.lfoModEnv3R.load(std::memory_order_relaxed) * 8.0f) * timeMul) };
+    pitchEnv = { std::max(0.0f, (params.pitchEnvA->load() + params.lfoModPEnvA.load(std::memory_order_relaxed) * 5.0f) * timeMul),
+                 std::max(0.0f, (params.pitchEnvD->load() + params.lfoModPEnvD.load(std::memory_order_relaxed) * 5.0f) * timeMul),
+                 juce::jlimit(0.0f, 1.0f, params.pitchEnvS->load() + params.lfoModPEnvS.load(std::memory_order_relaxed)),
+                 std::max(0.0f, (params.pitchEnvR->load() + params.lfoModPEnvR.load(std::memory_order_relaxed) * 8.0f) * timeMul) };
+    hasEnv4 = params.env4A != nullptr;
+    if (hasEnv4)
+        env4 = { std::max(0.0f, params.env4A->load() * timeMul),
+                 std::max(0.0f, params.env4D->load() * timeMul),
+                 juce::jlimit(0.0f, 1.0f, params.env4S->load()),
+                 std::max(0.0f, params.env4R->load() * timeMul) };
 
     // Pre-compute block-rate ratios (saves 3× exp2 + 3× pow per sample)
     // For KB-track mode: ratio includes vortex, helix and fine shift.
@@ -405,294 +571,1266 @@ void FMVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer,
             return static_cast<double>(fixedFreqHz) * static_cast<double>(multiValue(multi));
         }
     };
-    double mod1Ratio = precomputeRatio(mod1CoarseIdx, mod1FineCents, mod1KB, mod1FixedHz, mod1MultiVal);
-    double mod2Ratio = precomputeRatio(mod2CoarseIdx, mod2FineCents, mod2KB, mod2FixedHz, mod2MultiVal);
-    double carRatio  = precomputeRatio(carCoarseIdx,  carFineCents,  carKB,  carFixedHz,  carMultiVal);
 
-    // Detuning: linear approximation of exp2(x) for |x| < 0.013 (max error < 0.01%)
-    constexpr double kDetuneScale = 15.0 / 1200.0 * 0.693147180559945; // 15 cents × ln(2)
+    auto& b = setup;
+    b.mod1Ratio = precomputeRatio(mod1CoarseIdx, mod1FineCents, mod1KB, mod1FixedHz, mod1MultiVal);
+    b.mod2Ratio = precomputeRatio(mod2CoarseIdx, mod2FineCents, mod2KB, mod2FixedHz, mod2MultiVal);
+    b.carRatio  = precomputeRatio(carCoarseIdx,  carFineCents,  carKB,  carFixedHz,  carMultiVal);
+    b.mod1KB = mod1KB;
+    b.mod2KB = mod2KB;
+    b.carKB  = carKB;
+    b.opMatrix = opMatrix;
+    b.opAlgo   = opAlgo;
+    b.mod3Ratio = precomputeRatio(mod3CoarseIdx, mod3FineCents, mod3KB, mod3FixedHz, mod3MultiVal);
+    b.mod3KB   = mod3KB;
+    b.mod3Feedback = juce::jlimit(0.0f, 1.0f, mod3Feedback);
+    b.mod3Wave = static_cast<WaveType>(mod3WaveIdx);
+    // Algo hors plage → Series (comme l'ancien "default" du switch)
+    b.fmAlgo = (fmAlgo >= 0 && fmAlgo < FMVoice::KernelTables::kNumAlgos) ? fmAlgo : 0;
+    b.mixAudio = opMatrix ? opgraph::kRoutes[static_cast<std::size_t>(opAlgo)].out != 0
+                          : b.fmAlgo == 5;
+    b.xorEnabled  = params.xorOn->load() > 0.5f;
+    b.syncEnabled = params.syncOn->load() > 0.5f;
+    b.filtEnabled = params.filtOn->load() > 0.5f;
+    b.pitchEnvEnabled = pitchEnvEnabled;
+    b.pitchEnvAmt  = pitchEnvEnabled
+        ? juce::jlimit(-96.0f, 96.0f, params.pitchEnvAmt->load()
+              + params.lfoModPEnvAmt.load(std::memory_order_relaxed) * 96.0f)
+        : 0.0f;
+    b.tremorAmount = juce::jlimit(0.0f, 1.0f, params.tremor->load()
+                     + params.lfoModTremor.load(std::memory_order_relaxed));
+    b.veinAmount   = juce::jlimit(0.0f, 1.0f, params.vein->load()
+                     + params.lfoModVein.load(std::memory_order_relaxed));
+    b.fluxAmount   = juce::jlimit(0.0f, 1.0f, params.flux->load()
+                     + params.lfoModFlux.load(std::memory_order_relaxed));
+    b.resonance    = params.filtRes->load();
+    b.filterMode   = static_cast<FilterMode>(juce::jlimit(0, 3, static_cast<int>(params.filtType->load())));
+    b.driftParam   = juce::jlimit(0.0f, 1.0f,
+                       (params.carDrift ? params.carDrift->load() : 0.0f)
+                       + params.lfoModCarDrift.load(std::memory_order_relaxed));
+    b.vBias = vBias;
+    b.vTrim = vTrim;
+    b.velSwap    = params.velSwap.load(std::memory_order_relaxed);
+    b.expression = params.expression.load(std::memory_order_relaxed);
+    b.mod1Wave = static_cast<WaveType>(mod1WaveIdx);
+    b.mod2Wave = static_cast<WaveType>(mod2WaveIdx);
+    b.carWave  = static_cast<WaveType>(carWaveIdx);
+    // Unison : pas de phase à dupliquer pour le bruit, carriers habituels
+    b.unisonVoices = b.carWave == WaveType::Noise ? 1 : unisonVoices;
+    b.unisonDetune = params.unisonDetune ? params.unisonDetune->load() : 0.0f;
+    b.unisonBlend  = params.unisonBlend ? params.unisonBlend->load() : 1.0f;
+    b.unisonWidth  = params.unisonWidth ? params.unisonWidth->load() : 0.0f;
+
+    // Anti-aliasing par primitive (fold + drive)
+    b.antialias = params.antialias != nullptr && params.antialias->load() > 0.5f;
+
+    // Résolution de modulation : par échantillon en rendu offline / HQ
+    b.modStep = 1;
+    if (params.modRate != nullptr && !params.hqRender.load(std::memory_order_relaxed))
+        b.modStep = FMVoice::kModRateSteps[juce::jlimit(0, FMVoice::kNumModRates - 1,
+                                                        static_cast<int>(params.modRate->load()))];
+
+    // Suréchantillonnage demandé (1×/2×/4×)
+    osFactor = 1;
+    if (params.oversampling != nullptr)
+        osFactor = 1 << juce::jlimit(0, 2, static_cast<int>(params.oversampling->load()));
+}
+
+void FMVoice::beginBlock(int numSamples)
+{
+    blockPeakLevel = 0.0f;
+
+    // Instantané du bloc : partagé par toutes les voix, sinon lu ici
+    if (sharedBlockParams == nullptr)
+        ownBlockParams.capture(params);
+    const VoiceBlockParams& p = sharedBlockParams != nullptr ? *sharedBlockParams : ownBlockParams;
+
+    // Sommes des LFOs globaux : lissées par voix, rampes rendues par le
+    // noyau de contrôle
+    auto& sm = hot.smoothers;
+    sm.setTargetValue(SmoothGLfoPitch, p.lfoPitch);
+    sm.setTargetValue(SmoothGLfoCutoff, p.lfoCutoff);
+    sm.setTargetValue(SmoothGLfoRes, p.lfoRes);
+    sm.setTargetValue(SmoothGLfoMod1Lvl, p.lfoMod1Lvl);
+    sm.setTargetValue(SmoothGLfoMod2Lvl, p.lfoMod2Lvl);
+    sm.setTargetValue(SmoothGLfoVolume, p.lfoVolume);
+    sm.setTargetValue(SmoothGLfoDrive, p.lfoDrive);
+    sm.setTargetValue(SmoothGLfoNoise, p.lfoNoise);
+    sm.setTargetValue(SmoothGLfoSpread, p.lfoSpread);
+    sm.setTargetValue(SmoothGLfoFold, p.lfoFold);
+    // HemoFold's setAmount is per-block only, so we sample a scalar for the
+    // fold amount this block. getCurrentValue() does NOT advance the ramp —
+    // only the kernel's render() and skip(N) do, and the kernel leaves the
+    // fold smoothers alone — so we step it explicitly by the block size
+    // before reading. Without this the smoother stays stuck at 0 and the
+    // LFO never reaches the target value.
+    const float gLfoModFoldBlock = sm.skip(SmoothGLfoFold, numSamples);
+
+    // Smoothers : targets pour ce bloc
+    sm.setTargetValue(SmoothVolume, p.volume);
+    sm.setTargetValue(SmoothCutoff, p.cutoff);
+    sm.setTargetValue(SmoothMod1Level, p.mod1Level);
+    sm.setTargetValue(SmoothMod2Level, p.mod2Level);
+    sm.setTargetValue(SmoothMod3Level, p.mod3Level);
+    sm.setTargetValue(SmoothCarNoise, p.carNoise);
+    sm.setTargetValue(SmoothCarSpread, p.carSpread);
+    sm.setTargetValue(SmoothDrive, p.drive);
+    sm.setTargetValue(SmoothFold, p.fold);
+
+    // HemoFold (wavefolder) + global LFO fold mod
+    float foldAmt = juce::jlimit(0.0f, 1.0f, p.fold + gLfoModFoldBlock);
+    hot.hemoFoldL.setAmount(foldAmt);
+    hot.hemoFoldR.setAmount(foldAmt);
+
+    // Le reste ne dépend que de l'instantané : rien à refaire tant qu'il
+    // n'a pas été recapturé
+    if (p.serial == appliedSerial)
+        return;
+    appliedSerial = p.serial;
+    block = p.setup;
+    const auto& b = block;
+
+    // Wire harmonic tables to oscillators (for Custom waveform)
+    hot.mod1Osc.setHarmonicTable(params.mod1Harmonics);
+    hot.mod2Osc.setHarmonicTable(params.mod2Harmonics);
+    hot.carrierOsc.setHarmonicTable(params.carHarmonics);
+    hot.carrierOscR.setHarmonicTable(params.carHarmonics);
+    unisonStack.setHarmonicTable(params.carHarmonics);
+
+    // Configurer les oscillateurs
+    hot.mod1Osc.setWaveType(b.mod1Wave);
+    hot.mod2Osc.setWaveType(b.mod2Wave);
+    mod3.osc.setWaveType(b.mod3Wave);
+    hot.carrierOsc.setWaveType(b.carWave);
+    hot.carrierOscR.setWaveType(b.carWave);
+    unisonStack.setWaveType(b.carWave);
+
+    // Mettre à jour les paramètres d'enveloppe.
+    // Skip the JUCE ADSR recompute when nothing changed since last capture.
+    auto pushIfChanged = [](auto& env, AdsrCache& cache, const VoiceBlockParams::Adsr& adsr)
+    {
+        constexpr float eps = 1e-4f;
+        if (std::abs(adsr.a - cache.a) > eps || std::abs(adsr.d - cache.d) > eps
+            || std::abs(adsr.s - cache.s) > eps || std::abs(adsr.r - cache.r) > eps)
+        {
+            env.setParameters(adsr.a, adsr.d, adsr.s, adsr.r);
+            cache.a = adsr.a; cache.d = adsr.d; cache.s = adsr.s; cache.r = adsr.r;
+        }
+    };
+
+    pushIfChanged(hot.env1, lastEnv1, p.env1);
+    pushIfChanged(hot.env2, lastEnv2, p.env2);
+    pushIfChanged(hot.env3, lastEnv3, p.env3);
+    pushIfChanged(hot.pitchEnv, lastPitchEnv, p.pitchEnv);
+    if (p.hasEnv4)
+        pushIfChanged(mod3.env, lastEnv4, p.env4);
+
+    hot.hemoFoldL.setAntialias(b.antialias);
+    hot.hemoFoldR.setAntialias(b.antialias);
+
+    // XOR mask
+    uint16_t xorMask = b.xorEnabled ? 0x5A5A : 0x0000;
+    hot.xorDist.setMask(xorMask);
+
+    if (b.unisonVoices > 1)
+        unisonStack.setup(b.unisonVoices, b.unisonDetune, b.unisonBlend, b.unisonWidth);
+
+    hot.carrierOsc.setDrift(b.driftParam);
+    hot.carrierOscR.setDrift(b.driftParam);
+    hot.carrierOsc.setDriftStep(b.modStep);
+    hot.carrierOscR.setDriftStep(b.modStep);
+
+    if (p.osFactor != osFactor)
+        setOversampling(p.osFactor);
+    const int osIndex = KernelTables::oversamplingIndex(osFactor);
+
+    controlKernel = KernelTables::control[(b.pitchEnvEnabled ? 2 : 0) + (b.filtEnabled ? 1 : 0)];
+    const auto& carriers = b.unisonVoices > 1 ? KernelTables::unisonCarrier : KernelTables::carrier;
+    carrierKernel = carriers[static_cast<std::size_t>(osIndex * 2 + (b.syncEnabled ? 1 : 0))];
+    postChainOffset = osIndex * 32;
+}
+
+template <typename T, typename Eval>
+void FMVoice::evalAtControlRate(T* out, int numSamples, int step, Eval&& eval) noexcept
+{
+    if (step <= 1)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            out[i] = eval(i);
+        return;
+    }
+
+    const int last = numSamples - 1;
+    int a = 0;
+    out[0] = eval(0);
+    while (a < last)
+    {
+        const int b = std::min(a + step, last);
+        out[b] = eval(b);
+        const T delta = (out[b] - out[a]) / static_cast<T>(b - a);
+        for (int i = a + 1; i < b; ++i)
+            out[i] = out[a] + delta * static_cast<T>(i - a);
+        a = b;
+    }
+}
+
+template <bool PitchEnv, bool Filt>
+void FMVoice::renderControlKernel(int numSamples)
+{
+    const auto& b = block;
+    auto& c = ctrl;
+
+    // Rampes des smoothers pour le sous-bloc. Fold et GLfoFold ne sont lus
+    // qu'au bloc (beginBlock) ; les smoothers propres au filtre et au mode
+    // 4 opérateurs n'avancent que s'ils servent, comme avant le banc.
+    uint32_t which = SmootherBank<kNumSmoothers>::kAll & ~(smootherBit(SmoothFold) | smootherBit(SmoothGLfoFold));
+    if constexpr (!Filt)
+        which &= ~(smootherBit(SmoothGLfoCutoff) | smootherBit(SmoothGLfoRes));
+    if (!b.opMatrix)
+        which &= ~smootherBit(SmoothMod3Level);
+
+    float ramp[kNumSmoothers][kControlBlock];
+    const uint32_t moving = hot.smoothers.render(ramp, numSamples, which);
+
+    // Paramètre lissé combiné : une constante du sous-bloc si ses smoothers
+    // sont stables (le cas courant), sinon calculé échantillon par échantillon
+    auto smoothed = [&](float* dst, uint32_t used, auto&& fn)
+    {
+        if ((moving & used) == 0)
+        {
+            std::fill(dst, dst + numSamples, fn(0));
+            return;
+        }
+        for (int i = 0; i < numSamples; ++i)
+            dst[i] = fn(i);
+    };
+
+    // Smooth parameters + apply global LFO modulations
+    smoothed(c.vol, smootherBit(SmoothVolume) | smootherBit(SmoothGLfoVolume), [&](int i)
+        { return juce::jlimit(0.0f, 1.0f, ramp[SmoothVolume][i] + ramp[SmoothGLfoVolume][i]) * b.vBias; });
+    smoothed(c.m1Level, smootherBit(SmoothMod1Level) | smootherBit(SmoothGLfoMod1Lvl), [&](int i)
+        { return std::max(0.0f, ramp[SmoothMod1Level][i] + ramp[SmoothGLfoMod1Lvl][i]); });
+    smoothed(c.m2Level, smootherBit(SmoothMod2Level) | smootherBit(SmoothGLfoMod2Lvl), [&](int i)
+        { return std::max(0.0f, ramp[SmoothMod2Level][i] + ramp[SmoothGLfoMod2Lvl][i]); });
+    // Stereo spread, carrier noise mix (+ global LFO)
+    smoothed(c.spread, smootherBit(SmoothCarSpread) | smootherBit(SmoothGLfoSpread), [&](int i)
+        { return juce::jlimit(0.0f, 1.0f, ramp[SmoothCarSpread][i] + ramp[SmoothGLfoSpread][i]); });
+    smoothed(c.noiseMix, smootherBit(SmoothCarNoise) | smootherBit(SmoothGLfoNoise), [&](int i)
+        { return juce::jlimit(0.0f, 1.0f, ramp[SmoothCarNoise][i] + ramp[SmoothGLfoNoise][i]); });
+    smoothed(c.drive, smootherBit(SmoothDrive) | smootherBit(SmoothGLfoDrive), [&](int i)
+        { return juce::jlimit(1.0f, 10.0f, ramp[SmoothDrive][i] + ramp[SmoothGLfoDrive][i] * 9.0f); });
+    if constexpr (Filt)
+        smoothed(c.res, smootherBit(SmoothGLfoRes), [&](int i)
+            { return juce::jlimit(0.0f, 1.0f, b.resonance + ramp[SmoothGLfoRes][i]); });
+    if (b.opMatrix)
+        smoothed(c.m3Level, smootherBit(SmoothMod3Level), [&](int i)
+            { return std::max(0.0f, ramp[SmoothMod3Level][i]); });
+
+    // Gain de vélocité : constant sur le bloc (instantané de paramètres)
+    std::fill(c.velGain, c.velGain + numSamples,
+              (b.velSwap ? 1.0f : hot.noteVelocity) * b.vTrim * b.expression);
+
+    // Arguments des fonctions transcendantes, résolus après la boucle au
+    // rythme de modulation (b.modStep)
+    double pitchSemis[kControlBlock];
+    float  lfo2Arg[kControlBlock];
+    const float* gLfoPitch = ramp[SmoothGLfoPitch];
+
+    // LFOs free-running, rendus d'un bloc (quadrature) : LFO1 pour tremor
+    // (pitch) et flux (mod index), LFO2 pour vein (filtre seulement)
+    float lfo1Val[kControlBlock];
+    hot.lfo1.renderBlock(lfo1Val, numSamples, quadrature.lfo1);
+    if constexpr (Filt)
+        hot.lfo2.renderBlock(lfo2Arg, numSamples, quadrature.lfo2);
+    else
+        hot.lfo2.advance(numSamples);
 
-    // --- Boucle par échantillon ---
     for (int i = 0; i < numSamples; ++i)
     {
         // Portamento
-        if (portamentoRate > 0.0)
-            currentFreq += (targetNoteFreq - currentFreq) * (1.0 - portamentoRate);
+        if (hot.portamentoRate > 0.0)
+            hot.currentFreq += (hot.targetNoteFreq - hot.currentFreq) * (1.0 - hot.portamentoRate);
         else
-            currentFreq = targetNoteFreq;
-
-        // LFO ticks (free-running)
-        float lfo1Val = lfo1.tick(); // pour tremor (pitch) et flux (mod index)
-        float lfo2Val = lfo2.tick(); // pour vein (filter)
+            hot.currentFreq = hot.targetNoteFreq;
 
         // Pitch envelope : amount × env value (en demi-tons)
-        float pitchEnvVal = pitchEnv.tick();
-        double pitchEnvSemitones = pitchEnvEnabled
-            ? static_cast<double>(pitchEnvAmt * pitchEnvVal) : 0.0;
+        // (l'enveloppe avance même désactivée pour rester en phase avec la note)
+        float pitchEnvVal = hot.pitchEnv.tick();
+        double pitchEnvSemitones = PitchEnv
+            ? static_cast<double>(b.pitchEnvAmt * pitchEnvVal) : 0.0;
 
         // Pitch modulation via LFO "tremor" : ±2 semitones max + global LFO pitch (smoothed)
-        float gLfoPitchSmoothed = smoothGLfoPitch.getNextValue();
-        double pitchModSemitones = static_cast<double>(lfo1Val * tremorAmount) * 2.0
-                                   + static_cast<double>(gLfoPitchSmoothed) * 2.0
-                                   + pitchBendSemitones + pitchEnvSemitones;
-        pitchModSemitones = juce::jlimit(-48.0, 48.0, pitchModSemitones);
-        double pitchMod = std::exp2(pitchModSemitones / 12.0);
+        double pitchModSemitones = static_cast<double>(lfo1Val[i] * b.tremorAmount) * 2.0
+                                   + static_cast<double>(gLfoPitch[i]) * 2.0
+                                   + hot.pitchBendSemitones + pitchEnvSemitones;
+        pitchSemis[i] = juce::jlimit(-48.0, 48.0, pitchModSemitones);
 
-        double baseFreq = currentFreq * pitchMod;
+        c.baseFreq[i] = hot.currentFreq; // × pitchMod après la boucle
 
         // Modulation index modulation via LFO "flux"
-        float fluxMod = 1.0f + fluxAmount * lfo1Val;
-
-        // Smooth parameters + apply global LFO modulations
-        float vol      = juce::jlimit(0.0f, 1.0f, smoothVolume.getNextValue() + smoothGLfoVolume.getNextValue()) * vBias;
-        float cutoff   = smoothCutoff.getNextValue();
-        float m1Level  = std::max(0.0f, smoothMod1Level.getNextValue() + smoothGLfoMod1Lvl.getNextValue());
-        float m2Level  = std::max(0.0f, smoothMod2Level.getNextValue() + smoothGLfoMod2Lvl.getNextValue());
-
-        // --- Modulateur 1 --- (use pre-computed ratio: baseFreq × ratio or absolute)
-        double mod1Freq = mod1KB ? baseFreq * mod1Ratio : mod1Ratio;
-        mod1Osc.setFrequency(mod1Freq);
-        float mod1Out = mod1Osc.tick();
-        float env1Val = env1.tick();
-        double mod1Signal = static_cast<double>(mod1Out * env1Val * m1Level * fluxMod)
-                            * kMaxModIndex;
+        c.fluxMod[i] = 1.0f + b.fluxAmount * lfo1Val[i];
+
+        c.env1[i] = hot.env1.tick();
+        c.env2[i] = hot.env2.tick();
+        c.env3[i] = hot.env3.tick();
+    }
+
+    // Quatrième opérateur : seulement en mode 4 opérateurs
+    if (b.opMatrix)
+        for (int i = 0; i < numSamples; ++i)
+            c.env4[i] = mod3.env.tick();
+
+    // Niveau suivi : borne de l'amplitude de sortie (tanh(x·drive) ≤ x·drive)
+    const unsigned audioOps = b.opMatrix ? opgraph::kRoutes[static_cast<std::size_t>(b.opAlgo)].out : 0u;
+    float level = 0.0f;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        float amp = c.env3[i];
+        if (b.opMatrix)
+        {
+            if (audioOps & opgraph::bit(1)) amp += c.env1[i] * c.m1Level[i];
+            if (audioOps & opgraph::bit(2)) amp += c.env2[i] * c.m2Level[i];
+            if (audioOps & opgraph::bit(3)) amp += c.env4[i] * c.m3Level[i];
+        }
+        else if (b.fmAlgo == 5)
+        {
+            amp += c.env1[i] * c.m1Level[i] + c.env2[i] * c.m2Level[i];
+        }
+        level = std::max(level, amp * c.velGain[i] * c.vol[i] * c.drive[i]);
+    }
+    trackedLevel = level;
+    blockPeakLevel = std::max(blockPeakLevel, level);
+
+    // --- Étage de modulation : transcendantes aux points de contrôle ---
+    double pitchMod[kControlBlock];
+    evalAtControlRate(pitchMod, numSamples, b.modStep,
+                      [&](int i) { return dspmath::exp2(pitchSemis[i] / 12.0); });
+    for (int i = 0; i < numSamples; ++i)
+        c.baseFreq[i] *= pitchMod[i];
+
+    if constexpr (Filt)
+    {
+        const float veinAmount = b.veinAmount;
+        const float* cutoffArg = ramp[SmoothCutoff];
+        const float* gLfoCutArg = ramp[SmoothGLfoCutoff];
+        auto cutoffAt = [&](int i)
+        {
+            // Vein modulation: multiplicative ±2 octaves
+            float veinMod = (veinAmount > 0.001f) ? dspmath::exp2(veinAmount * lfo2Arg[i] * 2.0f) : 1.0f;
+            // Global LFO: additive in normalized knob space (skew=0.23, centre=1kHz, Serum/Vital style)
+            // Forward: norm = ((hz-20)/19980)^skew  |  Inverse: hz = 20 + 19980 * norm^(1/skew)
+            constexpr float kCutSkew = 0.2299f;
+            constexpr float kCutInvSkew = 1.0f / kCutSkew; // ~4.35
+            float cutLin = juce::jlimit(0.0f, 1.0f, (cutoffArg[i] - 20.0f) / 19980.0f);
+            float cutNorm = dspmath::pow(cutLin, kCutSkew);
+            cutNorm = juce::jlimit(0.0f, 1.0f, cutNorm + gLfoCutArg[i]);
+            float modulatedCutoff = (20.0f + 19980.0f * dspmath::pow(cutNorm, kCutInvSkew)) * veinMod;
+            return juce::jlimit(20.0f, 20000.0f, modulatedCutoff);
+        };
+
+        // Cutoff, LFO global et vein stables : une seule évaluation
+        if ((moving & (smootherBit(SmoothCutoff) | smootherBit(SmoothGLfoCutoff))) == 0 && veinAmount <= 0.001f)
+            std::fill(c.cutoffHz, c.cutoffHz + numSamples, cutoffAt(0));
+        else
+            evalAtControlRate(c.cutoffHz, numSamples, b.modStep, cutoffAt);
+    }
+}
+
+void FMVoice::cullIfInaudible() noexcept
+{
+    // Cache de notes : le rendu doit rester celui de la note enregistrée
+    if (blockPeakLevel >= kInaudibleLevel || cacheMode != CacheMode::Off || !isPlayingButReleased())
+        return;
+
+    hot.env1.reset();
+    hot.env2.reset();
+    hot.env3.reset();
+    hot.pitchEnv.reset();
+    mod3.env.reset();
+}
+
+void FMVoice::finishStealFade()
+{
+    hot.env1.reset();
+    hot.env2.reset();
+    hot.env3.reset();
+    hot.pitchEnv.reset();
+    mod3.env.reset();
+    clearCurrentNote();
+}
+
+// true si la valeur ne bouge pas sur le sous-bloc
+static bool isSteady(const double* x, int numSamples) noexcept
+{
+    bool steady = true;
+    for (int i = 1; i < numSamples; ++i)
+        steady &= (x[i] == x[0]);
+    return steady;
+}
+
+// true si au moins un échantillon a niveau ET enveloppe non nuls
+static bool anyAudible(const float* level, const float* env, int numSamples) noexcept
+{
+    bool audible = false;
+    for (int i = 0; i < numSamples; ++i)
+        audible |= (level[i] != 0.0f) & (env[i] != 0.0f);
+    return audible;
+}
+
+bool FMVoice::renderAudio(juce::AudioBuffer<float>& outputBuffer,
+                          int startSample, int numSamples)
+{
+    const int numValid = renderSamples(numSamples);
+
+    // --- Écrire dans le buffer de sortie (true stereo) ---
+    outputBuffer.addFrom(0, startSample, scratch.left, numValid);
+    if (outputBuffer.getNumChannels() >= 2)
+        outputBuffer.addFrom(1, startSample, scratch.right, numValid);
+
+    if (numValid < numSamples)
+    {
+        finishStealFade();
+        return false;
+    }
+    return true;
+}
+
+int FMVoice::renderSamples(int numSamples) noexcept
+{
+    const auto& b = block;
+    const auto& c = ctrl;
+
+    // Opérateurs muets : leur contribution serait ±0 sur tout le sous-bloc.
+    // En Feedback, la sortie de Mod2 nourrit son propre état → toujours rendu.
+    // Mode 4 opérateurs : un opérateur muet est élagué du graphe compilé.
+    const bool mod1Active = anyAudible(c.m1Level, c.env1, numSamples);
+    const bool mod2Active = (!b.opMatrix && b.fmAlgo == 4) || anyAudible(c.m2Level, c.env2, numSamples);
+
+    bool noiseActive = false;
+    for (int i = 0; i < numSamples; ++i)
+        noiseActive |= c.noiseMix[i] > 0.0001f;
+
+    ModulatorKernel modulators;
+    if (b.opMatrix)
+    {
+        const bool mod3Active = anyAudible(c.m3Level, c.env4, numSamples);
+        modulators = KernelTables::operators[static_cast<std::size_t>(
+            b.opAlgo * 8 + (mod3Active ? 4 : 0) + (mod2Active ? 2 : 0) + (mod1Active ? 1 : 0))];
+    }
+    else
+    {
+        modulators = KernelTables::modulators[static_cast<std::size_t>(
+            b.fmAlgo * 4 + (mod1Active ? 2 : 0) + (mod2Active ? 1 : 0))];
+    }
+    const auto postChain = KernelTables::postChain[static_cast<std::size_t>(
+          postChainOffset + (noiseActive ? 16 : 0) + (b.mixAudio ? 8 : 0) + (b.xorEnabled ? 4 : 0)
+        + (b.filtEnabled ? 2 : 0) + (hot.hemoFoldL.isActive() ? 1 : 0))];
+
+    renderFrequencies(numSamples);
+    (this->*modulators)(numSamples);
+    (this->*carrierKernel)(numSamples);
+    return (this->*postChain)(numSamples);
+}
+
+void FMVoice::renderFrequencies(int numSamples) noexcept
+{
+    const auto& b = block;
+    const auto& c = ctrl;
+    auto& s = scratch;
+
+    // Detuning: linear approximation of exp2(x) for |x| < 0.013 (max error < 0.01%)
+    constexpr double kDetuneScale = 15.0 / 1200.0 * 0.693147180559945; // 15 cents × ln(2)
+
+    // Use pre-computed ratios: baseFreq × ratio (KB track) or absolute
+    for (int i = 0; i < numSamples; ++i)
+    {
+        s.mod1Freq[i] = b.mod1KB ? c.baseFreq[i] * b.mod1Ratio : b.mod1Ratio;
+        s.mod2Freq[i] = b.mod2KB ? c.baseFreq[i] * b.mod2Ratio : b.mod2Ratio;
+        s.carFreq[i]  = b.carKB  ? c.baseFreq[i] * b.carRatio  : b.carRatio;
+        // Stereo spread: detune R carrier by up to ±15 cents (+ global LFO)
+        // Linear approximation of exp2(x) for small x: 1 + x * ln(2)
+        s.carFreqR[i] = s.carFreq[i] * (1.0 + static_cast<double>(c.spread[i]) * kDetuneScale);
+    }
+}
+
+template <int Algo, bool Mod1Active, bool Mod2Active>
+void FMVoice::renderModulators(int numSamples) noexcept
+{
+    auto& s = scratch;
+    const auto& c = ctrl;
+
+    // Modulateurs sans PM en entrée (Mod1 ; Mod2 en Parallel, Ring, Mix) :
+    // sinus pur à hauteur fixe sur le sous-bloc → rendus d'avance en
+    // quadrature, la boucle ne fait que lire
+    constexpr bool kMod2Free = Mod2Active && (Algo == 1 || Algo == 5 || (Algo == 3 && Mod1Active));
+    const bool mod1Quad = Mod1Active && hot.mod1Osc.isPlainSine() && isSteady(s.mod1Freq, numSamples);
+    const bool mod2Quad = kMod2Free && hot.mod2Osc.isPlainSine() && isSteady(s.mod2Freq, numSamples);
+    if (mod1Quad)
+    {
+        hot.mod1Osc.setFrequency(s.mod1Freq[0]);
+        hot.mod1Osc.renderUnmodulatedSine(s.mod1Sine, numSamples, quadrature.mod1,
+                                          block.syncEnabled ? s.syncFrac : nullptr);
+        if (!block.syncEnabled)
+            std::fill(s.syncFrac, s.syncFrac + numSamples, -1.0f);
+    }
+    if (mod2Quad)
+    {
+        hot.mod2Osc.setFrequency(s.mod2Freq[0]);
+        hot.mod2Osc.renderUnmodulatedSine(s.mod2Sine, numSamples, quadrature.mod2);
+    }
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float fluxMod = c.fluxMod[i];
+        const float m1Level = c.m1Level[i];
+        const float m2Level = c.m2Level[i];
+        const float env1Val = c.env1[i];
+        const float env2Val = c.env2[i];
+
+        // --- Modulateur 1 ---
+        float mod1Out = 0.0f;
+        double mod1Signal = 0.0;
+        if (mod1Quad)
+        {
+            mod1Out = s.mod1Sine[i];
+        }
+        else
+        {
+            hot.mod1Osc.setFrequency(s.mod1Freq[i]);
+            if constexpr (Mod1Active)
+                mod1Out = hot.mod1Osc.tick();
+            else
+                hot.mod1Osc.advance();
+            s.syncFrac[i] = hot.mod1Osc.hasSyncPulse() ? hot.mod1Osc.getSyncFraction() : -1.0f;
+        }
+        if constexpr (Mod1Active)
+            mod1Signal = static_cast<double>(mod1Out * env1Val * m1Level * fluxMod)
+                         * kMaxModIndex;
 
         // --- Modulateur 2 ---
-        double mod2Freq = mod2KB ? baseFreq * mod2Ratio : mod2Ratio;
-        mod2Osc.setFrequency(mod2Freq);
+        if (!mod2Quad)
+            hot.mod2Osc.setFrequency(s.mod2Freq[i]);
 
         double phaseMod = 0.0;
-        float mixMod1Audio = 0.0f, mixMod2Audio = 0.0f;
+        float mixAudio = 0.0f;
 
-        switch (fmAlgo)
+        if constexpr (!Mod2Active && Algo != 4)
+        {
+            // Mod2 muet : seule la contribution de Mod1 subsiste
+            hot.mod2Osc.advance();
+            if constexpr (Algo == 1 || Algo == 2)
+                phaseMod = mod1Signal;
+            else if constexpr (Algo == 5)
+                mixAudio = mod1Out * env1Val * m1Level;
+        }
+        else if constexpr (Algo == 0) // Series: Mod1 → Mod2 → Carrier
+        {
+            float mod2Out = hot.mod2Osc.tick(mod1Signal);
+            phaseMod = static_cast<double>(mod2Out * env2Val * m2Level * fluxMod)
+                       * kMaxModIndex;
+        }
+        else if constexpr (Algo == 1) // Parallel: Mod1 → Carrier, Mod2 → Carrier
+        {
+            float mod2Out = mod2Quad ? s.mod2Sine[i] : hot.mod2Osc.tick();
+            double mod2Signal = static_cast<double>(mod2Out * env2Val * m2Level * fluxMod)
+                                * kMaxModIndex;
+            phaseMod = mod1Signal + mod2Signal;
+        }
+        else if constexpr (Algo == 2) // Stack: Mod1 → Mod2 → Carrier + Mod1 → Carrier
         {
-            case 0: // Series: Mod1 → Mod2 → Carrier
+            float mod2Out = hot.mod2Osc.tick(mod1Signal);
+            double mod2Signal = static_cast<double>(mod2Out * env2Val * m2Level * fluxMod)
+                                * kMaxModIndex;
+            phaseMod = mod1Signal + mod2Signal;
+        }
+        else if constexpr (Algo == 3) // Ring: Mod1 × Mod2 → Carrier
+        {
+            if constexpr (Mod1Active)
             {
-                float mod2Out = mod2Osc.tick(mod1Signal);
-                float env2Val = env2.tick();
-                phaseMod = static_cast<double>(mod2Out * env2Val * m2Level * fluxMod)
+                float mod2Out = mod2Quad ? s.mod2Sine[i] : hot.mod2Osc.tick();
+                float ringOut = mod1Out * env1Val * mod2Out * env2Val;
+                phaseMod = static_cast<double>(ringOut * m1Level * m2Level * fluxMod)
                            * kMaxModIndex;
-                break;
             }
-            case 1: // Parallel: Mod1 → Carrier, Mod2 → Carrier
+            else
+            {
+                hot.mod2Osc.advance(); // produit nul
+            }
+        }
+        else if constexpr (Algo == 4) // Feedback: Mod1 → Mod2 → Carrier, Mod2 self-modulates
+        {
+            double fbSignal = static_cast<double>(hot.mod2FeedbackSample)
+                              * kMaxModIndex * 0.5;
+            float mod2Out = hot.mod2Osc.tick(mod1Signal + fbSignal);
+            hot.mod2FeedbackSample = mod2Out * env2Val;
+            phaseMod = static_cast<double>(hot.mod2FeedbackSample * m2Level * fluxMod)
+                       * kMaxModIndex;
+        }
+        else // Algo 5 — Mix: all 3 oscillators output independently, summed
+        {
+            float mod2Out = mod2Quad ? s.mod2Sine[i] : hot.mod2Osc.tick();
+            mixAudio = mod1Out * env1Val * m1Level + mod2Out * env2Val * m2Level;
+        }
+
+        s.phaseMod[i] = phaseMod;
+        s.modAudio[i] = mixAudio;
+    }
+}
+
+// PM reçue par un opérateur : somme dépliée des modulateurs du masque
+template <unsigned From>
+static inline double sumOperatorInputs(const double* signal) noexcept
+{
+    double pm = 0.0;
+    if constexpr ((From & opgraph::bit(1)) != 0) pm += signal[1];
+    if constexpr ((From & opgraph::bit(2)) != 0) pm += signal[2];
+    if constexpr ((From & opgraph::bit(3)) != 0) pm += signal[3];
+    return pm;
+}
+
+template <int Algo, unsigned Active>
+void FMVoice::renderOperators(int numSamples) noexcept
+{
+    auto& s = scratch;
+    const auto& b = block;
+    const auto& c = ctrl;
+
+    constexpr auto& route = opgraph::kRoutes[static_cast<std::size_t>(Algo)];
+    constexpr unsigned live = opgraph::liveOperators(route, Active);
+    constexpr unsigned out = route.out;
+
+    const double fbScale = static_cast<double>(b.mod3Feedback) * kMaxModIndex * 0.5;
+
+    // Ops 2 et 3 sans entrée dans le graphe : quadrature, comme renderModulators
+    constexpr bool kMod1Free = (live & opgraph::bit(1)) != 0 && (route.mods[1] & live) == 0;
+    constexpr bool kMod2Free = (live & opgraph::bit(2)) != 0 && (route.mods[2] & live) == 0;
+    const bool mod1Quad = kMod1Free && hot.mod1Osc.isPlainSine() && isSteady(s.mod1Freq, numSamples);
+    const bool mod2Quad = kMod2Free && hot.mod2Osc.isPlainSine() && isSteady(s.mod2Freq, numSamples);
+    if (mod1Quad)
+    {
+        hot.mod1Osc.setFrequency(s.mod1Freq[0]);
+        hot.mod1Osc.renderUnmodulatedSine(s.mod1Sine, numSamples, quadrature.mod1, s.syncFrac);
+    }
+    if (mod2Quad)
+    {
+        hot.mod2Osc.setFrequency(s.mod2Freq[0]);
+        hot.mod2Osc.renderUnmodulatedSine(s.mod2Sine, numSamples, quadrature.mod2);
+    }
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float fluxMod = c.fluxMod[i];
+        double signal[opgraph::kNumOperators] = {};
+        float mixAudio = 0.0f;
+
+        // --- Mod3 (op 4, feedback) ---
+        mod3.osc.setFrequency(b.mod3KB ? c.baseFreq[i] * b.mod3Ratio : b.mod3Ratio);
+        if constexpr ((live & opgraph::bit(3)) != 0)
+        {
+            const float opOut = mod3.osc.tick(static_cast<double>(mod3.feedbackSample) * fbScale);
+            mod3.feedbackSample = opOut * c.env4[i];
+            signal[3] = static_cast<double>(opOut * c.env4[i] * c.m3Level[i] * fluxMod) * kMaxModIndex;
+            if constexpr ((out & opgraph::bit(3)) != 0)
+                mixAudio += opOut * c.env4[i] * c.m3Level[i];
+        }
+        else
+        {
+            mod3.osc.advance();
+            mod3.feedbackSample = 0.0f;
+        }
+
+        // --- Mod2 (op 3) ---
+        if (!mod2Quad)
+            hot.mod2Osc.setFrequency(s.mod2Freq[i]);
+        if constexpr ((live & opgraph::bit(2)) != 0)
+        {
+            const float opOut = mod2Quad ? s.mod2Sine[i]
+                                         : hot.mod2Osc.tick(sumOperatorInputs<route.mods[2] & live>(signal));
+            signal[2] = static_cast<double>(opOut * c.env2[i] * c.m2Level[i] * fluxMod) * kMaxModIndex;
+            if constexpr ((out & opgraph::bit(2)) != 0)
+                mixAudio += opOut * c.env2[i] * c.m2Level[i];
+        }
+        else
+        {
+            hot.mod2Osc.advance();
+        }
+
+        // --- Mod1 (op 2) : donne aussi le sync pulse du carrier ---
+        if constexpr ((live & opgraph::bit(1)) != 0)
+        {
+            float opOut = 0.0f;
+            if (mod1Quad)
             {
-                float mod2Out = mod2Osc.tick();
-                float env2Val = env2.tick();
-                double mod2Signal = static_cast<double>(mod2Out * env2Val * m2Level * fluxMod)
-                                    * kMaxModIndex;
-                phaseMod = mod1Signal + mod2Signal;
-                break;
+                opOut = s.mod1Sine[i];
             }
-            case 2: // Stack: Mod1 → Mod2 → Carrier + Mod1 → Carrier
+            else
             {
-                float mod2Out = mod2Osc.tick(mod1Signal);
-                float env2Val = env2.tick();
-                double mod2Signal = static_cast<double>(mod2Out * env2Val * m2Level * fluxMod)
-                                    * kMaxModIndex;
-                phaseMod = mod1Signal + mod2Signal;
-                break;
+                hot.mod1Osc.setFrequency(s.mod1Freq[i]);
+                opOut = hot.mod1Osc.tick(sumOperatorInputs<route.mods[1] & live>(signal));
+                s.syncFrac[i] = hot.mod1Osc.hasSyncPulse() ? hot.mod1Osc.getSyncFraction() : -1.0f;
             }
-            case 3: // Ring: Mod1 × Mod2 → Carrier
+            signal[1] = static_cast<double>(opOut * c.env1[i] * c.m1Level[i] * fluxMod) * kMaxModIndex;
+            if constexpr ((out & opgraph::bit(1)) != 0)
+                mixAudio += opOut * c.env1[i] * c.m1Level[i];
+        }
+        else
+        {
+            hot.mod1Osc.setFrequency(s.mod1Freq[i]);
+            hot.mod1Osc.advance();
+            s.syncFrac[i] = hot.mod1Osc.hasSyncPulse() ? hot.mod1Osc.getSyncFraction() : -1.0f;
+        }
+
+        s.phaseMod[i] = sumOperatorInputs<route.mods[0] & live>(signal);
+        s.modAudio[i] = mixAudio;
+    }
+}
+
+template <int Factor, bool Sync>
+void FMVoice::renderCarrier(int numSamples) noexcept
+{
+    auto& s = scratch;
+
+    if constexpr (Factor == 1)
+    {
+        // Aucune PM sur le sous-bloc (Mix, modulateurs muets) : sinus en
+        // quadrature, comme les modulateurs sans entrée
+        if constexpr (!Sync)
+        {
+            if (hot.carrierOsc.isPlainSine() && hot.carrierOscR.isPlainSine()
+                && std::all_of(s.phaseMod, s.phaseMod + numSamples, [](double pm) { return pm == 0.0; })
+                && isSteady(s.carFreq, numSamples) && isSteady(s.carFreqR, numSamples))
             {
-                float mod2Out = mod2Osc.tick();
-                float env2Val = env2.tick();
-                float ringOut = mod1Out * env1Val * mod2Out * env2Val;
-                phaseMod = static_cast<double>(ringOut * m1Level * m2Level * fluxMod)
-                           * kMaxModIndex;
-                break;
+                hot.carrierOsc.setFrequency(s.carFreq[0]);
+                hot.carrierOscR.setFrequency(s.carFreqR[0]);
+                hot.carrierOsc.renderUnmodulatedSine(s.left, numSamples, quadrature.carrier);
+                hot.carrierOscR.renderUnmodulatedSine(s.right, numSamples, quadrature.carrierR);
+                return;
             }
-            case 4: // Feedback: Mod1 → Mod2 → Carrier, Mod2 self-modulates
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            hot.carrierOsc.setFrequency(s.carFreq[i]);
+            hot.carrierOscR.setFrequency(s.carFreqR[i]);
+
+            // Hard sync (sync pulse du modulateur 1 au même échantillon)
+            if (Sync && s.syncFrac[i] >= 0.0f)
             {
-                double fbSignal = static_cast<double>(mod2FeedbackSample)
-                                  * kMaxModIndex * 0.5;
-                float mod2Out = mod2Osc.tick(mod1Signal + fbSignal);
-                float env2Val = env2.tick();
-                mod2FeedbackSample = mod2Out * env2Val;
-                phaseMod = static_cast<double>(mod2FeedbackSample * m2Level * fluxMod)
-                           * kMaxModIndex;
-                break;
+                hot.carrierOsc.hardSyncReset(s.syncFrac[i]);
+                hot.carrierOscR.hardSyncReset(s.syncFrac[i]);
             }
-            case 5: // Mix: all 3 oscillators output independently, summed
+
+            s.left[i]  = hot.carrierOsc.tick(s.phaseMod[i]);
+            s.right[i] = hot.carrierOscR.tick(s.phaseMod[i]);
+        }
+    }
+    else
+    {
+        // Carriers préparés à sr × Factor : Factor ticks par échantillon de
+        // base, PM interpolée linéairement depuis l'échantillon précédent
+        constexpr double kSubStep = 1.0 / Factor;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            hot.carrierOsc.setFrequency(s.carFreq[i]);
+            hot.carrierOscR.setFrequency(s.carFreqR[i]);
+
+            // Hard sync : reporté au sous-échantillon où tombe le crossing
+            int syncSub = -1;
+            float syncSubFrac = 0.0f;
+            if (Sync && s.syncFrac[i] >= 0.0f)
             {
-                float mod2Out = mod2Osc.tick();
-                float env2Val = env2.tick();
-                mixMod1Audio = mod1Out * env1Val * m1Level;
-                mixMod2Audio = mod2Out * env2Val * m2Level;
-                phaseMod = 0.0;
-                break;
+                const float pos = s.syncFrac[i] * static_cast<float>(Factor);
+                syncSub = std::min(Factor - 1, static_cast<int>(pos));
+                syncSubFrac = pos - static_cast<float>(syncSub);
             }
-            default: // fallback to series
+
+            const double pm0 = hot.lastPhaseMod;
+            const double pmDelta = s.phaseMod[i] - pm0;
+            for (int k = 0; k < Factor; ++k)
             {
-                float mod2Out = mod2Osc.tick(mod1Signal);
-                float env2Val = env2.tick();
-                phaseMod = static_cast<double>(mod2Out * env2Val * m2Level * fluxMod)
-                           * kMaxModIndex;
-                break;
+                if (Sync && k == syncSub)
+                {
+                    hot.carrierOsc.hardSyncReset(syncSubFrac);
+                    hot.carrierOscR.hardSyncReset(syncSubFrac);
+                }
+                const double pm = pm0 + pmDelta * (static_cast<double>(k + 1) * kSubStep);
+                s.osLeft[i * Factor + k]  = hot.carrierOsc.tick(pm);
+                s.osRight[i * Factor + k] = hot.carrierOscR.tick(pm);
             }
+            hot.lastPhaseMod = s.phaseMod[i];
         }
+    }
+}
 
-        // --- Carrier --- (use pre-computed ratio)
-        double carrierFreq = carKB ? baseFreq * carRatio : carRatio;
-        carrierOsc.setFrequency(carrierFreq);
-        carrierOsc.setDrift(driftParam);
+template <int Factor, bool Sync>
+void FMVoice::renderUnisonCarrier(int numSamples) noexcept
+{
+    // Toutes les copies lisent la PM des modulateurs, calculée une fois.
+    // Le spread (carrierOscR) et le drift ne s'appliquent pas : la largeur
+    // vient du panoramique des copies.
+    auto& s = scratch;
+    unisonStack.render<Factor, Sync>(s.carFreq, s.phaseMod, s.syncFrac, hot.lastPhaseMod,
+                                     Factor == 1 ? s.left : s.osLeft,
+                                     Factor == 1 ? s.right : s.osRight, numSamples);
+}
 
-        // Stereo spread: detune R carrier by up to ±15 cents (+ global LFO)
-        // Linear approximation of exp2(x) for small x: 1 + x * ln(2)
-        float spread = juce::jlimit(0.0f, 1.0f, smoothCarSpread.getNextValue() + smoothGLfoSpread.getNextValue());
-        double detuneR = 1.0 + static_cast<double>(spread) * kDetuneScale;
-        carrierOscR.setFrequency(carrierFreq * detuneR);
-        carrierOscR.setDrift(driftParam);
-
-        // Hard sync
-        if (syncEnabled && mod1Osc.hasSyncPulse())
-        {
-            carrierOsc.hardSyncReset(mod1Osc.getSyncFraction());
-            carrierOscR.hardSyncReset(mod1Osc.getSyncFraction());
-        }
-
-        float carrierOutL = carrierOsc.tick(phaseMod);
-        float carrierOutR = carrierOscR.tick(phaseMod);
-        float env3Val = env3.tick();
-
-        // --- Carrier noise mix (+ global LFO) ---
-        float noiseMix = juce::jlimit(0.0f, 1.0f, smoothCarNoise.getNextValue() + smoothGLfoNoise.getNextValue());
-        float outputL, outputR;
-        float velGain = (params.velSwap.load(std::memory_order_relaxed) ? 1.0f : noteVelocity)
-                        * vTrim
-                        * params.expression.load(std::memory_order_relaxed);
-        if (noiseMix > 0.0001f)
-        {
-            // xorshift32 white noise: decorrelated L/R (independent seeds)
-            noiseSeedL ^= noiseSeedL << 13;
-            noiseSeedL ^= noiseSeedL >> 17;
-            noiseSeedL ^= noiseSeedL << 5;
-            float noiseL = static_cast<float>(static_cast<int32_t>(noiseSeedL))
-                           / 2147483648.0f;
-            noiseSeedR ^= noiseSeedR << 13;
-            noiseSeedR ^= noiseSeedR >> 17;
-            noiseSeedR ^= noiseSeedR << 5;
-            float noiseR = static_cast<float>(static_cast<int32_t>(noiseSeedR))
-                           / 2147483648.0f;
-            outputL = (carrierOutL * (1.0f - noiseMix) + noiseL * noiseMix)
-                      * env3Val * velGain;
-            outputR = (carrierOutR * (1.0f - noiseMix) + noiseR * noiseMix)
-                      * env3Val * velGain;
+template <int Factor, bool Noise, bool MixAlgo, bool Xor, bool Filt, bool Fold>
+int FMVoice::renderPostChain(int numSamples) noexcept
+{
+    const auto& b = block;
+    const auto& c = ctrl;
+    auto& s = scratch;
+
+    // Étages non linéaires au taux suréchantillonné : n échantillons, le
+    // contrôle (taux de base) est lu à l'index i / Factor
+    const int n = numSamples * Factor;
+    float* outL = Factor == 1 ? s.left  : s.osLeft;
+    float* outR = Factor == 1 ? s.right : s.osRight;
+
+    // --- Carrier noise mix + VCA (env3 × vélocité) ---
+    // Bruit tiré pour tout le sous-bloc. Les flux avancent d'un index par
+    // échantillon, bruit mélangé ou non : l'échantillon i a la même valeur
+    // quel que soit le noyau (ici ou lanes de VoiceBank).
+    if constexpr (Noise)
+    {
+        hot.noiseL.fill(s.noiseL, n);
+        hot.noiseR.fill(s.noiseR, n);
+    }
+    else
+    {
+        hot.noiseL.skip(n);
+        hot.noiseR.skip(n);
+    }
+
+    for (int i = 0; i < n; ++i)
+    {
+        const int ci = i / Factor;
+        const float noiseMix = c.noiseMix[ci];
+        if (Noise && noiseMix > 0.0001f)
+        {
+            outL[i] = (outL[i] * (1.0f - noiseMix) + s.noiseL[i] * noiseMix) * c.env3[ci] * c.velGain[ci];
+            outR[i] = (outR[i] * (1.0f - noiseMix) + s.noiseR[i] * noiseMix) * c.env3[ci] * c.velGain[ci];
         }
         else
         {
-            outputL = carrierOutL * env3Val * velGain;
-            outputR = carrierOutR * env3Val * velGain;
+            outL[i] = outL[i] * c.env3[ci] * c.velGain[ci];
+            outR[i] = outR[i] * c.env3[ci] * c.velGain[ci];
         }
+    }
 
-        // Mix algo: add mod oscillators as audio (each with their own envelope)
-        if (fmAlgo == 5)
+    // Mix algo: add mod oscillators as audio (each with their own envelope)
+    // (maintenu sur les sous-échantillons en suréchantillonnage)
+    if constexpr (MixAlgo)
+    {
+        for (int i = 0; i < n; ++i)
         {
-            float modAudio = (mixMod1Audio + mixMod2Audio) * velGain;
-            outputL += modAudio;
-            outputR += modAudio;
+            const int ci = i / Factor;
+            float modAudio = s.modAudio[ci] * c.velGain[ci];
+            outL[i] += modAudio;
+            outR[i] += modAudio;
         }
+    }
 
-        // --- XOR distortion ---
-        if (xorEnabled)
+    // --- XOR distortion ---
+    if constexpr (Xor)
+    {
+        for (int i = 0; i < n; ++i)
         {
-            outputL = xorDist.process(outputL);
-            outputR = xorDist.process(outputR);
+            outL[i] = hot.xorDist.process(outL[i]);
+            outR[i] = hot.xorDist.process(outR[i]);
         }
+    }
 
-        // --- Filtre SVF ---
-        if (filtEnabled)
+    // --- Filtre SVF ---
+    if constexpr (Filt)
+    {
+        for (int i = 0; i < n; ++i)
         {
-            // Vein modulation: multiplicative ±2 octaves
-            float veinMod = (veinAmount > 0.001f) ? std::exp2f(veinAmount * lfo2Val * 2.0f) : 1.0f;
-            // Global LFO: additive in normalized knob space (skew=0.23, centre=1kHz, Serum/Vital style)
-            // Forward: norm = ((hz-20)/19980)^skew  |  Inverse: hz = 20 + 19980 * norm^(1/skew)
-            constexpr float kCutSkew = 0.2299f;
-            constexpr float kCutInvSkew = 1.0f / kCutSkew; // ~4.35
-            float gLfoCutSmoothed = smoothGLfoCutoff.getNextValue();
-            float cutLin = juce::jlimit(0.0f, 1.0f, (cutoff - 20.0f) / 19980.0f);
-            float cutNorm = std::pow(cutLin, kCutSkew);
-            cutNorm = juce::jlimit(0.0f, 1.0f, cutNorm + gLfoCutSmoothed);
-            float modulatedCutoff = (20.0f + 19980.0f * std::pow(cutNorm, kCutInvSkew)) * veinMod;
-            modulatedCutoff = juce::jlimit(20.0f, 20000.0f, modulatedCutoff);
-            float modulatedRes = juce::jlimit(0.0f, 1.0f, resonance + smoothGLfoRes.getNextValue());
+            float modulatedCutoff = c.cutoffHz[i / Factor];
+            float modulatedRes    = c.res[i / Factor];
             // Only recalculate filter coefficients when parameters changed
             // audibly. Threshold widened from 0.5 Hz / 0.001 to 1.5 Hz / 0.002
             // — the tighter values were flipping the tan()-based coeff math
             // every few samples during automation sweeps for sub-perceptual
             // (<0.05 dB) cutoff steps. Voice coeffs now recompute maybe
             // 100× less often during smooth sweeps.
-            if (std::abs(modulatedCutoff - lastFilterCutoff) > 1.5f
-                || std::abs(modulatedRes    - lastFilterRes)    > 0.002f)
+            if (std::abs(modulatedCutoff - hot.lastFilterCutoff) > 1.5f
+                || std::abs(modulatedRes    - hot.lastFilterRes)    > 0.002f)
             {
-                filterL.setParameters(modulatedCutoff, modulatedRes);
-                filterR.setParameters(modulatedCutoff, modulatedRes);
-                lastFilterCutoff = modulatedCutoff;
-                lastFilterRes    = modulatedRes;
+                hot.filterL.setParameters(modulatedCutoff, modulatedRes);
+                hot.filterR.setParameters(modulatedCutoff, modulatedRes);
+                hot.lastFilterCutoff = modulatedCutoff;
+                hot.lastFilterRes    = modulatedRes;
             }
-            outputL = filterL.tick(outputL, filterMode);
-            outputR = filterR.tick(outputR, filterMode);
+            outL[i] = hot.filterL.tick(outL[i], b.filterMode);
+            outR[i] = hot.filterR.tick(outR[i], b.filterMode);
         }
+    }
 
-        // --- DC Blocker ---
-        outputL = dcBlockerL.tick(outputL);
-        outputR = dcBlockerR.tick(outputR);
+    // --- DC Blocker ---
+    for (int i = 0; i < n; ++i)
+    {
+        outL[i] = hot.dcBlockerL.tick(outL[i]);
+        outR[i] = hot.dcBlockerR.tick(outR[i]);
+    }
 
-        // --- HemoFold (wavefolder) ---
-        outputL = hemoFoldL.tick(outputL);
-        outputR = hemoFoldR.tick(outputR);
+    // --- HemoFold (wavefolder) ---
+    if constexpr (Fold)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            outL[i] = hot.hemoFoldL.tick(outL[i]);
+            outR[i] = hot.hemoFoldR.tick(outR[i]);
+        }
+    }
 
-        // --- Drive saturation (Serum/Vital order: drive pre-volume so the
-        // saturation character stays constant regardless of the volume knob,
-        // then volume attenuates the already-shaped signal) ---
-        float drv = juce::jlimit(1.0f, 10.0f, smoothDrive.getNextValue() + smoothGLfoDrive.getNextValue() * 9.0f);
-        outputL = std::tanh(outputL * drv) * vol;
-        outputR = std::tanh(outputR * drv) * vol;
+    // --- Drive saturation (Serum/Vital order: drive pre-volume so the
+    // saturation character stays constant regardless of the volume knob,
+    // then volume attenuates the already-shaped signal) ---
+    if (b.antialias)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            const int ci = i / Factor;
+            outL[i] = hot.driveShaperL.process(outL[i] * c.drive[ci]) * c.vol[ci];
+            outR[i] = hot.driveShaperR.process(outR[i] * c.drive[ci]) * c.vol[ci];
+        }
+    }
+    else
+    {
+        // Dernière entrée gardée : pas de saut si l'ADAA est activé ensuite
+        const float lastDrive = c.drive[(n - 1) / Factor];
+        hot.driveShaperL.track(outL[n - 1] * lastDrive);
+        hot.driveShaperR.track(outR[n - 1] * lastDrive);
 
-        // --- Anti-click fade-in for new notes ---
-        if (noteFadeInSamples > 0)
+        for (int i = 0; i < n; ++i)
         {
-            float fadeGain = 1.0f - static_cast<float>(noteFadeInSamples) / static_cast<float>(noteFadeInLength);
-            outputL *= fadeGain;
-            outputR *= fadeGain;
-            --noteFadeInSamples;
+            const int ci = i / Factor;
+            outL[i] = dspmath::tanh(outL[i] * c.drive[ci]) * c.vol[ci];
+            outR[i] = dspmath::tanh(outR[i] * c.drive[ci]) * c.vol[ci];
         }
+    }
+
+    // --- Retour au taux de base (demi-bandes polyphase) ---
+    if constexpr (Factor > 1)
+    {
+        decimatorL.process(s.osLeft, s.left, numSamples, Factor);
+        decimatorR.process(s.osRight, s.right, numSamples, Factor);
+        outL = s.left;
+        outR = s.right;
+    }
+
+    // --- Anti-click fade-in for new notes ---
+    for (int i = 0; i < numSamples && hot.noteFadeInSamples > 0; ++i)
+    {
+        float fadeGain = 1.0f - static_cast<float>(hot.noteFadeInSamples) / static_cast<float>(hot.noteFadeInLength);
+        outL[i] *= fadeGain;
+        outR[i] *= fadeGain;
+        --hot.noteFadeInSamples;
+    }
+
+    // --- Anti-click fade-out for voice stealing ---
+    // L'échantillon où le compteur atteint 0 n'est pas écrit : la voix
+    // s'arrête là (renderAudio appelle finishStealFade).
+    int numValid = numSamples;
+    for (int i = 0; i < numSamples && hot.stealFadeSamples > 0; ++i)
+    {
+        float fadeGain = static_cast<float>(hot.stealFadeSamples) / static_cast<float>(hot.stealFadeLength);
+        outL[i] *= fadeGain;
+        outR[i] *= fadeGain;
+        if (--hot.stealFadeSamples == 0)
+            numValid = i;
+    }
+
+    // --- NaN/Inf guard ---
+    for (int i = 0; i < numValid; ++i)
+    {
+        if (!std::isfinite(outL[i])) outL[i] = 0.0f;
+        if (!std::isfinite(outR[i])) outR[i] = 0.0f;
+    }
+
+    return numValid;
+}
+
+// --- Cache de rendu (NoteCache) ---
+
+template <typename Fn>
+void FMVoice::visitCacheState(CacheState& s, Fn&& fn)
+{
+    fn(block, s.block);
+    fn(controlKernel, s.controlKernel);
+    fn(carrierKernel, s.carrierKernel);
+    fn(postChainOffset, s.postChainOffset);
+    fn(hot.mod1Osc, s.mod1Osc);
+    fn(hot.mod2Osc, s.mod2Osc);
+    fn(hot.carrierOsc, s.carrierOsc);
+    fn(hot.carrierOscR, s.carrierOscR);
+    fn(unisonStack, s.unisonStack);
+    fn(mod3, s.mod3);
+    fn(hot.mod2FeedbackSample, s.mod2FeedbackSample);
+    fn(hot.env1, s.env1);
+    fn(hot.env2, s.env2);
+    fn(hot.env3, s.env3);
+    fn(hot.pitchEnv, s.pitchEnv);
+    fn(hot.filterL, s.filterL);
+    fn(hot.filterR, s.filterR);
+    fn(hot.xorDist, s.xorDist);
+    fn(hot.dcBlockerL, s.dcBlockerL);
+    fn(hot.dcBlockerR, s.dcBlockerR);
+    fn(hot.hemoFoldL, s.hemoFoldL);
+    fn(hot.hemoFoldR, s.hemoFoldR);
+    fn(hot.driveShaperL, s.driveShaperL);
+    fn(hot.driveShaperR, s.driveShaperR);
+    fn(hot.currentFreq, s.currentFreq);
+    fn(hot.smoothers, s.smoothers);
+    fn(lastEnv1, s.lastEnv1);
+    fn(lastEnv2, s.lastEnv2);
+    fn(lastEnv3, s.lastEnv3);
+    fn(lastEnv4, s.lastEnv4);
+    fn(lastPitchEnv, s.lastPitchEnv);
+    fn(hot.lastFilterCutoff, s.lastFilterCutoff);
+    fn(hot.lastFilterRes, s.lastFilterRes);
+    fn(hot.noteFadeInSamples, s.noteFadeInSamples);
+}
+
+bool FMVoice::isCacheable() const noexcept
+{
+    // Bruit et table custom : pas de point de départ reproductible
+    auto fixedWave = [](WaveType w) { return w != WaveType::Noise && w != WaveType::Custom; };
+    const auto& b = block;
+    return osFactor == 1
+        && b.driftParam == 0.0f
+        && b.tremorAmount == 0.0f && b.veinAmount == 0.0f && b.fluxAmount == 0.0f
+        && hot.smoothers.getTargetValue(SmoothCarNoise) <= 0.0f && hot.smoothers.getTargetValue(SmoothGLfoNoise) <= 0.0f
+        && fixedWave(b.mod1Wave) && fixedWave(b.mod2Wave) && fixedWave(b.carWave)
+        && (!b.opMatrix || fixedWave(b.mod3Wave))
+        && hot.currentFreq == hot.targetNoteFreq;
+}
+
+// FNV-1a 64 bits, champ par champ (les octets de padding n'entrent pas)
+namespace {
+struct SignatureHash
+{
+    uint64_t h = 0xcbf29ce484222325ull;
 
-        // --- Anti-click fade-out for voice stealing ---
-        if (stealFadeSamples > 0)
+    template <typename T>
+    void add(T value) noexcept
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        for (auto byte : bytes)
         {
-            float fadeGain = static_cast<float>(stealFadeSamples) / static_cast<float>(stealFadeLength);
-            outputL *= fadeGain;
-            outputR *= fadeGain;
-            --stealFadeSamples;
-            if (stealFadeSamples == 0)
-            {
-                env1.reset();
-                env2.reset();
-                env3.reset();
-                pitchEnv.reset();
-                clearCurrentNote();
-                return;
-            }
+            h ^= byte;
+            h *= 0x100000001b3ull;
         }
+    }
+};
+}
 
-        // --- NaN/Inf guard ---
-        if (!std::isfinite(outputL)) outputL = 0.0f;
-        if (!std::isfinite(outputR)) outputR = 0.0f;
+uint64_t FMVoice::cacheSignature() const noexcept
+{
+    SignatureHash s;
+    const auto& b = block;
+    s.add(b.mod1Ratio); s.add(b.mod2Ratio); s.add(b.carRatio);
+    s.add(b.mod1KB); s.add(b.mod2KB); s.add(b.carKB);
+    s.add(b.fmAlgo);
+    s.add(b.xorEnabled); s.add(b.syncEnabled); s.add(b.filtEnabled);
+    s.add(b.pitchEnvEnabled); s.add(b.pitchEnvAmt);
+    s.add(b.tremorAmount); s.add(b.veinAmount); s.add(b.fluxAmount);
+    s.add(b.resonance); s.add(b.filterMode); s.add(b.driftParam);
+    s.add(b.modStep); s.add(b.antialias);
+    s.add(b.vBias); s.add(b.vTrim);
+    s.add(b.mod1Wave); s.add(b.mod2Wave); s.add(b.carWave);
+    s.add(b.unisonVoices); s.add(b.unisonDetune); s.add(b.unisonBlend); s.add(b.unisonWidth);
+    s.add(b.opMatrix); s.add(b.opAlgo); s.add(b.mod3Ratio); s.add(b.mod3KB);
+    s.add(b.mod3Feedback); s.add(b.mod3Wave);
+
+    // Cibles des smoothers : tous les paramètres continus et sommes LFO
+    for (int i = 0; i < kNumSmoothers; ++i)
+        s.add(hot.smoothers.getTargetValue(i));
+    for (const auto* env : { &lastEnv1, &lastEnv2, &lastEnv3, &lastEnv4, &lastPitchEnv })
+    {
+        s.add(env->a); s.add(env->d); s.add(env->s); s.add(env->r);
+    }
+
+    s.add(noteFreqHz);
+    s.add(hot.noteVelocity);
+    s.add(hot.pitchBendSemitones);
+    s.add(b.velSwap); s.add(b.expression);
+    s.add(osFactor);
+    s.add(sampleRate);
+    return s.h;
+}
+
+int FMVoice::renderFromCache(juce::AudioBuffer<float>& outputBuffer,
+                             int startSample, int numSamples)
+{
+    if (cacheMode == CacheMode::Armed)
+    {
+        startCachedNote(numSamples);
+    }
+    else if (cacheSignature() != cacheEntry->signature)
+    {
+        // Patch, contrôleur ou modulation changés en cours de note : l'entrée
+        // ne décrit plus ce que la voix doit produire
+        if (cacheMode == CacheMode::Play)
+        {
+            leaveCachePlayback();
+            beginBlock(numSamples);   // nouvelles valeurs pour la suite du bloc
+        }
+        else
+        {
+            stopCacheRecording(false);
+        }
+        return 0;
+    }
+
+    if (cacheMode != CacheMode::Play)
+        return 0;
 
-        // --- Écrire dans le buffer de sortie (true stereo) ---
+    auto& e = *cacheEntry;
+    const int numPlayed = std::min(numSamples, e.playableLength() - cachePos);
+    if (numPlayed > 0)
+    {
+        outputBuffer.addFrom(0, startSample, e.left.data() + cachePos, numPlayed);
         if (outputBuffer.getNumChannels() >= 2)
+            outputBuffer.addFrom(1, startSample, e.right.data() + cachePos, numPlayed);
+        cachePos += numPlayed;
+    }
+
+    if (cachePos == e.playableLength())
+    {
+        // Fin de l'entrée : reprise exacte au dernier instantané. Une entrée
+        // plus courte que la fenêtre (note relâchée tôt) est prolongée par
+        // cette frappe si personne d'autre ne l'enregistre.
+        restoreSnapshot(e.numSnapshots - 1);
+        if (!e.recording && cachePos < params.renderCache->getWindowSamples())
         {
-            outputBuffer.addSample(0, startSample + i, outputL);
-            outputBuffer.addSample(1, startSample + i, outputR);
+            e.recording = true;
+            cacheMode = CacheMode::Record;
+            cacheNextSnapshot = cachePos + NoteCache::kSnapshotStride;
         }
         else
         {
-            outputBuffer.addSample(0, startSample + i, outputL);
+            releaseCache();
         }
     }
+    return numPlayed;
+}
 
-    if (!env3.isActive())
-        clearCurrentNote();
+void FMVoice::startCachedNote(int numSamples)
+{
+    cacheMode = CacheMode::Off;
+    if (!isCacheable())
+        return;
+
+    // Point de départ identique d'une frappe à l'autre : smoothers sur leur
+    // cible, états de filtre et de pliage vidés, puis paramètres relus
+    hot.smoothers.settleAll();
+    hot.filterL.reset();
+    hot.filterR.reset();
+    hot.dcBlockerL.reset();
+    hot.dcBlockerR.reset();
+    hot.hemoFoldL.reset();
+    hot.hemoFoldR.reset();
+    hot.lastFilterCutoff = -1.0f;
+    hot.lastFilterRes    = -1.0f;
+    beginBlock(numSamples);
+
+    auto& cache = *params.renderCache;
+    const uint64_t signature = cacheSignature();
+    cachePos = 0;
+
+    if ((cacheEntry = cache.find(signature)) != nullptr)
+    {
+        cacheMode = CacheMode::Play;
+    }
+    else if ((cacheEntry = cache.acquire(signature)) != nullptr)
+    {
+        cacheMode = CacheMode::Record;
+        captureSnapshot();
+        cacheNextSnapshot = NoteCache::kSnapshotStride;
+    }
+}
+
+void FMVoice::recordCached(int numSamples)
+{
+    auto& e = *cacheEntry;
+    std::copy(scratch.left, scratch.left + numSamples, e.left.data() + cachePos);
+    std::copy(scratch.right, scratch.right + numSamples, e.right.data() + cachePos);
+    cachePos += numSamples;
+
+    // Le dernier emplacement est réservé à l'instantané de fin
+    const bool full = e.numSnapshots + 1 >= static_cast<int>(e.snapshots.size());
+    if (cachePos >= params.renderCache->getWindowSamples() || full)
+        stopCacheRecording(true);
+    else if (cachePos >= cacheNextSnapshot)
+    {
+        captureSnapshot();
+        cacheNextSnapshot = cachePos + NoteCache::kSnapshotStride;
+    }
+}
+
+void FMVoice::captureSnapshot()
+{
+    auto& e = *cacheEntry;
+    const auto index = static_cast<size_t>(e.numSnapshots++);
+    e.snapshotPos[index] = cachePos;
+    visitCacheState(e.snapshots[index], [](auto& live, auto& saved) { saved = live; });
+}
+
+void FMVoice::restoreSnapshot(int index)
+{
+    visitCacheState(cacheEntry->snapshots[static_cast<size_t>(index)],
+                    [](auto& live, const auto& saved) { live = saved; });
+    appliedSerial = kStaleSerial;   // réglages de l'enregistrement : réappliquer l'instantané
+}
+
+void FMVoice::leaveCachePlayback()
+{
+    auto& e = *cacheEntry;
+    const int index = e.snapshotBefore(cachePos);
+    restoreSnapshot(index);
+
+    // Rattrapage jusqu'à la position courante, sans sortie
+    for (int pos = e.snapshotPos[static_cast<size_t>(index)]; pos < cachePos; )
+    {
+        const int n = std::min(kControlBlock, cachePos - pos);
+        renderControl(n);
+        renderSamples(n);
+        pos += n;
+    }
+    releaseCache();
+}
+
+void FMVoice::stopCacheRecording(bool commit)
+{
+    auto& e = *cacheEntry;
+    if (commit && cachePos > e.playableLength())
+        captureSnapshot();
+    e.recording = false;
+    // Rien de relisible : l'entrée redevient libre
+    if (e.playableLength() == 0)
+        e.valid = false;
+    releaseCache();
+}
+
+void FMVoice::leaveCache()
+{
+    if (cacheMode == CacheMode::Play)
+        leaveCachePlayback();
+    else if (cacheMode == CacheMode::Record)
+        stopCacheRecording(true);
+    cacheMode = CacheMode::Off;
+}
+
+void FMVoice::releaseCache() noexcept
+{
+    if (cacheEntry != nullptr && params.renderCache != nullptr)
+        params.renderCache->release(*cacheEntry);
+    cacheEntry = nullptr;
+    cacheMode = CacheMode::Off;
 }
 
 } // namespace bb
@@ -11,9 +11,18 @@
 #include "XORDistortion.h"
 #include "DCBlocker.h"
 #include "HemoFold.h"
+#include "Adaa.h"
+#include "HalfBand.h"
+#include "UnisonStack.h"
+#include "OperatorGraph.h"
+#include "SmootherBank.h"
+#include "BlockNoise.h"
 
 namespace bb {
 
+class NoteCache;
+struct NoteCacheEntry;
+
 // LFO destination enum for assignable global LFOs
 enum class LFODest : int {
     None = 0,
@@ -95,8 +104,7 @@ inline float multiValue(int idx) {
     return kMultiValues[juce::jlimit(0, kNumMultiValues - 1, idx)];
 }
 
-// Structure pour cacher les pointeurs atomiques vers les paramètres APVTS
-// On les lit une fois par bloc dans renderNextBlock (pas de hash lookup)
+// On les lit une fois par bloc dans VoiceBlockParams::capture (pas de hash lookup)
 struct VoiceParams
 {
     std::atomic<float>* mod1On        = nullptr;
@@ -137,6 +145,26 @@ struct VoiceParams
     std::atomic<float>* carKB       = nullptr;
     std::atomic<float>* carNoise    = nullptr;
     std::atomic<float>* carSpread   = nullptr;
+    std::atomic<float>* unison       = nullptr; // Carriers par voix (1-8)
+    std::atomic<float>* unisonDetune = nullptr; // 0..1 → ±50 cents
+    std::atomic<float>* unisonBlend  = nullptr; // niveau des copies latérales
+    std::atomic<float>* unisonWidth  = nullptr; // panoramique des copies
+    // Mode 4 opérateurs : Mod3 (op 4, feedback) et algorithme du graphe
+    std::atomic<float>* mod3On       = nullptr; // 0 = routage classique (fmAlgo)
+    std::atomic<float>* opAlgo       = nullptr; // 0..7, voir OperatorGraph.h
+    std::atomic<float>* mod3Wave     = nullptr;
+    std::atomic<float>* mod3KB       = nullptr;
+    std::atomic<float>* mod3Level    = nullptr;
+    std::atomic<float>* mod3Coarse   = nullptr;
+    std::atomic<float>* mod3Fine     = nullptr;
+    std::atomic<float>* mod3FixedFreq = nullptr;
+    std::atomic<float>* mod3Multi    = nullptr;
+    std::atomic<float>* mod3Feedback = nullptr;
+    std::atomic<float>* env4A        = nullptr;
+    std::atomic<float>* env4D        = nullptr;
+    std::atomic<float>* env4S        = nullptr;
+    std::atomic<float>* env4R        = nullptr;
+
     std::atomic<float>* env3A       = nullptr;
     std::atomic<float>* env3D      = nullptr;
     std::atomic<float>* env3S      = nullptr;
@@ -175,6 +203,16 @@ struct VoiceParams
     std::atomic<float>* plasma    = nullptr; // FM depth multiplier (0=pure, 1=full FM)
     std::atomic<float>* macroTime = nullptr; // Envelope time scale (0.5=1x, 0=0.25x, 1=4x)
     std::atomic<float>* octave    = nullptr; // Global octave shift (−4 to +4)
+    std::atomic<float>* modRate   = nullptr; // Modulation rate (0=per-sample, 1=8, 2=16, 3=32 samples)
+    std::atomic<float>* oversampling = nullptr; // Carrier + post-chain oversampling (0=1×, 1=2×, 2=4×)
+    std::atomic<float>* antialias = nullptr;    // ADAA on fold + drive (0/1)
+    std::atomic<float>* noteCache = nullptr;    // Replay of repeated deterministic notes (0/1)
+
+    // Render cache shared by all voices (owned and prepared by the processor)
+    NoteCache* renderCache = nullptr;
+
+    // Offline / HQ render: forces per-sample modulation whatever MOD_RATE says
+    std::atomic<bool> hqRender { false };
 
     // Global LFO modulation sums (written by processor, read by voice)
     std::atomic<float> lfoModPitch   { 0.0f };
@@ -264,6 +302,78 @@ struct VoiceParams
     //   expression (CC11) — 0..1, multiplies voice output (defaults to 1.0)
     std::atomic<float> modWheel   { 0.0f };
     std::atomic<float> expression { 1.0f };
+
+    // Génération des réglages : avancée à chaque changement d'une entrée
+    // (paramètre APVTS, somme LFO, CC, facteurs de stage). Tant qu'elle ne
+    // bouge pas, les dérivés par bloc (instantané des voix, réglages des
+    // effets) restent valides et ne sont pas recalculés.
+    std::atomic<uint64_t> generation { 0 };
+    void bumpGeneration() noexcept { generation.fetch_add(1, std::memory_order_release); }
+};
+
+// Réglages d'une voix pour un bloc, tels que les noyaux les lisent
+// (FMVoice::block). Ne dépendent que des paramètres, pas de la note.
+struct VoiceBlockSetup
+{
+    double mod1Ratio = 1.0, mod2Ratio = 1.0, carRatio = 1.0;
+    bool   mod1KB = true, mod2KB = true, carKB = true;
+    int    fmAlgo = 0;
+    bool   xorEnabled = false, syncEnabled = false, filtEnabled = false;
+    bool   pitchEnvEnabled = false;
+    float  pitchEnvAmt = 0.0f;
+    float  tremorAmount = 0.0f, veinAmount = 0.0f, fluxAmount = 0.0f;
+    float  resonance = 0.0f;
+    FilterMode filterMode = FilterMode::LP;
+    float  driftParam = 0.0f;
+    int    modStep = 1;   // pas des points de contrôle (1 = par échantillon)
+    bool   antialias = false;   // ADAA sur fold + drive
+    float  vBias = 1.0f, vTrim = 1.0f;
+    bool   velSwap = false;     // vélocité détournée vers un LFO : gain de voix à 1
+    float  expression = 1.0f;   // CC11
+    WaveType mod1Wave = WaveType::Sine, mod2Wave = WaveType::Sine, carWave = WaveType::Sine;
+    int    unisonVoices = 1;   // > 1 : carriers rendus par UnisonStack
+    float  unisonDetune = 0.0f, unisonBlend = 1.0f, unisonWidth = 0.0f;
+    // Mode 4 opérateurs (opMatrix) : fmAlgo ignoré, opAlgo choisit le graphe
+    bool   opMatrix = false;
+    int    opAlgo = 0;
+    double mod3Ratio = 1.0;
+    bool   mod3KB = true;
+    float  mod3Feedback = 0.0f;
+    WaveType mod3Wave = WaveType::Sine;
+    bool   mixAudio = false;   // des modulateurs sortent en audio (Mix, graphes à plusieurs carriers)
+};
+
+// Instantané des VoiceParams pour un bloc : une seule lecture des atomics
+// et un seul calcul des dérivés (ratios, macros, temps d'enveloppe) pour
+// toutes les voix. Le processor le capture avant chaque rendu et FMSynth
+// le passe à ses voix ; une voix sans instantané partagé capture le sien.
+struct VoiceBlockParams
+{
+    struct Adsr { float a = 0.0f, d = 0.0f, s = 0.0f, r = 0.0f; };
+
+    VoiceBlockSetup setup;
+
+    // Cibles des smoothers de la voix
+    float volume = 0.0f, cutoff = 20000.0f, drive = 1.0f, fold = 0.0f;
+    float mod1Level = 0.0f, mod2Level = 0.0f, mod3Level = 0.0f;
+    float carNoise = 0.0f, carSpread = 0.0f;
+    // Sommes des LFOs globaux
+    float lfoPitch = 0.0f, lfoCutoff = 0.0f, lfoRes = 0.0f, lfoVolume = 0.0f, lfoDrive = 0.0f;
+    float lfoMod1Lvl = 0.0f, lfoMod2Lvl = 0.0f, lfoNoise = 0.0f, lfoSpread = 0.0f, lfoFold = 0.0f;
+
+    // Enveloppes, modulation LFO et macro de temps comprises
+    Adsr env1, env2, env3, pitchEnv, env4;
+    bool hasEnv4 = false;   // paramètres Mod3 présents
+
+    int osFactor = 1;       // suréchantillonnage demandé (1, 2 ou 4)
+
+    // Incrémenté à chaque capture : une voix ne refait ses réglages
+    // dérivés (formes d'onde, enveloppes, noyaux) que s'il a bougé
+    uint64_t serial = 0;
+
+    // Thread audio, avant le rendu des voix. Le processor ne l'appelle que
+    // si VoiceParams::generation a bougé depuis la capture précédente.
+    void capture(const VoiceParams& params) noexcept;
 };
 
 class FMVoice : public juce::SynthesiserVoice
@@ -276,70 +386,280 @@ public:
                    juce::SynthesiserSound* sound, int currentPitchWheelPosition) override;
     void stopNote(float velocity, bool allowTailOff) override;
     void pitchWheelMoved(int newPitchWheelValue) override;
+    // Legato (mono) : passe à une autre note sans relancer les enveloppes
+    // ni les phases, en glissant depuis la hauteur courante (PORTA)
+    void glideToNote(int midiNoteNumber);
     void controllerMoved(int controllerNumber, int newControllerValue) override;
     void renderNextBlock(juce::AudioBuffer<float>& outputBuffer,
                          int startSample, int numSamples) override;
 
     void prepareToPlay(double sampleRate, int samplesPerBlock);
 
-private:
-    VoiceParams& params;
-
-    // Oscillateurs
-    Oscillator mod1Osc, mod2Osc, carrierOsc, carrierOscR;
-    float mod2FeedbackSample = 0.0f;
-
-    // Enveloppes (une par oscillateur + une pour le pitch)
-    ADSREnvelope env1, env2, env3;
-    ADSREnvelope pitchEnv;
-
-    // LFOs (free-running, par voix)
-    LFO lfo1, lfo2;
+    // Instantané de bloc partagé (nullptr = la voix lit ses paramètres
+    // elle-même à chaque bloc). Doit être capturé avant chaque rendu.
+    void setBlockParams(const VoiceBlockParams* snapshot) noexcept
+    {
+        sharedBlockParams = snapshot;
+        appliedSerial = kStaleSerial;
+    }
+
+    // Rendus reproductibles : tous les flux de bruit de la voix (carrier
+    // L/R, formes Noise des oscillateurs) repartent de flux dérivés de seed
+    void seedNoise(uint32_t seed) noexcept;
+
+    // Taille des sous-blocs de contrôle : enveloppes, LFOs, smoothers et
+    // pitch sont rendus par tranches de kControlBlock échantillons dans
+    // ControlFrame, puis consommés par l'étage audio (scalaire ici, ou par
+    // lanes SIMD dans VoiceBank).
+    static constexpr int kControlBlock = 32;
+
+    // Pas de modulation selon MOD_RATE : exp2 du pitch, pow du cutoff, vein
+    // et sin du drift sont évalués tous les N échantillons puis interpolés
+    // linéairement. Index 0 = par échantillon (rendu offline / HQ).
+    static constexpr int kModRateSteps[] = { 1, 8, 16, 32 };
+    static constexpr int kNumModRates = 4;
+
+    // Suréchantillonnage du carrier et de la chaîne non linéaire (XOR,
+    // filtre, HemoFold, drive) : 1×, 2× ou 4×. Les modulateurs et le
+    // contrôle restent au taux de base ; la PM est interpolée linéairement.
+    static constexpr int kMaxOversampling = OversamplingDecimator::kMaxFactor;
+    int getOversamplingFactor() const noexcept { return osFactor; }
+
+    // Voix servie, enregistrée ou en attente du cache de notes (état
+    // partagé entre voix : FMSynth la garde sur le thread audio)
+    bool usesNoteCache() const noexcept { return cacheMode != CacheMode::Off; }
+
+    // Niveau de sortie suivi : crête de env3 × vélocité × volume (× gain
+    // petit signal du drive, + modulateurs en algo Mix) sur le dernier bloc
+    // de contrôle ; 1 jusqu'au premier bloc d'une note. Sert au vol de voix
+    // « quietest » et à la coupure des releases inaudibles.
+    float getTrackedLevel() const noexcept { return trackedLevel; }
+
+    // Une voix en release dont le niveau suivi reste sous ce seuil pendant
+    // tout un rendu (−96 dBFS) est libérée sans attendre la fin de env3
+    static constexpr float kInaudibleLevel = 1.5849e-5f;
+
+    // État par échantillon de la voix (HotState), en octets et en lignes
+    // de cache de kCacheLineSize octets
+    static constexpr std::size_t kCacheLineSize = 64;
+    static constexpr std::size_t getHotStateSize() noexcept;
+    static constexpr std::size_t getHotStateCacheLines() noexcept
+    {
+        return (getHotStateSize() + kCacheLineSize - 1) / kCacheLineSize;
+    }
 
-    // Effets (L+R for stereo spread)
-    SVFilter filterL, filterR;
-    XORDistortion xorDist;
-    DCBlocker dcBlockerL, dcBlockerR;
-    HemoFold hemoFoldL, hemoFoldR;
+private:
+    friend class VoiceBank;
+    friend struct VoiceBlockParams;
+    friend class NoteCache;
+    friend struct NoteCacheEntry;
+
+    // Valeurs lues une fois par bloc (paramètres + dérivés block-rate),
+    // copiées depuis VoiceBlockParams::setup
+    using BlockSetup = VoiceBlockSetup;
+
+    // Valeurs par échantillon d'un sous-bloc de contrôle
+    struct ControlFrame
+    {
+        double baseFreq[kControlBlock];  // note × portamento × pitch mod (Hz)
+        float  fluxMod[kControlBlock];
+        float  vol[kControlBlock];
+        float  m1Level[kControlBlock];
+        float  m2Level[kControlBlock];
+        float  spread[kControlBlock];
+        float  noiseMix[kControlBlock];
+        float  velGain[kControlBlock];
+        float  drive[kControlBlock];
+        float  cutoffHz[kControlBlock];  // valides seulement si filtEnabled
+        float  res[kControlBlock];
+        float  env1[kControlBlock];
+        float  env2[kControlBlock];
+        float  env3[kControlBlock];
+        float  m3Level[kControlBlock];   // valides seulement si opMatrix
+        float  env4[kControlBlock];
+    };
+
+    // Tampons intermédiaires d'un sous-bloc audio : chaque étage remplit
+    // son tableau dans une boucle serrée, le suivant le relit.
+    struct AudioScratch
+    {
+        alignas(32) double mod1Freq[kControlBlock];
+        alignas(32) double mod2Freq[kControlBlock];
+        alignas(32) double carFreq[kControlBlock];
+        alignas(32) double carFreqR[kControlBlock];
+        alignas(32) double phaseMod[kControlBlock];
+        alignas(32) float  syncFrac[kControlBlock];  // < 0 : pas de sync pulse
+        // Modulateurs sans PM rendus en quadrature avant la boucle
+        alignas(32) float  mod1Sine[kControlBlock];
+        alignas(32) float  mod2Sine[kControlBlock];
+        alignas(32) float  modAudio[kControlBlock];  // algo Mix uniquement
+        alignas(32) float  left[kControlBlock];
+        alignas(32) float  right[kControlBlock];
+        // Carrier + chaîne non linéaire au taux suréchantillonné
+        alignas(32) float  osLeft[kControlBlock * kMaxOversampling];
+        alignas(32) float  osRight[kControlBlock * kMaxOversampling];
+        // Bruit du carrier (taux de la chaîne non linéaire)
+        alignas(32) float  noiseL[kControlBlock * kMaxOversampling];
+        alignas(32) float  noiseR[kControlBlock * kMaxOversampling];
+    };
+
+    void beginBlock(int numSamples);
+    // Boucle de sous-blocs contrôle → audio, après beginBlock()
+    void renderPrepared(juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples);
+    void renderControl(int numSamples) { (this->*controlKernel)(numSamples); }
+    // Retourne false si la voix s'est terminée (fin du steal fade)
+    bool renderAudio(juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples);
+    // Chaîne audio seule (scratch.left / right) : nombre d'échantillons valides
+    int  renderSamples(int numSamples) noexcept;
+    void renderFrequencies(int numSamples) noexcept;
+
+    // Noyaux spécialisés à la compilation : un par combinaison de flags,
+    // choisis via les tables de dispatch (FMVoice.cpp) — aucune branche
+    // sur l'algo ou les étages désactivés dans les boucles par échantillon.
+    template <bool PitchEnv, bool Filt>
+    void renderControlKernel(int numSamples);
+    // Remplit out[0..numSamples) avec eval(i) aux points de contrôle
+    // (0, step, 2·step… et le dernier échantillon), interpolé entre eux
+    template <typename T, typename Eval>
+    static void evalAtControlRate(T* out, int numSamples, int step, Eval&& eval) noexcept;
+    // Mod1Active / Mod2Active = false : opérateur muet sur tout le sous-bloc
+    // (niveau ou enveloppe à 0), sa phase avance sans rendu.
+    template <int Algo, bool Mod1Active, bool Mod2Active>
+    void renderModulators(int numSamples) noexcept;
+    // Mode 4 opérateurs : même contrat, graphe opgraph::kRoutes[Algo].
+    // Active = opérateurs audibles sur le sous-bloc (bit 1..3).
+    template <int Algo, unsigned Active>
+    void renderOperators(int numSamples) noexcept;
+    // Factor = suréchantillonnage : > 1 écrit osLeft / osRight
+    template <int Factor, bool Sync>
+    void renderCarrier(int numSamples) noexcept;
+    // Même contrat, carriers de la pile unison (block.unisonVoices > 1)
+    template <int Factor, bool Sync>
+    void renderUnisonCarrier(int numSamples) noexcept;
+    // Retourne le nombre d'échantillons valides (< numSamples si le steal
+    // fade se termine dans le sous-bloc). Avec Factor > 1, les étages non
+    // linéaires tournent sur osLeft / osRight puis sont décimés.
+    template <int Factor, bool Noise, bool MixAlgo, bool Xor, bool Filt, bool Fold>
+    int  renderPostChain(int numSamples) noexcept;
+    // Reconfigure les étages suréchantillonnés (appelé par beginBlock)
+    void setOversampling(int factor);
+
+    struct KernelTables; // tables de dispatch, définies dans FMVoice.cpp
+
+    using ControlKernel   = void (FMVoice::*)(int);
+    using ModulatorKernel = void (FMVoice::*)(int) noexcept;
+    using CarrierKernel   = void (FMVoice::*)(int) noexcept;
+    using PostChainKernel = int  (FMVoice::*)(int) noexcept;
+
+    // Sélectionnés par beginBlock() ; les modulateurs et le bruit sont
+    // re-choisis par sous-bloc selon les niveaux effectivement rendus.
+    ControlKernel   controlKernel = nullptr;
+    CarrierKernel   carrierKernel = nullptr;
+    int             postChainOffset = 0;   // [os] de la table postChain
+    void finishStealFade();
+    double noteToFrequency(int midiNoteNumber) const;
+    float getPortamentoTime() const;   // PORTA + LFO, 0..1
+    void setPortamento(float portaTime);
+    // Release restée sous kInaudibleLevel depuis beginBlock : enveloppes
+    // remises à zéro (la voix se termine comme à la fin de env3)
+    void cullIfInaudible() noexcept;
+
+    // Smoothers de HotState::smoothers, dans un ordre fixe (instantanés +
+    // signature). GLfo* : sommes des LFOs globaux, lissées elles aussi.
+    enum Smoother : int
+    {
+        SmoothVolume, SmoothCutoff, SmoothMod1Level, SmoothMod2Level,
+        SmoothCarNoise, SmoothCarSpread,
+        SmoothDrive,      // post-filter saturation gain
+        SmoothFold,       // wavefolder amount
+        SmoothGLfoPitch, SmoothGLfoCutoff, SmoothGLfoRes, SmoothGLfoVolume, SmoothGLfoDrive,
+        SmoothGLfoMod1Lvl, SmoothGLfoMod2Lvl, SmoothGLfoNoise, SmoothGLfoSpread, SmoothGLfoFold,
+        SmoothMod3Level,  // mode 4 opérateurs seulement
+        kNumSmoothers
+    };
+    static constexpr uint32_t smootherBit(int k) noexcept { return 1u << k; }
+
+    // État chaud : tout ce que la boucle par échantillon lit et écrit,
+    // regroupé et aligné sur une ligne de cache pour que la voix courante
+    // tienne dans un bloc contigu du L1. Le reste (paramètres, caches de
+    // bloc, décimateurs, cache de notes) n'est touché qu'une fois par bloc
+    // ou par sous-bloc. Taille surveillée par test_FMVoice.cpp.
+    struct alignas(kCacheLineSize) HotState
+    {
+        // Oscillateurs
+        Oscillator mod1Osc, mod2Osc, carrierOsc, carrierOscR;
+        float mod2FeedbackSample = 0.0f;
+
+        // Enveloppes (une par oscillateur + une pour le pitch)
+        ADSREnvelope env1, env2, env3;
+        ADSREnvelope pitchEnv;
+
+        // LFOs (free-running, par voix) : forme fixe, sans table custom
+        LFOCore lfo1, lfo2;
+
+        // Effets (L+R for stereo spread)
+        SVFilter filterL, filterR;
+        XORDistortion xorDist;
+        DCBlocker dcBlockerL, dcBlockerR;
+        HemoFold hemoFoldL, hemoFoldR;
+        adaa::Tanh driveShaperL, driveShaperR;   // drive en ADAA (block.antialias)
+
+        // Portamento
+        double targetNoteFreq = 440.0;
+        double currentFreq = 0.0; // 0 = no previous note, first note plays instantly
+        double portamentoRate = 0.0;
+
+        // Pitch wheel
+        double pitchBendSemitones = 0.0;
+
+        // Dernière PM (interpolation entre échantillons de base en suréchantillonné)
+        double lastPhaseMod = 0.0;
+
+        float noteVelocity = 0.0f;
+
+        // Smoothers des paramètres continus (anti-zipper), indexés par
+        // Smoother. Every per-sample multiplier/mix that's exposed to DAW
+        // automation or LFO modulation must go through one of these —
+        // block-rate steps are otherwise audible as zipper / clicks on fast
+        // sweeps. Global LFO sums are updated at block rate by
+        // PluginProcessor; we smooth the sum itself so that the LFO's effect
+        // on each destination is continuous per-sample.
+        SmootherBank<kNumSmoothers> smoothers;
+
+        // Filter coefficient cache: skip recalculation when params haven't changed
+        float lastFilterCutoff = -1.0f;
+        float lastFilterRes    = -1.0f;
+
+        // Carrier noise: one counter-based stream per channel (and per
+        // voice), filled a sub-block at a time
+        BlockNoise noiseL;
+        BlockNoise noiseR;
+
+        // Anti-click fade-out for voice stealing
+        int stealFadeSamples = 0;
+        int stealFadeLength  = 256;   // set properly in prepareToPlay
+
+        // Anti-click fade-in for new notes
+        int noteFadeInSamples = 0;
+        int noteFadeInLength  = 64;   // set properly in prepareToPlay
+    };
+
+    HotState hot;
 
-    // État de la note en cours
+    VoiceParams& params;
+    const VoiceBlockParams* sharedBlockParams = nullptr;
+    VoiceBlockParams ownBlockParams;   // sans instantané partagé
+    // Capture de l'instantané appliquée par beginBlock (kStaleSerial : aucune)
+    static constexpr uint64_t kStaleSerial = ~uint64_t { 0 };
+    uint64_t appliedSerial = kStaleSerial;
+    BlockSetup block;
+    ControlFrame ctrl;
+    AudioScratch scratch;
+
+    // État froid de la note en cours (lu à startNote et pour la signature)
     double noteFreqHz = 440.0;
-    float noteVelocity = 0.0f;
-
-    // Portamento
-    double targetNoteFreq = 440.0;
-    double currentFreq = 0.0; // 0 = no previous note, first note plays instantly
-    double portamentoRate = 0.0;
-
-    // Pitch wheel
-    double pitchBendSemitones = 0.0;
-
-    // SmoothedValues pour les paramètres continus (anti-zipper).
-    // Every per-sample multiplier/mix that's exposed to DAW automation or
-    // LFO modulation must go through one of these — block-rate steps are
-    // otherwise audible as zipper / clicks on fast sweeps.
-    juce::SmoothedValue<float> smoothVolume;
-    juce::SmoothedValue<float> smoothCutoff;
-    juce::SmoothedValue<float> smoothMod1Level;
-    juce::SmoothedValue<float> smoothMod2Level;
-    juce::SmoothedValue<float> smoothCarNoise;
-    juce::SmoothedValue<float> smoothCarSpread;
-    juce::SmoothedValue<float> smoothDrive;    // post-filter saturation gain
-    juce::SmoothedValue<float> smoothFold;     // wavefolder amount
-
-    // Smooth global LFO modulation contributions. Each LFO sum is updated
-    // at block rate by PluginProcessor; we smooth the sum itself so that
-    // the LFO's effect on each destination is continuous per-sample.
-    juce::SmoothedValue<float> smoothGLfoPitch;
-    juce::SmoothedValue<float> smoothGLfoCutoff;
-    juce::SmoothedValue<float> smoothGLfoRes;
-    juce::SmoothedValue<float> smoothGLfoVolume;
-    juce::SmoothedValue<float> smoothGLfoDrive;
-    juce::SmoothedValue<float> smoothGLfoMod1Lvl;
-    juce::SmoothedValue<float> smoothGLfoMod2Lvl;
-    juce::SmoothedValue<float> smoothGLfoNoise;
-    juce::SmoothedValue<float> smoothGLfoSpread;
-    juce::SmoothedValue<float> smoothGLfoFold;
+    float trackedLevel = 0.0f;
+    float blockPeakLevel = 0.0f;   // crête du niveau suivi depuis beginBlock
 
     // Cached ADSR params (post-modulation, post-time-macro) per envelope.
     // JUCE's ADSR::setParameters recomputes internal increments on every
@@ -349,25 +669,94 @@ private:
     struct AdsrCache { float a = -1, d = -1, s = -1, r = -1; };
     AdsrCache lastEnv1, lastEnv2, lastEnv3, lastPitchEnv;
 
-    // Filter coefficient cache: skip recalculation when params haven't changed
-    float lastFilterCutoff = -1.0f;
-    float lastFilterRes    = -1.0f;
-
-    // Anti-click fade-out for voice stealing
-    int stealFadeSamples = 0;
-    int stealFadeLength  = 256;   // set properly in prepareToPlay
-
-    // Anti-click fade-in for new notes
-    int noteFadeInSamples = 0;
-    int noteFadeInLength  = 64;   // set properly in prepareToPlay
-
-
-    // White noise generator (xorshift32)
-    // Decorrelated L/R noise (independent seeds for true stereo)
-    uint32_t noiseSeedL = 0x12345678;
-    uint32_t noiseSeedR = 0x9ABCDEF0;
+    // Suréchantillonnage : facteur courant et décimateurs demi-bande L/R
+    int osFactor = 1;
+    OversamplingDecimator decimatorL, decimatorR;
+
+    // Carriers unison : lus par échantillon seulement quand l'unison est
+    // actif, donc hors de HotState (empreinte inchangée sans unison)
+    UnisonStack unisonStack;
+
+    // Rotations des opérateurs rendus en quadrature (sinus sans PM, voir
+    // Oscillator::renderUnmodulatedSine) et des LFOs par voix (sinus à taux
+    // fixe, LFOCore::renderBlock) : lues une fois par sous-bloc
+    struct QuadratureRotations { SineRotation mod1, mod2, carrier, carrierR, lfo1, lfo2; };
+    QuadratureRotations quadrature;
+
+    // Quatrième opérateur (Mod3, enveloppe 4) : même raison, il ne tourne
+    // qu'en mode 4 opérateurs (son niveau lissé est SmoothMod3Level)
+    struct Mod3State
+    {
+        Oscillator osc;
+        ADSREnvelope env;
+        float feedbackSample = 0.0f;
+    };
+    Mod3State mod3;
+    AdsrCache lastEnv4;
+
+    // --- Cache de rendu (NoteCache.h) ---
+    // Armed : note déterministe, décision au premier rendu (après beginBlock)
+    // Record : la sortie de la voix est copiée dans l'entrée
+    // Play : la sortie est relue depuis l'entrée, l'état DSP est figé
+    enum class CacheMode : uint8_t { Off, Armed, Record, Play };
+
+
+    // État DSP qui évolue pendant une note tenue : copié aux instantanés de
+    // l'enregistrement, restauré pour reprendre en rendu direct. Les LFOs
+    // par voix n'y sont pas — une note n'est cachée que si tremor, vein et
+    // flux sont à 0, leur phase n'a alors aucun effet sur le son. Pas de
+    // décimateurs non plus : le cache est réservé au rendu 1×.
+    struct CacheState
+    {
+        BlockSetup block;
+        ControlKernel controlKernel = nullptr;
+        CarrierKernel carrierKernel = nullptr;
+        int postChainOffset = 0;
+        Oscillator mod1Osc, mod2Osc, carrierOsc, carrierOscR;
+        UnisonStack unisonStack;
+        Mod3State mod3;
+        float mod2FeedbackSample = 0.0f;
+        ADSREnvelope env1, env2, env3, pitchEnv;
+        SVFilter filterL, filterR;
+        XORDistortion xorDist;
+        DCBlocker dcBlockerL, dcBlockerR;
+        HemoFold hemoFoldL, hemoFoldR;
+        adaa::Tanh driveShaperL, driveShaperR;
+        double currentFreq = 0.0;
+        SmootherBank<kNumSmoothers> smoothers;
+        AdsrCache lastEnv1, lastEnv2, lastEnv3, lastEnv4, lastPitchEnv;
+        float lastFilterCutoff = -1.0f, lastFilterRes = -1.0f;
+        int noteFadeInSamples = 0;
+    };
+
+    // Applique fn(membre de la voix, copie dans s) à chaque champ de CacheState
+    template <typename Fn>
+    void visitCacheState(CacheState& s, Fn&& fn);
+
+    bool isCacheable() const noexcept;
+    // Empreinte de tout ce qui détermine le rendu à partir de l'état initial
+    uint64_t cacheSignature() const noexcept;
+    // Sert le début du bloc depuis le cache ; retourne le nombre d'échantillons
+    int  renderFromCache(juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples);
+    void startCachedNote(int numSamples);
+    void recordCached(int numSamples);
+    void captureSnapshot();
+    void restoreSnapshot(int index);
+    // Lecture → rendu direct à cachePos (dernier instantané + rattrapage)
+    void leaveCachePlayback();
+    void stopCacheRecording(bool commit);
+    // Quitte le cache quel que soit le mode, l'état reste celui du rendu direct
+    void leaveCache();
+    void releaseCache() noexcept;
+
+    CacheMode cacheMode = CacheMode::Off;
+    NoteCacheEntry* cacheEntry = nullptr;
+    int cachePos = 0;             // échantillons depuis le début de la note
+    int cacheNextSnapshot = 0;
 
     double sampleRate = 44100.0;
 };
 
+constexpr std::size_t FMVoice::getHotStateSize() noexcept { return sizeof(HotState); }
+
 } // namespace bb
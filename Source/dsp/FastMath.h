@@ -0,0 +1,185 @@
+// FastMath.h — Approximations rapides des fonctions transcendantes du DSP
+// Chaque fonction est sans table ni appel libm : réduction d'argument par
+// manipulation de bits + polynôme, arrondi par décalage de mantisse,
+// sélections par masque plutôt que par branchement. Donc inlinable et
+// vectorisable dans les boucles par échantillon (voix, lanes VoiceBank,
+// effets) — une boucle de chaque fonction vectorise en SSE2 avec GCC -O3,
+// sans drapeau fast-math ni cible SSE4.1.
+//
+// Erreurs maximales (mesurées contre libm par tests/test_FastMath.cpp) :
+//   exp2(x)    x ∈ [-126, 127]        erreur relative < 3e-7
+//   log2(x)    x ∈ [1e-6, 2e4]        erreur absolue  < 1e-6
+//   pow(a, b)  a ≥ 0                  erreur relative < 4e-6 (|b·log2 a| ≤ 45)
+//   sin(x)     |x| ≤ 1000             erreur absolue  < 2e-6 (< 2e-7 si |x| ≤ π)
+//   tan(x)     |x| ≤ 0.49·π           erreur relative < 5e-6
+//   tanh(x)    tout x                 erreur absolue  < 2e-7
+//
+// dspmath:: est ce qu'appelle le code DSP : std:: par défaut, fastmath::
+// quand le projet est compilé avec PARASITE_FAST_MATH=1 (option CMake).
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#ifndef PARASITE_FAST_MATH
+ #define PARASITE_FAST_MATH 0
+#endif
+
+namespace bb {
+namespace fastmath {
+
+namespace detail {
+    inline float fromBits(uint32_t b) noexcept { float f; std::memcpy(&f, &b, sizeof f); return f; }
+    inline uint32_t toBits(float f) noexcept   { uint32_t b; std::memcpy(&b, &f, sizeof b); return b; }
+
+    constexpr float kInvPi   = 0.318309886183791f;
+    // π en deux morceaux (Cody-Waite) : kPiHi exact en float
+    constexpr float kPiHi    = 3.140625f;
+    constexpr float kPiLo    = 9.67653589793e-4f;
+    constexpr float kLn2     = 0.693147180559945f;
+    constexpr float kInvLn2  = 1.44269504088896f;
+
+    // Arrondi à l'entier le plus proche (pair en cas d'égalité, comme
+    // nearbyint) pour |x| < 2^22 : ajouter 1.5·2^23 chasse les bits
+    // fractionnaires de la mantisse. Sans appel libm ni SSE4.1 (roundps)
+    inline float roundNearest(float x) noexcept
+    {
+        constexpr float kShift = 12582912.0f;   // 1.5 · 2^23
+        return (x + kShift) - kShift;
+    }
+
+    // c ? a : b par masque de bits. Un ternaire sur des float reste un
+    // branchement pour GCC (-ftrapping-math par défaut), ce qui empêche la
+    // vectorisation de la boucle appelante ; le masque, non
+    inline float select(bool c, float a, float b) noexcept
+    {
+        const uint32_t mask = 0u - static_cast<uint32_t>(c);
+        return fromBits((toBits(a) & mask) | (toBits(b) & ~mask));
+    }
+
+    // Bornage sans appel à fmin / fmax
+    inline float clamp(float x, float lo, float hi) noexcept
+    {
+        x = select(x < lo, lo, x);
+        return select(x > hi, hi, x);
+    }
+
+    inline float absBits(float x) noexcept { return fromBits(toBits(x) & 0x7FFFFFFFu); }
+
+    // sin(r) pour |r| ≤ π/2 : Taylor jusqu'à r^11 (reste < 6e-8)
+    inline float sinPoly(float r) noexcept
+    {
+        const float r2 = r * r;
+        return r * (1.0f + r2 * (-1.66666667e-1f + r2 * (8.33333333e-3f
+                 + r2 * (-1.98412698e-4f + r2 * (2.75573192e-6f + r2 * -2.50521084e-8f)))));
+    }
+
+    // cos(r) pour |r| ≤ π/2 : Taylor jusqu'à r^12 (reste < 7e-9)
+    inline float cosPoly(float r) noexcept
+    {
+        const float r2 = r * r;
+        return 1.0f + r2 * (-0.5f + r2 * (4.16666667e-2f + r2 * (-1.38888889e-3f
+                 + r2 * (2.48015873e-5f + r2 * (-2.75573192e-7f + r2 * 2.08767570e-9f)))));
+    }
+
+    // Réduit x à r ∈ [-π/2, π/2] avec x = r + k·π
+    inline float reducePi(float x, int& k) noexcept
+    {
+        const float kf = roundNearest(x * kInvPi);
+        k = static_cast<int>(kf);
+        return (x - kf * kPiHi) - kf * kPiLo;
+    }
+}
+
+// 2^x : x = n + f avec f ∈ [-0.5, 0.5], 2^f par Taylor d'ordre 6 en f·ln2
+inline float exp2(float x) noexcept
+{
+    x = detail::clamp(x, -126.0f, 127.0f);
+    const float n = detail::roundNearest(x);
+    const float t = (x - n) * detail::kLn2;
+    const float p = 1.0f + t * (1.0f + t * (0.5f + t * (1.66666667e-1f
+                  + t * (4.16666667e-2f + t * (8.33333333e-3f + t * 1.38888889e-3f)))));
+    return p * detail::fromBits(static_cast<uint32_t>(static_cast<int32_t>(n) + 127) << 23);
+}
+
+// log2(x), x > 0 : exposant extrait des bits, mantisse m ∈ [√½, √2),
+// ln(m) = 2·atanh((m-1)/(m+1)) par série impaire jusqu'à s^9
+inline float log2(float x) noexcept
+{
+    uint32_t bits = detail::toBits(x);
+    int e = static_cast<int>((bits >> 23) & 0xFF) - 127;
+    float m = detail::fromBits((bits & 0x007FFFFFu) | 0x3F800000u);
+    const bool high = m > 1.41421356f;
+    m *= detail::select(high, 0.5f, 1.0f);
+    e += high ? 1 : 0;
+
+    const float s  = (m - 1.0f) / (m + 1.0f);
+    const float s2 = s * s;
+    const float lnM = 2.0f * s * (1.0f + s2 * (0.333333333f + s2 * (0.2f
+                    + s2 * (0.142857143f + s2 * 0.111111111f))));
+    return static_cast<float>(e) + lnM * detail::kInvLn2;
+}
+
+// a^b pour a ≥ 0 (pow(0, b) = 0 pour b > 0)
+inline float pow(float a, float b) noexcept
+{
+    return detail::select(a > 0.0f, fastmath::exp2(b * fastmath::log2(a)), 0.0f);
+}
+
+inline float sin(float x) noexcept
+{
+    int k;
+    const float r = detail::reducePi(x, k);
+    const float s = detail::sinPoly(r);
+    return detail::fromBits(detail::toBits(s) ^ (static_cast<uint32_t>(k) << 31));
+}
+
+// Domaine : |x| < π/2 (prewarp des filtres, x = π·fc/sr)
+inline float tan(float x) noexcept
+{
+    int k;
+    const float r = detail::reducePi(x, k);
+    return detail::sinPoly(r) / detail::cosPoly(r);
+}
+
+// tanh via 2^(2x·log2 e) ; Taylor d'ordre 7 près de 0 pour éviter
+// l'annulation de (t - 1). Les deux branches sont calculées puis
+// sélectionnées : pas de saut, la boucle appelante reste vectorisable
+inline float tanh(float x) noexcept
+{
+    const float ax = detail::absBits(x);
+    const float x2 = x * x;
+    const float small = x * (1.0f + x2 * (-0.333333333f + x2 * (0.133333333f + x2 * -0.0539682540f)));
+    const float t = fastmath::exp2(2.0f * detail::kInvLn2 * detail::select(ax < 9.0f, ax, 9.0f));
+    const float y = (t - 1.0f) / (t + 1.0f);
+    const float large = detail::fromBits(detail::toBits(y) | (detail::toBits(x) & 0x80000000u));
+    return detail::select(ax < 0.25f, small, large);
+}
+
+} // namespace fastmath
+
+// --- Sélection exact / rapide pour le code DSP ---
+namespace dspmath {
+
+#if PARASITE_FAST_MATH
+inline float  exp2(float x) noexcept            { return fastmath::exp2(x); }
+inline double exp2(double x) noexcept           { return static_cast<double>(fastmath::exp2(static_cast<float>(x))); }
+inline float  pow(float a, float b) noexcept    { return fastmath::pow(a, b); }
+inline float  sin(float x) noexcept             { return fastmath::sin(x); }
+inline double sin(double x) noexcept            { return static_cast<double>(fastmath::sin(static_cast<float>(x))); }
+inline float  tan(float x) noexcept             { return fastmath::tan(x); }
+inline double tan(double x) noexcept            { return static_cast<double>(fastmath::tan(static_cast<float>(x))); }
+inline float  tanh(float x) noexcept            { return fastmath::tanh(x); }
+#else
+inline float  exp2(float x) noexcept            { return std::exp2(x); }
+inline double exp2(double x) noexcept           { return std::exp2(x); }
+inline float  pow(float a, float b) noexcept    { return std::pow(a, b); }
+inline float  sin(float x) noexcept             { return std::sin(x); }
+inline double sin(double x) noexcept            { return std::sin(x); }
+inline float  tan(float x) noexcept             { return std::tan(x); }
+inline double tan(double x) noexcept            { return std::tan(x); }
+inline float  tanh(float x) noexcept            { return std::tanh(x); }
+#endif
+
+} // namespace dspmath
+} // namespace bb
@@ -0,0 +1,242 @@
+// HalfBand.h — Filtres demi-bande polyphase (FIR à phase linéaire)
+// Un demi-bande a un coefficient sur deux nul (hors centre = 0.5) : en
+// décimation 2→1 on ne calcule que la branche non nulle, soit ~N/4
+// multiplications par échantillon de sortie (coefficients symétriques).
+// En interpolation 1→2 c'est l'inverse : la sortie impaire est un simple
+// retard, la paire la branche latérale (même coût).
+// Tout l'état est dans des tableaux fixes : aucune allocation.
+//
+// Coefficients : sinc demi-bande fenêtré (Kaiser β = 8), ramenés à un gain
+// DC unitaire. Seuls les coefficients latéraux non nuls sont stockés,
+// du plus proche au plus loin du centre.
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace bb {
+
+namespace halfband {
+    // 63 taps : bande passante plate jusqu'à 0.21·fs (−0.002 dB), réjection
+    // −81 dB au-delà de 0.30·fs. Étage final (2× → 1×), ou premier étage
+    // en interpolation (1× → 2×).
+    inline constexpr float kSteep[] = {
+        3.170728513e-01f, -1.024425021e-01f, 5.772404061e-02f, -3.748937911e-02f,
+        2.563768360e-02f, -1.780469905e-02f, 1.231558223e-02f, -8.376209881e-03f,
+        5.543646654e-03f, -3.534414071e-03f, 2.145908431e-03f, -1.222075923e-03f,
+        6.381063336e-04f, -2.935600618e-04f, 1.090362234e-04f, -2.401525086e-05f
+    };
+
+    // 19 taps : suffisant pour 4× ↔ 2×, où seule la bande < 0.105·fs doit
+    // rester propre (−81 dB au-delà de 0.395·fs, le reste retombe dans la
+    // bande de réjection de l'étage final).
+    inline constexpr float kRelaxed[] = {
+        3.039217313e-01f, -6.923445241e-02f, 1.820147746e-02f, -2.971480728e-03f,
+        8.272436386e-05f
+    };
+}
+
+// Décimateur 2→1. NumSide = nombre de coefficients latéraux non nuls
+// (taps = 4·NumSide − 1). La sortie m est calée sur l'entrée paire 2m : le
+// centre du filtre tombe kCenter − 1 entrées avant, soit NumSide − 1
+// échantillons de sortie de latence (entière).
+template <int NumSide>
+class HalfBandDecimator
+{
+public:
+    static constexpr int kTaps = 4 * NumSide - 1;
+    static constexpr int kCenter = (kTaps - 1) / 2;
+    static constexpr int kLatency = NumSide - 1;      // en échantillons de sortie
+
+    explicit HalfBandDecimator(const float (&c)[NumSide]) noexcept : coeffs(c) {}
+
+    void reset() noexcept
+    {
+        std::fill(std::begin(history), std::end(history), 0.0f);
+        pos = 0;
+    }
+
+    // Consomme deux échantillons, en produit un
+    float process(float x0, float x1) noexcept
+    {
+        push(x0);
+        push(x1);
+
+        // Fenêtre des kTaps dernières entrées : w[kTaps - 1] = la plus récente
+        const float* w = history + pos;
+        float acc = 0.5f * w[kTaps - 1 - kCenter];
+        for (int j = 0; j < NumSide; ++j)
+        {
+            const int d = 2 * j + 1;
+            acc += coeffs[j] * (w[kTaps - 1 - kCenter + d] + w[kTaps - 1 - kCenter - d]);
+        }
+        return acc;
+    }
+
+private:
+    // Ligne à retard doublée : chaque écriture va aussi à +kTaps, la
+    // fenêtre est donc toujours contiguë (pas de modulo dans la boucle)
+    void push(float x) noexcept
+    {
+        history[pos] = x;
+        history[pos + kTaps] = x;
+        if (++pos == kTaps)
+            pos = 0;
+    }
+
+    const float (&coeffs)[NumSide];
+    float history[2 * kTaps] {};
+    int pos = 0;
+};
+
+// Interpolateur 1→2 (gain 2 sur le filtre : les zéros insérés divisent le
+// niveau par deux). Latence = 2·NumSide − 1 échantillons de sortie.
+template <int NumSide>
+class HalfBandInterpolator
+{
+public:
+    static constexpr int kTaps = 4 * NumSide - 1;
+    static constexpr int kCenter = (kTaps - 1) / 2;   // latence (sortie)
+
+    explicit HalfBandInterpolator(const float (&c)[NumSide]) noexcept : coeffs(c) {}
+
+    void reset() noexcept
+    {
+        std::fill(std::begin(history), std::end(history), 0.0f);
+        pos = 0;
+    }
+
+    // Consomme un échantillon, en produit deux
+    void process(float x, float& y0, float& y1) noexcept
+    {
+        history[pos] = x;
+        history[pos + kLength] = x;
+        if (++pos == kLength)
+            pos = 0;
+
+        // w[kLength - 1 - d] = entrée retardée de d échantillons
+        const float* w = history + pos;
+        float acc = 0.0f;
+        for (int j = 0; j < NumSide; ++j)
+            acc += coeffs[j] * (w[kLength - NumSide + j] + w[kLength - 1 - NumSide - j]);
+        y0 = 2.0f * acc;
+        y1 = w[kLength - NumSide];
+    }
+
+private:
+    static constexpr int kLength = 2 * NumSide;   // entrées couvertes
+
+    const float (&coeffs)[NumSide];
+    float history[2 * kLength] {};
+    int pos = 0;
+};
+
+// Décimation 2× ou 4× d'un signal suréchantillonné vers le taux de base :
+// étage 19 taps (4× → 2×) puis étage 63 taps (2× → 1×).
+class OversamplingDecimator
+{
+public:
+    static constexpr int kMaxFactor = 4;
+
+    void reset() noexcept
+    {
+        stage4.reset();
+        stage2.reset();
+    }
+
+    // in : numOut × factor échantillons, out : numOut échantillons
+    void process(const float* in, float* out, int numOut, int factor) noexcept
+    {
+        if (factor == 4)
+        {
+            for (int i = 0; i < numOut; ++i)
+            {
+                const float* x = in + 4 * i;
+                float a = stage4.process(x[0], x[1]);
+                float b = stage4.process(x[2], x[3]);
+                out[i] = stage2.process(a, b);
+            }
+        }
+        else if (factor == 2)
+        {
+            for (int i = 0; i < numOut; ++i)
+                out[i] = stage2.process(in[2 * i], in[2 * i + 1]);
+        }
+        else
+        {
+            std::copy(in, in + numOut, out);
+        }
+    }
+
+    // Retard de groupe en échantillons du taux de base (à reporter à l'hôte).
+    // En 4×, le retard du premier étage est compté au taux 2× puis réduit.
+    static constexpr int latency(int factor) noexcept
+    {
+        return factor == 4 ? Steep::kLatency + Relaxed::kLatency / 2
+             : factor == 2 ? Steep::kLatency
+             : 0;
+    }
+
+private:
+    using Steep   = HalfBandDecimator<static_cast<int>(std::size(halfband::kSteep))>;
+    using Relaxed = HalfBandDecimator<static_cast<int>(std::size(halfband::kRelaxed))>;
+
+    Relaxed stage4 { halfband::kRelaxed };
+    Steep   stage2 { halfband::kSteep };
+};
+
+// Interpolation 2× ou 4× du taux de base vers un taux supérieur : étage
+// 63 taps (1× → 2×) puis étage 19 taps (2× → 4×). Symétrique du décimateur.
+class OversamplingInterpolator
+{
+public:
+    static constexpr int kMaxFactor = 4;
+
+    void reset() noexcept
+    {
+        stage2.reset();
+        stage4.reset();
+    }
+
+    // in : numIn échantillons, out : numIn × factor échantillons
+    void process(const float* in, float* out, int numIn, int factor) noexcept
+    {
+        if (factor == 4)
+        {
+            for (int i = 0; i < numIn; ++i)
+            {
+                float a, b;
+                stage2.process(in[i], a, b);
+                float* y = out + 4 * i;
+                stage4.process(a, y[0], y[1]);
+                stage4.process(b, y[2], y[3]);
+            }
+        }
+        else if (factor == 2)
+        {
+            for (int i = 0; i < numIn; ++i)
+                stage2.process(in[i], out[2 * i], out[2 * i + 1]);
+        }
+        else
+        {
+            std::copy(in, in + numIn, out);
+        }
+    }
+
+    // Retard de groupe en échantillons du taux de sortie
+    static constexpr int latency(int factor) noexcept
+    {
+        return factor == 4 ? Steep::kCenter * 2 + Relaxed::kCenter
+             : factor == 2 ? Steep::kCenter
+             : 0;
+    }
+
+private:
+    using Steep   = HalfBandInterpolator<static_cast<int>(std::size(halfband::kSteep))>;
+    using Relaxed = HalfBandInterpolator<static_cast<int>(std::size(halfband::kRelaxed))>;
+
+    Steep   stage2 { halfband::kSteep };
+    Relaxed stage4 { halfband::kRelaxed };
+};
+
+} // namespace bb
@@ -1,6 +1,6 @@
 // HarmonicTable.h — 32-harmonic additive wavetable with double-buffered atomic swap
 // GUI thread writes harmonics + rebakes wavetable; audio thread reads via lookup()
-// Same zero-overhead pattern as SineTable: linear interpolation on a 4096-sample cycle
+// Linear interpolation on a 4096-sample cycle
 #pragma once
 #include <array>
 #include <atomic>
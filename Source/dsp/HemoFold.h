@@ -3,9 +3,13 @@
 // Low amount: subtle harmonic enrichment (even + odd harmonics)
 // Mid amount: rich complex timbres with asymmetric folding
 // High amount: chaotic metallic textures with internal feedback
+// Antialias : chaque étage en ADAA du premier ordre (voir Adaa.h), le dry
+// passant par les mêmes moyennes pour rester aligné avec le wet
 #pragma once
 #include <cmath>
 #include <algorithm>
+#include "Adaa.h"
+#include "FastMath.h"
 
 namespace bb {
 
@@ -24,18 +28,31 @@ public:
         prevOutput = 0.0f;
         dcX1 = 0.0f;
         dcY1 = 0.0f;
+        foldX1 = 0.0f;
+        refoldX1 = 0.0f;
+        satX1 = 0.0f;
+        satStage.reset();
+        dry1 = dry2 = dry3 = 0.0f;
     }
 
+    // ADAA (premier ordre) sur les trois étages de pliage
+    void setAntialias(bool shouldAntialias) { antialias = shouldAntialias; }
+
     // amount: 0-1
     void setAmount(float a)
     {
         amount = std::max(0.0f, std::min(a, 1.0f));
     }
 
+    // En dessous de 0.001 tick() renvoie l'entrée telle quelle
+    bool isActive() const { return amount >= 0.001f; }
+
     float tick(float input)
     {
         if (amount < 0.001f)
             return input;
+        if (antialias)
+            return tickAntialiased(input);
 
         // Input gain drives the signal into folding territory
         // Exponential scaling for musical response: 1x → 16x
@@ -55,14 +72,14 @@ public:
         // === Stage 1: Sine fold (always active) ===
         // The fundamental wavefolder: sin(x) wraps the waveform musically
         // pi/2 scaling means ±1 input maps to full sine cycle
-        signal = std::sin(signal * kPi * 0.5f);
+        signal = dspmath::sin(signal * kPi * 0.5f);
 
         // === Stage 2: Secondary fold (kicks in at 0.3+) ===
         // Re-folds the already-folded signal for more complex harmonics
         if (amount > 0.3f)
         {
             float blend = (amount - 0.3f) * (1.0f / 0.7f); // 0→1 over 0.3→1.0
-            float folded = std::sin(signal * kPi); // second fold pass
+            float folded = dspmath::sin(signal * kPi); // second fold pass
             signal += (folded - signal) * blend * 0.5f;
         }
 
@@ -71,7 +88,7 @@ public:
         if (amount > 0.6f)
         {
             float blend = (amount - 0.6f) * (1.0f / 0.4f); // 0→1 over 0.6→1.0
-            float saturated = std::tanh(signal * 2.5f);
+            float saturated = dspmath::tanh(signal * 2.5f);
             signal += (saturated - signal) * blend;
         }
 
@@ -92,8 +109,74 @@ public:
     }
 
 private:
+    friend class VoiceBank; // accès SoA direct à l'état (rendu par lanes)
+
     static constexpr float kPi = 3.14159265358979f;
 
+    // Même chaîne que tick(), chaque étage remplacé par sa moyenne sur
+    // l'intervalle entre deux échantillons. Les états d'entrée des étages
+    // 2 et 3 suivent le signal même quand l'étage est inactif.
+    float tickAntialiased(float input)
+    {
+        float gain = 1.0f + amount * amount * 15.0f;
+        float fb = amount * amount * 0.35f;
+        float bias = amount * 0.15f;
+        float signal = input * gain + prevOutput * fb + bias;
+
+        // Stage 1: sine fold
+        float x = signal;
+        signal = adaa::sinFirstOrder(x, foldX1, kPi * 0.5f);
+        foldX1 = x;
+        int stages = 1;
+
+        // Stage 2: secondary fold — partie linéaire moyennée elle aussi
+        x = signal;
+        if (amount > 0.3f)
+        {
+            float blend = (amount - 0.3f) * (1.0f / 0.7f);
+            float mid = 0.5f * (x + refoldX1);
+            float folded = adaa::sinFirstOrder(x, refoldX1, kPi);
+            signal = mid + (folded - mid) * blend * 0.5f;
+            ++stages;
+        }
+        refoldX1 = x;
+
+        // Stage 3: tanh saturation fold (mean of tanh(2.5·x) = ADAA sur 2.5·x)
+        x = signal;
+        if (amount > 0.6f)
+        {
+            float blend = (amount - 0.6f) * (1.0f / 0.4f);
+            float mid = 0.5f * (x + satX1);
+            float saturated = satStage.process(x * 2.5f);
+            signal = mid + (saturated - mid) * blend;
+            ++stages;
+        }
+        else
+        {
+            satStage.track(x * 2.5f);
+        }
+        satX1 = x;
+
+        prevOutput = signal;
+        signal -= bias;
+
+        float dcOut = signal - dcX1 + dcCoeff * dcY1;
+        dcX1 = signal;
+        dcY1 = dcOut;
+        signal = dcOut;
+
+        // Dry retardé comme le wet : une moyenne de 2 par étage ADAA
+        // (coefficients binomiaux, retard de 0.5 / 1 / 1.5 échantillon)
+        float dry = stages == 1 ? 0.5f * (input + dry1)
+                  : stages == 2 ? 0.25f * (input + dry2) + 0.5f * dry1
+                  : 0.125f * (input + dry3) + 0.375f * (dry1 + dry2);
+        dry3 = dry2;
+        dry2 = dry1;
+        dry1 = input;
+
+        return dry + (signal - dry) * amount;
+    }
+
     // DC blocker coefficient: R = 1 - (2*pi*5/sr), computed in prepare()
     float dcCoeff = 0.9993f;
     float amount = 0.0f;
@@ -102,6 +185,12 @@ private:
     // DC blocker state
     float dcX1 = 0.0f;
     float dcY1 = 0.0f;
+
+    // ADAA : entrée précédente de chaque étage + historique du dry
+    bool antialias = false;
+    float foldX1 = 0.0f, refoldX1 = 0.0f, satX1 = 0.0f;
+    adaa::Tanh satStage;
+    float dry1 = 0.0f, dry2 = 0.0f, dry3 = 0.0f;
 };
 
 } // namespace bb
@@ -29,19 +29,13 @@ struct CurvePoint
     bool operator!=(const CurvePoint& o) const noexcept { return !(*this == o); }
 };
 
-class LFO
+// Cœur d'un LFO : phase, taux et formes d'onde standard. Quelques dizaines
+// d'octets, copiable, sans table custom ni courbe — c'est ce que portent
+// les voix (LFOs par voix, Sine fixe). LFO ajoute par-dessus la table
+// dessinable et son édition, utilisées seulement par les LFOs globaux.
+class LFOCore
 {
 public:
-    static constexpr int kNumSteps = 32;
-
-    LFO()
-    {
-        for (int i = 0; i < kNumSteps; ++i)
-            customTable[i].store(0.5f, std::memory_order_relaxed);
-        customTablePeak.store(0.5f, std::memory_order_relaxed);
-        curvePoints = { {0.0f, 0.5f}, {1.0f, 0.5f} };
-    }
-
     void prepare(double sampleRate) noexcept
     {
         sr = sampleRate;
@@ -56,13 +50,15 @@ public:
     }
 
     void setWaveType(LFOWaveType type) noexcept { waveType = type; }
+    LFOWaveType getWaveType() const noexcept { return waveType; }
 
     void resetPhase() noexcept { phase = 0.0; }
 
     // Per-sample tick (for per-voice LFOs called every sample)
     float tick() noexcept { return tickBlock(1); }
 
-    // Returns a value in [-1, +1], called once per audio block
+    // Returns a value in [-1, +1], called once per audio block.
+    // Custom n'a pas de table ici : sortie 0, la phase avance quand même.
     float tickBlock(int numSamples) noexcept
     {
         float out = 0.0f;
@@ -70,7 +66,7 @@ public:
         switch (waveType)
         {
         case LFOWaveType::Sine:
-            out = Oscillator::lookupSinePublic(phase);
+            out = Oscillator::sineCycles(phase);
             break;
 
         case LFOWaveType::Triangle:
@@ -103,39 +99,96 @@ public:
             break;
         }
 
-        case LFOWaveType::Custom:
-        {
-            // Use baked atomic table for thread safety (curvePoints is GUI-only)
-            float t = std::clamp(static_cast<float>(phase), 0.0f, 1.0f);
-            float idx = t * static_cast<float>(kNumSteps - 1);
-            int i0 = static_cast<int>(idx);
-            int i1 = std::min(i0 + 1, kNumSteps - 1);
-            float frac = idx - static_cast<float>(i0);
-            float v = customTable[i0].load(std::memory_order_relaxed) * (1.0f - frac)
-                    + customTable[i1].load(std::memory_order_relaxed) * frac;
-            out = v * 2.0f - 1.0f; // [0,1] -> [-1,+1]
+        default:
             break;
         }
 
-        default:
-            break;
+        advance(numSamples);
+        return out;
+    }
+
+    // numSamples tick() d'affilée. Sine : récurrence en quadrature
+    // (QuadratureSine.h), repartie de la phase exacte à chaque appel
+    void renderBlock(float* out, int numSamples, SineRotation& rotation) noexcept
+    {
+        if (waveType != LFOWaveType::Sine)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                out[i] = tick();
+            return;
         }
+        rotation.setIncrement(rate / sr);
+        renderQuadratureSine(out, numSamples, phase, rotation);
+        advance(numSamples);
+    }
 
-        // Advance phase by the full block duration
+    // Advance phase by the full block duration
+    void advance(int numSamples) noexcept
+    {
         phase += (rate * numSamples) / sr;
         phase -= std::floor(phase);
-
-        return out;
     }
 
     float getPhase() const noexcept { return static_cast<float>(phase); }
 
+private:
+    double sr = 44100.0;
+    double rate = 1.0;   // Hz
+    double phase = 0.0;
+    LFOWaveType waveType = LFOWaveType::Sine;
+
+    // Sample & Hold (xorshift32 — lightweight, no heap, audio-safe)
+    float sAndHValue = 0.0f;
+    bool prevPhaseWasHigh = false;
+    uint32_t sAndHSeed = 0x12345678 + static_cast<uint32_t>(reinterpret_cast<uintptr_t>(this) & 0xFFFF);
+};
+
+class LFO
+{
+public:
+    static constexpr int kNumSteps = 32;
+
+    LFO()
+    {
+        for (int i = 0; i < kNumSteps; ++i)
+            customTable[i].store(0.5f, std::memory_order_relaxed);
+        customTablePeak.store(0.5f, std::memory_order_relaxed);
+        curvePoints = { {0.0f, 0.5f}, {1.0f, 0.5f} };
+    }
+
+    void prepare(double sampleRate) noexcept { core.prepare(sampleRate); }
+    void setRate(float rateHz) noexcept { core.setRate(rateHz); }
+    void setWaveType(LFOWaveType type) noexcept { core.setWaveType(type); }
+    void resetPhase() noexcept { core.resetPhase(); }
+
+    float tick() noexcept { return tickBlock(1); }
+
+    // Returns a value in [-1, +1], called once per audio block
+    float tickBlock(int numSamples) noexcept
+    {
+        if (core.getWaveType() != LFOWaveType::Custom)
+            return core.tickBlock(numSamples);
+
+        // Use baked atomic table for thread safety (curvePoints is GUI-only)
+        float t = std::clamp(core.getPhase(), 0.0f, 1.0f);
+        float idx = t * static_cast<float>(kNumSteps - 1);
+        int i0 = static_cast<int>(idx);
+        int i1 = std::min(i0 + 1, kNumSteps - 1);
+        float frac = idx - static_cast<float>(i0);
+        float v = customTable[i0].load(std::memory_order_relaxed) * (1.0f - frac)
+                + customTable[i1].load(std::memory_order_relaxed) * frac;
+        core.advance(numSamples);
+        return v * 2.0f - 1.0f; // [0,1] -> [-1,+1]
+    }
+
+    float getPhase() const noexcept { return core.getPhase(); }
+
     // Peak of current waveform in unipolar [0,1] space. Cached by
     // bakeToTable / setStep so the audio-thread read is a single atomic
     // load instead of 32.
     float getUniPeak() const noexcept
     {
-        if (waveType != LFOWaveType::Custom)
+        if (core.getWaveType() != LFOWaveType::Custom)
             return 1.0f; // standard waveforms always reach full range
         return customTablePeak.load(std::memory_order_relaxed);
     }
@@ -315,15 +368,7 @@ public:
     }
 
 private:
-    double sr = 44100.0;
-    double rate = 1.0;   // Hz
-    double phase = 0.0;
-    LFOWaveType waveType = LFOWaveType::Sine;
-
-    // Sample & Hold (xorshift32 — lightweight, no heap, audio-safe)
-    float sAndHValue = 0.0f;
-    bool prevPhaseWasHigh = false;
-    uint32_t sAndHSeed = 0x12345678 + static_cast<uint32_t>(reinterpret_cast<uintptr_t>(this) & 0xFFFF);
+    LFOCore core;
 
     // Custom drawable table (32 steps, [0,1])
     std::array<std::atomic<float>, kNumSteps> customTable;
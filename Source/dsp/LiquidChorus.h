@@ -8,6 +8,8 @@
 #include <cmath>
 #include <algorithm>
 #include <cstdint>
+#include "FastMath.h"
+#include "BlockNoise.h"
 
 namespace bb {
 
@@ -37,6 +39,8 @@ public:
         }
 
         rngState = 77777u;
+        noiseGen[0].seed(1);
+        noiseGen[1].seed(2);
         for (int d = 0; d < kNum; ++d)
         {
             float r = rng();
@@ -84,6 +88,15 @@ public:
 
         for (int i = 0; i < numSamples; ++i)
         {
+            // Bruit d'entrée tiré par tranches de kNoiseBlock (un flux par canal)
+            const int k = i & (kNoiseBlock - 1);
+            if (k == 0)
+            {
+                const int n = std::min(kNoiseBlock, numSamples - i);
+                noiseGen[0].fill(noiseBlock[0], n);
+                noiseGen[1].fill(noiseBlock[1], n);
+            }
+
             // --- Shared droplet random walks ---
             for (int d = 0; d < kNum; ++d)
             {
@@ -118,7 +131,7 @@ public:
             {
                 float fBase = std::clamp(freq[d], 30.0f, srf * 0.45f);
                 float ang = pi * fBase / srf;
-                float g0 = std::tan(ang);
+                float g0 = dspmath::tan(ang);
                 gSvf[0][d] = g0;
                 float detune = (d & 1) ? 0.015f : -0.015f;
                 gSvf[1][d] = g0 + ang * detune * (1.0f + g0 * g0);
@@ -135,7 +148,7 @@ public:
                 envState[ch] = ec * envState[ch] + (1.0f - ec) * absIn;
 
                 // Filter bank input: signal + tiny gated noise + feedback
-                float noise = (rng() * 2.0f - 1.0f) * envState[ch] * noiseAmt;
+                float noise = noiseBlock[ch][k] * envState[ch] * noiseAmt;
                 float in = dry + noise + fbState[ch] * fbAmt;
 
                 // Accumulate droplet outputs
@@ -168,7 +181,7 @@ public:
                 // Gain + envelope gate + gentle soft limit (ASMR: softer output)
                 float gain = 0.8f + density * 1.2f;
                 sum *= gain / static_cast<float>(kNum);
-                sum = std::tanh(sum);
+                sum = dspmath::tanh(sum);
 
                 // Gate feedback by input envelope — dies when input stops
                 float envGate = std::min(envState[ch] * 20.0f, 1.0f);
@@ -228,6 +241,11 @@ private:
     float fbAmt    = 0.0f;
     float noiseAmt = 0.0f;
 
+    // Bruit d'entrée du banc (gated par l'enveloppe)
+    static constexpr int kNoiseBlock = 64;
+    BlockNoise noiseGen[2] { BlockNoise(1), BlockNoise(2) };
+    float noiseBlock[2][kNoiseBlock] {};
+
     // Parameters
     float Q         = 10.0f;
     float speed     = 0.5f;
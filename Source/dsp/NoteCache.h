@@ -0,0 +1,150 @@
+// NoteCache.h — Cache de rendu des notes répétées (percussions)
+// Une note dont le rendu ne dépend que du patch, de la note et de la
+// vélocité (voix au repos, phases remises à zéro, ni drift, ni bruit, ni
+// LFO par voix, pas de glide) produit le même signal à chaque frappe. La
+// première frappe enregistre les kWindowSeconds premières secondes de la
+// sortie de la voix, avec un instantané de son état DSP tous les
+// kSnapshotStride échantillons ; les frappes suivantes relisent l'audio au
+// lieu de le synthétiser.
+//
+// Tenue au-delà de la fenêtre, la voix restaure le dernier instantané et
+// continue en rendu direct : le raccord est exact, sans fondu. Relâchée,
+// modulée ou volée plus tôt, elle repart de l'instantané précédent et
+// rattrape les échantillons manquants (< kSnapshotStride) sans les sortir.
+// Une entrée terminée trop tôt (note courte) est prolongée par la première
+// frappe tenue plus longtemps.
+//
+// Tout est alloué dans prepare() ; le thread audio ne fait que chercher,
+// lire et écrire dans des entrées fixes (remplacement LRU).
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "FMVoice.h"
+
+namespace bb {
+
+struct NoteCacheEntry
+{
+    uint64_t signature = 0;
+    bool valid = false;
+    bool recording = false;   // une voix y écrit encore
+    int users = 0;            // voix qui lisent ou écrivent l'entrée
+    uint64_t lastUse = 0;
+
+    std::vector<float> left, right;
+    std::vector<FMVoice::CacheState> snapshots;
+    std::vector<int> snapshotPos;
+    int numSnapshots = 0;
+
+    // L'audio n'est relisible que jusqu'au dernier instantané (point de reprise)
+    int playableLength() const noexcept
+    {
+        return numSnapshots > 0 ? snapshotPos[static_cast<size_t>(numSnapshots - 1)] : 0;
+    }
+
+    // Dernier instantané à ou avant pos
+    int snapshotBefore(int pos) const noexcept
+    {
+        int index = 0;
+        while (index + 1 < numSnapshots && snapshotPos[static_cast<size_t>(index + 1)] <= pos)
+            ++index;
+        return index;
+    }
+};
+
+class NoteCache
+{
+public:
+    static constexpr double kWindowSeconds = 0.1;
+    static constexpr int kNumEntries = 32;
+    static constexpr int kSnapshotStride = 8 * FMVoice::kControlBlock;
+
+    void prepare(double sampleRate)
+    {
+        windowSamples = std::max(FMVoice::kControlBlock,
+                                 static_cast<int>(sampleRate * kWindowSeconds));
+        // Un sous-bloc peut dépasser la fenêtre ; un instantané au début,
+        // un par pas, un à la fin, plus une réserve pour les prolongations
+        const auto capacity = static_cast<size_t>(windowSamples + FMVoice::kControlBlock);
+        const auto maxSnapshots = static_cast<size_t>(windowSamples / kSnapshotStride + 4);
+
+        for (auto& e : entries)
+        {
+            e.signature = 0;
+            e.valid = false;
+            e.recording = false;
+            e.users = 0;
+            e.lastUse = 0;
+            e.left.assign(capacity, 0.0f);
+            e.right.assign(capacity, 0.0f);
+            e.snapshots.resize(maxSnapshots);
+            e.snapshotPos.assign(maxSnapshots, 0);
+            e.numSnapshots = 0;
+        }
+        clock = 0;
+        hits = 0;
+    }
+
+    int getWindowSamples() const noexcept { return windowSamples; }
+    uint64_t getHitCount() const noexcept { return hits; }
+
+    // Entrée existante pour cette signature, nullptr sinon
+    NoteCacheEntry* find(uint64_t signature) noexcept
+    {
+        for (auto& e : entries)
+        {
+            if (e.valid && e.signature == signature)
+            {
+                e.lastUse = ++clock;
+                ++e.users;
+                ++hits;
+                return &e;
+            }
+        }
+        return nullptr;
+    }
+
+    // Entrée libre la moins récemment utilisée, vidée pour un nouvel
+    // enregistrement. nullptr si toutes sont en cours d'utilisation.
+    NoteCacheEntry* acquire(uint64_t signature) noexcept
+    {
+        NoteCacheEntry* victim = nullptr;
+        for (auto& e : entries)
+        {
+            if (e.users > 0)
+                continue;
+            if (!e.valid)
+            {
+                victim = &e;
+                break;
+            }
+            if (victim == nullptr || e.lastUse < victim->lastUse)
+                victim = &e;
+        }
+        if (victim == nullptr || windowSamples == 0)
+            return nullptr;
+
+        victim->signature = signature;
+        victim->valid = true;
+        victim->recording = true;
+        victim->users = 1;
+        victim->lastUse = ++clock;
+        victim->numSnapshots = 0;
+        return victim;
+    }
+
+    void release(NoteCacheEntry& e) noexcept
+    {
+        e.users = std::max(0, e.users - 1);
+    }
+
+private:
+    std::array<NoteCacheEntry, kNumEntries> entries;
+    int windowSamples = 0;
+    uint64_t clock = 0;
+    uint64_t hits = 0;
+};
+
+} // namespace bb
@@ -0,0 +1,81 @@
+// OperatorGraph.h — Algorithmes 4 opérateurs (mode matrice, MOD3_ON)
+// Chaque algorithme est une description constexpr du graphe de
+// modulation : pour chaque opérateur, le masque des opérateurs qui le
+// modulent, et le masque de ceux envoyés en sortie audio. FMVoice en
+// instancie un noyau par (algorithme, opérateurs actifs) : les sommes de
+// PM sont dépliées à la compilation, aucune matrice n'est évaluée par
+// échantillon.
+//
+// Opérateurs (numérotation TX81Z) : 0 = Carrier (op 1), 1 = Mod1 (op 2),
+// 2 = Mod2 (op 3), 3 = Mod3 (op 4, avec feedback). La modulation va
+// toujours d'un index haut vers un index bas, donc l'ordre d'évaluation
+// est fixe : Mod3, Mod2, Mod1, puis la PM du carrier.
+#pragma once
+#include <array>
+#include <cstdint>
+
+namespace bb {
+
+struct OperatorRoute
+{
+    std::array<uint8_t, 4> mods {};   // bit j : l'opérateur j module l'opérateur k
+    uint8_t out = 0;                  // bit j : opérateur j en sortie (le carrier l'est toujours)
+};
+
+namespace opgraph {
+
+constexpr int kNumOperators = 4;
+constexpr int kNumAlgos = 8;
+constexpr uint8_t bit(int op) { return static_cast<uint8_t>(1u << op); }
+
+// Les 8 algorithmes 4 opérateurs (ordre TX81Z / DX21)
+constexpr std::array<OperatorRoute, kNumAlgos> kRoutes {{
+    { { bit(1), bit(2), bit(3), 0 }, 0 },                              // 1 : 4 → 3 → 2 → 1
+    { { bit(1), bit(2) | bit(3), 0, 0 }, 0 },                          // 2 : (3 + 4) → 2 → 1
+    { { bit(1) | bit(3), bit(2), 0, 0 }, 0 },                          // 3 : 3 → 2 → 1, 4 → 1
+    { { bit(1) | bit(2), 0, bit(3), 0 }, 0 },                          // 4 : 2 → 1, 4 → 3 → 1
+    { { bit(1), 0, bit(3), 0 }, bit(2) },                              // 5 : 2 → 1 | 4 → 3
+    { { bit(3), bit(3), bit(3), 0 }, static_cast<uint8_t>(bit(1) | bit(2)) }, // 6 : 4 → 1, 2, 3
+    { { 0, 0, bit(3), 0 }, static_cast<uint8_t>(bit(1) | bit(2)) },     // 7 : 4 → 3 | 2 | 1
+    { { 0, 0, 0, 0 }, static_cast<uint8_t>(bit(1) | bit(2) | bit(3)) }, // 8 : 1 | 2 | 3 | 4
+}};
+
+constexpr bool isValid(const OperatorRoute& r)
+{
+    for (int k = 0; k < kNumOperators; ++k)
+        if ((r.mods[static_cast<std::size_t>(k)] & ((2u << k) - 1u)) != 0)
+            return false;   // modulation vers un index plus haut (ou soi-même)
+    return (r.out & bit(0)) == 0;
+}
+
+constexpr bool allValid()
+{
+    for (const auto& r : kRoutes)
+        if (!isValid(r))
+            return false;
+    return true;
+}
+static_assert(allValid(), "operators may only modulate lower-numbered operators");
+
+// Opérateurs à rendre : actifs (niveau et enveloppe non nuls sur le
+// sous-bloc) et qui atteignent la sortie, directement ou via un opérateur
+// lui-même rendu. Le carrier est toujours rendu. Les autres sont élagués :
+// leur phase avance sans calcul de forme d'onde.
+constexpr unsigned liveOperators(const OperatorRoute& r, unsigned active)
+{
+    unsigned live = bit(0);
+    for (int j = 1; j < kNumOperators; ++j)
+    {
+        if ((active & bit(j)) == 0)
+            continue;
+        bool reaches = (r.out & bit(j)) != 0;
+        for (int k = 0; k < j; ++k)
+            reaches |= (live & bit(k)) != 0 && (r.mods[static_cast<std::size_t>(k)] & bit(j)) != 0;
+        if (reaches)
+            live |= bit(j);
+    }
+    return live;
+}
+
+} // namespace opgraph
+} // namespace bb
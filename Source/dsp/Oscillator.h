@@ -1,59 +1,80 @@
-// Oscillator.h — Oscillateur avec phase accumulator, PolyBLEP et entrée PM
-// Phase accumulator : phase += freq/sampleRate, wrap à [0,1)
-// PolyBLEP : correction polynomiale aux discontinuités (saw, square, pulse)
+// Oscillator.h — Oscillateur avec phase accumulator, minBLEP et entrée PM
+// Phase accumulator : phase += freq/sampleRate, wrap à [0,1) (double) ou
+// par débordement (virgule fixe 32 bits, PARASITE_FIXED_PHASE)
+// minBLEP / minBLAMP : résidus tabulés (MinBlep.h) ajoutés aux sauts
+// (saw, square, pulse), aux coins (triangle) et aux resets de hard sync
 // PM : on ajoute un offset de phase venant des modulateurs FM
 #pragma once
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <array>
 #include <atomic>
+#include <algorithm>
+#include <type_traits>
 #include "HarmonicTable.h"
+#include "BlockNoise.h"
+#include "MinBlep.h"
+#include "QuadratureSine.h"
 
 namespace bb {
 
 // --- Types de forme d'onde ---
 enum class WaveType : int { Sine = 0, Saw, Square, Triangle, Pulse, Custom, Noise, Count };
 
-// --- Table de sinus précalculée (constexpr) ---
-// 4096 échantillons = bon compromis précision/cache
-constexpr int SINE_TABLE_SIZE = 4096;
-
-struct SineTable
-{
-    std::array<float, SINE_TABLE_SIZE + 1> data {}; // +1 pour interpolation linéaire
-
-    SineTable()
-    {
-        for (int i = 0; i <= SINE_TABLE_SIZE; ++i)
-            data[i] = static_cast<float>(
-                std::sin(2.0 * 3.14159265358979323846 * static_cast<double>(i)
-                         / static_cast<double>(SINE_TABLE_SIZE)));
-    }
-};
-
-// Instance statique globale (Meyers singleton pour thread-safety)
-inline const SineTable& getSineTable()
+// --- Sinus polynomial (sans table) ---
+// sin(π·z) pour z ∈ [-1, 1] : z·(1 − z)·(1 + z)·P(z²), P de degré 5 ajusté
+// en minimax. Erreur < 2.3e-7 en float, l'ordre de l'interpolation linéaire
+// sur 4096 points qu'il remplace. Ni index ni branche : les boucles par
+// lane (VoiceBank, UnisonStack) le vectorisent, une table en ferait un gather.
+inline float sinPiPoly(float z) noexcept
 {
-    static const SineTable table;
-    return table;
+    const float u = z * z;
+    float p = -3.898159193e-04f;
+    p = p * u + 6.867921911e-03f;
+    p = p * u - 7.519222051e-02f;
+    p = p * u + 5.240371823e-01f;
+    p = p * u - 2.026119471e+00f;
+    p = p * u + 3.141592741e+00f;
+    return z * ((1.0f - z) * (1.0f + z)) * p;
 }
 
 // --- Oscillateur ---
-class Oscillator
+// Le type de phase est un paramètre du template :
+//   double   : phase ∈ [0, 1), wrap par floor — chemin de référence
+//   uint32_t : virgule fixe 0.32, 2^32 = un cycle. Le wrap est gratuit
+//              (débordement entier), le sinus lit la phase comme un
+//              entier signé, les formes limitées en bande en float.
+// `Oscillator` (plus bas) choisit l'un ou l'autre selon PARASITE_FIXED_PHASE.
+template <typename PhaseT>
+class BasicOscillator
 {
+    static_assert(std::is_same_v<PhaseT, double> || std::is_same_v<PhaseT, uint32_t>,
+                  "phase must be double or uint32_t");
+
 public:
+    using Phase = PhaseT;
+    static constexpr bool kFixedPhase = std::is_same_v<PhaseT, uint32_t>;
+    // Précision des calculs de forme d'onde (formes limitées en bande)
+    using Sample = std::conditional_t<kFixedPhase, float, double>;
+
     void prepare(double sampleRate) noexcept
     {
         sr = sampleRate;
-        phase = 0.0;
+        phase = Phase(0);
         syncPulse = false;
-        triIntegrator = 0.0;
+        clearSyncResidual();
+        driftCountdown = 0;
+        getMinBlepTable(); // tables construites ici, pas sur le thread audio
     }
 
+    // Change le taux sans toucher à la phase (suréchantillonnage du carrier)
+    void setSampleRate(double sampleRate) noexcept { sr = sampleRate; }
+
     void setFrequency(double freqHz) noexcept
     {
         freq = freqHz;
-        inc = freq / sr;
+        inc = incrementFor(freq, sr);
     }
 
     void setWaveType(WaveType type) noexcept { waveType = type; }
@@ -61,6 +82,10 @@ public:
 
     // Analog drift: slow random pitch wandering (0 = clean, 1 = max drift)
     void setDrift(float amount) noexcept { driftAmount = amount; }
+    // Flux de la forme Noise (rendus reproductibles)
+    void seedNoise(uint32_t stream) noexcept { noise.seed(stream); }
+    // Drift sin evaluated every `step` samples and linearly interpolated (1 = per sample)
+    void setDriftStep(int step) noexcept { driftStep = std::max(1, step); }
 
     // Avancer d'un échantillon avec modulation de phase externe
     // phaseModulation est en radians (convention Yamaha), on divise par 2π
@@ -82,70 +107,273 @@ public:
             // 0.0 = clean, 0.5 = warm analog, 1.0 = experimental wobble
             double amount = static_cast<double>(driftAmount);
             amount *= amount; // exponential curve: subtle at low, wild at high
-            driftOffset = amount * 0.04
-                        * std::sin(driftLFOPhase * 2.0 * 3.14159265358979323846);
+            driftOffset = amount * 0.04 * nextDriftSin();
         }
 
-        // Calcul de la phase modulée
-        double modPhase = phase + phaseModulation / (2.0 * 3.14159265358979323846) + driftOffset;
-        modPhase -= std::floor(modPhase); // wrap [0,1)
+        // Calcul de la phase modulée (offset gardé pour le hard sync)
+        readOffset = phaseModulation / (2.0 * 3.14159265358979323846) + driftOffset;
+        const Phase modPhase = offsetPhase(phase, readOffset);
 
         float out = renderWave(waveType, modPhase);
 
+        // Reset de sync récent : résidu minBLEP du saut
+        if (syncAge < static_cast<float>(MinBlepTable::kLength))
+            out += syncJump * getMinBlepTable().step(syncAge);
+
         // Avancer la phase interne (non modulée — la PM ne touche que la lecture)
-        double prevPhase = phase;
-        phase += inc;
+        step();
+        return out;
+    }
 
-        // Détection de sync pulse : la phase a dépassé 1.0
-        syncPulse = (phase >= 1.0);
-        // Position fractionnelle du crossing pour interpolation subsample
-        if (syncPulse)
-            syncFraction = static_cast<float>(std::min(1.0, (1.0 - prevPhase) / inc));
+    // Avance la phase sans produire de sortie (opérateur muet : niveau ou
+    // enveloppe à 0). Met à jour le sync pulse comme tick(). Le drift suit
+    // sa marche aléatoire, donc il est rendu normalement.
+    void advance() noexcept
+    {
+        if (driftAmount > 0.0f)
+        {
+            tick();
+            return;
+        }
+        step();
+    }
 
-        phase -= std::floor(phase); // wrap [0,1)
+    // Hard sync : le maître a passé 1.0 à `fraction` du pas en cours
+    // (getSyncFraction). À appeler avant le tick() du même échantillon :
+    // la lecture en cours précède le reset, qui s'applique au pas suivant.
+    void hardSyncReset(float fraction) noexcept { syncAt = fraction; }
 
-        return out;
+    // --- Sinus sans PM : récurrence en quadrature (QuadratureSine.h) ---
+    // Sinus pur, sans drift ni reset de sync en cours : la sortie ne
+    // dépend que de la phase et de l'incrément
+    bool isPlainSine() const noexcept
+    {
+        return waveType == WaveType::Sine && driftAmount <= 0.0f && syncAt < 0.0f
+            && syncAge >= static_cast<float>(MinBlepTable::kLength);
     }
 
-    // Hard sync : reset de la phase avec offset subsample
-    void hardSyncReset(float fraction) noexcept
+    // Équivaut à numSamples tick() sans PM à la fréquence courante (à
+    // l'arrondi près). syncFrac, si fourni, reçoit par échantillon
+    // getSyncFraction() ou -1 (pas de sync pulse), comme après chaque tick.
+    void renderUnmodulatedSine(float* out, int numSamples, SineRotation& rotation,
+                               float* syncFrac = nullptr) noexcept
     {
-        phase = static_cast<double>(fraction) * inc;
+        rotation.setIncrement(toCycles(inc));
+        renderQuadratureSine(out, numSamples, toCycles(phase), rotation);
+        readOffset = 0.0;
+
+        if (syncFrac != nullptr)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                step();
+                syncFrac[i] = syncPulse ? syncFraction : -1.0f;
+            }
+            return;
+        }
+
+        // Sans sync à rapporter : la phase avance d'un coup
+        if constexpr (kFixedPhase)
+        {
+            phase += inc * static_cast<uint32_t>(numSamples);   // wrap modulo 2^32
+        }
+        else
+        {
+            phase += inc * static_cast<double>(numSamples);
+            phase -= std::floor(phase);
+        }
+        syncPulse = false;
     }
 
     bool hasSyncPulse() const noexcept { return syncPulse; }
     float getSyncFraction() const noexcept { return syncFraction; }
-    double getPhase() const noexcept { return phase; }
+    // Phase en cycles [0, 1), quel que soit le format interne
+    double getPhase() const noexcept { return toCycles(phase); }
 
-    void resetPhase() noexcept { phase = 0.0; triIntegrator = 0.0; }
+    void resetPhase() noexcept { phase = Phase(0); clearSyncResidual(); }
 
-    // Accès public à la table sinus (utilisé par le LFO)
-    static float lookupSinePublic(double phase) noexcept
+    // Sinus d'une phase en cycles, quelconque (|phase| < 2^51 ; LFO)
+    static float sineCycles(double phase) noexcept
     {
-        return lookupSine(phase);
+        const double x = phase - roundNearest(phase);   // [-0.5, 0.5]
+        return sinPiPoly(static_cast<float>(2.0 * x));
+    }
+
+    // --- Conversions cycles ↔ format de phase (partagées avec VoiceBank) ---
+    static constexpr double kTwoPow32 = 4294967296.0;
+    static constexpr double kRoundMagic = 6755399441055744.0;   // 1.5·2^52
+
+    // Arrondi à l'entier le plus proche (pair sur les égalités), |x| < 2^51
+    static double roundNearest(double x) noexcept
+    {
+        return (x + kRoundMagic) - kRoundMagic;
+    }
+
+    // Incrément par échantillon ; en virgule fixe, la partie entière des
+    // cycles disparaît dans le wrap (fréquences > sr comprises)
+    static Phase incrementFor(double freqHz, double sampleRate) noexcept
+    {
+        if constexpr (kFixedPhase)
+            return cyclesToPhase(freqHz / sampleRate);
+        else
+            return freqHz / sampleRate;
+    }
+
+    // Cycles signés → phase arrondie, modulo 2^32 (|cycles| < 2^19).
+    // Ajouter 1.5·2^52 range l'entier arrondi dans les bits bas de la
+    // mantisse : pas de conversion double → int64, que SSE2 ne vectorise pas
+    static uint32_t cyclesToPhase(double cycles) noexcept
+    {
+        const double shifted = cycles * kTwoPow32 + kRoundMagic;
+        uint64_t bits;
+        std::memcpy(&bits, &shifted, sizeof bits);
+        return static_cast<uint32_t>(bits);
+    }
+
+    // sin(2π·phase), sans branche
+    static float sine(Phase p) noexcept
+    {
+        if constexpr (kFixedPhase)
+        {
+            // Lue comme entier signé, la phase couvre [-0.5, 0.5) cycle
+            return sinPiPoly(static_cast<float>(static_cast<int32_t>(p)) * (1.0f / 2147483648.0f));
+        }
+        else
+        {
+            return sineCycles(p);
+        }
+    }
+
+    // x − floor(x) sans appel ni branche (|x| < 2^51), au bit près
+    static double wrapUnit(double x) noexcept
+    {
+        const double f = x - roundNearest(x);           // [-0.5, 0.5]
+        return f + static_cast<double>(f < 0.0);
     }
 
 private:
-    double sr = 44100.0;
-    double freq = 440.0;
-    double inc = 0.01;      // freq / sampleRate
-    double phase = 0.0;     // [0, 1)
+    friend class VoiceBank;   // accès SoA direct à l'état (rendu par lanes)
+    friend class UnisonStack; // formes d'onde partagées (minBLEP, conversions)
+
+    static double toCycles(Phase p) noexcept
+    {
+        if constexpr (kFixedPhase)
+            return static_cast<double>(p) / kTwoPow32;
+        else
+            return p;
+    }
+
+    // Phase → [0, 1) dans le type de calcul des formes d'onde. En virgule
+    // fixe on garde les 24 bits de poids fort : exact en float, jamais 1.0
+    static Sample toUnit(Phase p) noexcept
+    {
+        if constexpr (kFixedPhase)
+            return static_cast<float>(p >> 8) * (1.0f / 16777216.0f);
+        else
+            return p;
+    }
+
+    // Phase + offset en cycles, wrappée
+    static Phase offsetPhase(Phase p, double cycles) noexcept
+    {
+        if constexpr (kFixedPhase)
+        {
+            return p + cyclesToPhase(cycles);   // wrap gratuit
+        }
+        else
+        {
+            const double x = p + cycles;
+            return wrapUnit(x);                 // wrap [0,1)
+        }
+    }
+
+    // Avance la phase d'un incrément et détecte le passage de 1.0
+    void step() noexcept
+    {
+        if (syncAt >= 0.0f)
+        {
+            syncStep();
+            return;
+        }
+        syncAge = std::min(syncAge + 1.0f, static_cast<float>(MinBlepTable::kLength));
+
+        Phase prevPhase = phase;
+        if constexpr (kFixedPhase)
+        {
+            phase += inc;                    // wrap par débordement
+            syncPulse = (phase < prevPhase);
+            if (syncPulse)
+                syncFraction = static_cast<float>(std::min(1.0,
+                    (kTwoPow32 - static_cast<double>(prevPhase)) / static_cast<double>(inc)));
+        }
+        else
+        {
+            phase += inc;
+
+            // Détection de sync pulse : la phase a dépassé 1.0
+            syncPulse = (phase >= 1.0);
+            // Position fractionnelle du crossing pour interpolation subsample
+            if (syncPulse)
+                syncFraction = static_cast<float>(std::min(1.0, (1.0 - prevPhase) / inc));
+
+            phase -= std::floor(phase); // wrap [0,1)
+        }
+    }
+
+    // --- Chaud : lu / écrit à chaque tick, regroupé en tête d'objet ---
+    Phase phase = Phase(0);                    // [0, 1) ou [0, 2^32)
+    Phase inc = incrementFor(440.0, 44100.0);  // freq / sampleRate
     WaveType waveType = WaveType::Sine;
-    HarmonicTable* harmonicTable = nullptr;
+    float driftAmount = 0.0f;                  // testé à chaque tick
     bool syncPulse = false;
     float syncFraction = 0.0f;
 
-    // Triangle via integrated PolyBLEP square
-    double triIntegrator = 0.0;
+    // Hard sync : reset en attente (< 0 = aucun), saut du dernier reset et
+    // son âge à la prochaine lecture (kLength = éteint)
+    float syncAt = -1.0f;
+    float syncJump = 0.0f;
+    float syncAge = static_cast<float>(MinBlepTable::kLength);
+    double readOffset = 0.0;                   // PM + drift du dernier tick, en cycles
 
-    // Noise RNG state (separate from drift to avoid correlation)
-    uint32_t noiseSeed = nextDriftSeed();
+    // Noise stream (separate from drift to avoid correlation)
+    BlockNoise noise { nextDriftSeed() };
+
+    // --- Froid : changement de fréquence, table custom, drift ---
+    double sr = 44100.0;
+    double freq = 440.0;
+    HarmonicTable* harmonicTable = nullptr;
 
-    // Analog drift state
-    float driftAmount = 0.0f;
+    // Analog drift state (seeds tirés dans l'ordre de déclaration :
+    // noise, driftLFOFreq puis driftSeed)
     double driftLFOPhase = 0.0;
     double driftLFOFreq = 0.1 + (static_cast<double>(nextDriftSeed() & 0xFFFF) / 65535.0) * 0.8; // Hz, unique per instance
 
+    // Control-rate drift: sin at the start of each segment, ramp toward the
+    // value predicted driftStep samples ahead (the LFO freq walk is far too
+    // slow to matter over 32 samples)
+    int driftStep = 1;
+    int driftCountdown = 0;
+    double driftSin = 0.0, driftSinInc = 0.0;
+
+    double nextDriftSin() noexcept
+    {
+        constexpr double twoPi = 2.0 * 3.14159265358979323846;
+        if (driftStep <= 1)
+            return std::sin(driftLFOPhase * twoPi);
+
+        if (driftCountdown <= 0)
+        {
+            driftSin = std::sin(driftLFOPhase * twoPi);
+            double ahead = driftLFOPhase + driftLFOFreq * static_cast<double>(driftStep) / sr;
+            driftSinInc = (std::sin(ahead * twoPi) - driftSin) / static_cast<double>(driftStep);
+            driftCountdown = driftStep;
+        }
+        double out = driftSin;
+        driftSin += driftSinInc;
+        --driftCountdown;
+        return out;
+    }
+
     // Minimal deterministic RNG for drift (xorshift32, unique seed per instance)
     static inline uint32_t nextDriftSeed() noexcept
     {
@@ -162,98 +390,175 @@ private:
         return static_cast<double>(driftSeed) / static_cast<double>(0xFFFFFFFF);
     }
 
-    // --- PolyBLEP : correction aux discontinuités ---
-    // t = phase normalisée [0,1), dt = incrément de phase
-    static double polyBlep(double t, double dt) noexcept
+    // Pas contenant un reset de sync : la phase repart de 0 au crossing et
+    // le saut de la sortie (forme juste avant → début de cycle) devient une
+    // arête minBLEP comme les autres. Un seul résidu à la fois : celui en
+    // cours entre dans la valeur d'avant le saut, la sortie reste continue.
+    void syncStep() noexcept
     {
-        if (dt < 1e-10) return 0.0;
-        // Début de période (discontinuité à t=0)
-        if (t < dt)
+        const float fraction = syncAt;
+        syncAt = -1.0f;
+        syncPulse = false;
+
+        Phase toCrossing, elapsed;
+        if constexpr (kFixedPhase)
+        {
+            toCrossing = static_cast<Phase>(static_cast<double>(fraction) * static_cast<double>(inc));
+            elapsed = static_cast<Phase>(static_cast<double>(1.0f - fraction) * static_cast<double>(inc));
+        }
+        else
+        {
+            toCrossing = static_cast<double>(fraction) * inc;
+            elapsed = static_cast<double>(1.0f - fraction) * inc;
+        }
+
+        if (waveType != WaveType::Noise)
         {
-            double x = t / dt;
-            return x + x - x * x - 1.0; // 2x - x² - 1
+            const auto& table = getMinBlepTable();
+            const float pending = syncJump * table.step(syncAge + fraction);
+            const float before = shapeAt(waveType, offsetPhase(phase + toCrossing, readOffset)) + pending;
+            syncJump = shapeAt(waveType, offsetPhase(Phase(0), readOffset)) - before;
+            syncAge = 1.0f - fraction;
         }
-        // Fin de période (discontinuité à t=1)
-        if (t > 1.0 - dt)
+        else
         {
-            double x = (t - 1.0) / dt;
-            return x * x + x + x + 1.0; // x² + 2x + 1
+            clearSyncResidual();
         }
-        return 0.0;
+        phase = elapsed;
     }
 
-    float renderWave(WaveType type, double p) noexcept
+    void clearSyncResidual() noexcept
     {
-        switch (type)
-        {
-        case WaveType::Sine:
-            return lookupSine(p);
+        syncAt = -1.0f;
+        syncJump = 0.0f;
+        syncAge = static_cast<float>(MinBlepTable::kLength);
+    }
 
-        case WaveType::Saw:
+    // Distance [0, 1) de p à une arête située `edge` cycles après 0
+    static Sample since(Sample p, Sample edge) noexcept
+    {
+        const Sample q = p - edge;
+        return q < Sample(0) ? q + Sample(1) : q;
+    }
+
+    // Sous Nyquist la période dépasse 2 échantillons : au plus kLength / 2
+    // arêtes à la fois dans la fenêtre de la table
+    static constexpr int kMaxEdges = MinBlepTable::kLength / 2;
+
+    // Somme des résidus (Ramp : minBLAMP, sinon minBLEP) d'une arête vue
+    // `age` échantillons plus tôt et de ses répétitions aux périodes
+    // précédentes encore dans la fenêtre de la table (notes aiguës).
+    // period > 2 (bandLimited s'arrête à Nyquist) : au plus kMaxEdges tours
+    template <bool Ramp>
+    static float residuals(const MinBlepTable& table, float age, float period) noexcept
+    {
+        constexpr float end = static_cast<float>(MinBlepTable::kLength);
+        // Arêtes d'âge < end ; au-delà, la table rend 0 (une lecture de trop au plus)
+        const int count = std::min(kMaxEdges, static_cast<int>((end - age) / period) + 1);
+        float sum = 0.0f;
+        for (int k = 0; k < count; ++k)
         {
-            // Saw naïve : 2*p - 1
-            double out = 2.0 * p - 1.0;
-            out -= polyBlep(p, inc);
-            return static_cast<float>(out);
+            const float a = age + static_cast<float>(k) * period;
+            sum += Ramp ? table.ramp(a) : table.step(a);
         }
+        return sum;
+    }
+
+    // --- Formes limitées en bande ---
+    // Forme naïve + résidus des arêtes passées. Sans état : l'âge de chaque
+    // arête se déduit de la phase (distance à l'arête / incrément), donc
+    // mêmes opérations à chaque échantillon, quelle que soit la position
+    // dans la période. Les pentes se lisent `delay` plus tôt : l'arête
+    // limitée en bande est en retard sur l'arête naïve.
+    template <WaveType Wave>
+    static Sample bandLimited(Phase modPhase, Phase inc) noexcept
+    {
+        const Sample p  = toUnit(modPhase);
+        const Sample dt = toUnit(inc);
 
-        case WaveType::Square:
+        // Fondamentale à Nyquist ou au-delà (ratio élevé sur une note aiguë) :
+        // tout replie de toute façon, forme naïve sans résidu
+        if (!(dt < Sample(0.5)))
         {
-            // Square naïve : +1 si p < 0.5, -1 sinon
-            double out = (p < 0.5) ? 1.0 : -1.0;
-            out += polyBlep(p, inc);                          // discontinuité à 0
-            out -= polyBlep(std::fmod(p + 0.5, 1.0), inc);   // discontinuité à 0.5
-            return static_cast<float>(out);
+            if constexpr (Wave == WaveType::Saw)
+                return Sample(2) * p - Sample(1);
+            else if constexpr (Wave == WaveType::Square)
+                return p < Sample(0.5) ? Sample(1) : Sample(-1);
+            else if constexpr (Wave == WaveType::Pulse)
+                return p < Sample(0.25) ? Sample(1) : Sample(-1);
+            else
+                return Sample(1) - Sample(4) * std::abs(p - Sample(0.5));
         }
 
-        case WaveType::Triangle:
+        const auto& table = getMinBlepTable();
+        const Sample period = Sample(1) / std::max(dt, Sample(1e-9));
+        // Âges en float : la table n'a pas besoin de plus
+        const auto ageOf = [period](Sample distance) { return static_cast<float>(distance * period); };
+        const float age0 = ageOf(p);   // arête en début de cycle
+        const float per = static_cast<float>(period);
+
+        if constexpr (Wave == WaveType::Saw)
         {
-            // Triangle via integration of PolyBLEP-corrected square (industry standard)
-            double sq = (p < 0.5) ? 1.0 : -1.0;
-            sq += polyBlep(p, inc);
-            sq -= polyBlep(std::fmod(p + 0.5, 1.0), inc);
-            // Leaky integrator: integrates square into triangle, leak prevents DC drift
-            triIntegrator = 0.999 * triIntegrator + sq * inc * 4.0;
-            return static_cast<float>(triIntegrator);
+            // Saw naïve : 2*p - 1, saut de -2 en 0. La rampe est lue avec le
+            // retard du saut (sinon DC de 2 × delay × dt)
+            const Sample ramp = Sample(2) * (p - static_cast<Sample>(table.delay) * dt) - Sample(1);
+            return ramp - Sample(2) * residuals<false>(table, age0, per);
         }
-
-        case WaveType::Pulse:
+        else if constexpr (Wave == WaveType::Square || Wave == WaveType::Pulse)
         {
-            // Pulse étroite (25% duty cycle)
-            double out = (p < 0.25) ? 1.0 : -1.0;
-            out += polyBlep(p, inc);
-            out -= polyBlep(std::fmod(p + 0.75, 1.0), inc);
-            return static_cast<float>(out);
+            // ±1, montée en 0, descente en 0.5 (square) ou 0.25 (pulse 25%)
+            constexpr double kDuty = Wave == WaveType::Square ? 0.5 : 0.25;
+            const Sample duty = static_cast<Sample>(kDuty);
+            const Sample naive = p < duty ? Sample(1) : Sample(-1);
+            return naive + Sample(2) * (residuals<false>(table, age0, per)
+                                      - residuals<false>(table, ageOf(since(p, duty)), per));
         }
-
-        case WaveType::Custom:
-            return harmonicTable ? harmonicTable->lookup(p) : lookupSine(p);
-
-        case WaveType::Noise:
+        else
         {
-            // White noise via xorshift — phase-independent, sample-rate independent
-            noiseSeed ^= noiseSeed << 13;
-            noiseSeed ^= noiseSeed >> 17;
-            noiseSeed ^= noiseSeed << 5;
-            if (noiseSeed == 0) noiseSeed = 0x12345678;
-            return static_cast<float>(noiseSeed) / static_cast<float>(0x7FFFFFFF) - 1.0f;
+            static_assert(Wave == WaveType::Triangle, "forme sans arête");
+            // Coins en 0 (pente -4 → +4 par cycle) et en 0.5 (+4 → -4)
+            Sample d = p - static_cast<Sample>(table.delay) * dt;
+            d -= std::floor(d);
+            const Sample naive = Sample(1) - Sample(4) * std::abs(d - Sample(0.5));
+            return naive + Sample(8) * dt * (residuals<true>(table, age0, per)
+                                           - residuals<true>(table, ageOf(since(p, Sample(0.5))), per));
         }
+    }
 
+    // Forme d'onde à une phase donnée, hors bruit (sans effet de bord)
+    float shapeAt(WaveType type, Phase modPhase) const noexcept
+    {
+        switch (type)
+        {
+        case WaveType::Saw:      return static_cast<float>(bandLimited<WaveType::Saw>(modPhase, inc));
+        case WaveType::Square:   return static_cast<float>(bandLimited<WaveType::Square>(modPhase, inc));
+        case WaveType::Triangle: return static_cast<float>(bandLimited<WaveType::Triangle>(modPhase, inc));
+        case WaveType::Pulse:    return static_cast<float>(bandLimited<WaveType::Pulse>(modPhase, inc));
+        case WaveType::Custom:
+            return harmonicTable ? harmonicTable->lookup(toCycles(modPhase)) : sine(modPhase);
+        case WaveType::Sine:
+            return sine(modPhase);
         default:
             return 0.0f;
         }
     }
 
-    // Lookup dans la table sinus avec interpolation linéaire
-    static float lookupSine(double phase) noexcept
+    float renderWave(WaveType type, Phase modPhase) noexcept
     {
-        const auto& table = getSineTable();
-        double idx = phase * SINE_TABLE_SIZE;
-        int i0 = static_cast<int>(idx) & (SINE_TABLE_SIZE - 1); // guard OOB / NaN
-        float frac = static_cast<float>(idx - static_cast<int>(idx));
-        if (frac < 0.0f) frac = 0.0f; // NaN guard
-        return table.data[i0] + frac * (table.data[i0 + 1] - table.data[i0]);
+        if (type == WaveType::Sine)
+            return sine(modPhase);
+        // White noise, counter-based — phase-independent, sample-rate independent
+        if (type == WaveType::Noise)
+            return noise.next();
+        return shapeAt(type, modPhase);
     }
 };
 
+// Format de phase des voix (option CMake PARASITE_FIXED_PHASE). Le chemin
+// double reste disponible comme référence : BasicOscillator<double>.
+#ifndef PARASITE_FIXED_PHASE
+ #define PARASITE_FIXED_PHASE 0
+#endif
+using Oscillator = BasicOscillator<std::conditional_t<PARASITE_FIXED_PHASE != 0, uint32_t, double>>;
+
 } // namespace bb
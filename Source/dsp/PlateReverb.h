@@ -5,6 +5,7 @@
 #include <vector>
 #include <cmath>
 #include <algorithm>
+#include "FastMath.h"
 
 namespace bb {
 
@@ -127,7 +128,7 @@ public:
             // --- Modulation ---
             modPhase += modInc;
             if (modPhase >= 1.0) modPhase -= 1.0;
-            float mod = static_cast<float>(std::sin(modPhase * 2.0 * 3.14159265358979));
+            float mod = static_cast<float>(dspmath::sin(modPhase * 2.0 * 3.14159265358979));
             int modSamplesL = static_cast<int>(mod * 16.0f);
             int modSamplesR = static_cast<int>(-mod * 16.0f);
 
@@ -0,0 +1,73 @@
+// QuadratureSine.h — Sinus non modulé par récurrence en quadrature
+// Sans PM et à fréquence fixe, un sinus tourne du même angle à chaque
+// échantillon : (cos, sin) de la phase avance par une rotation (forme
+// couplée), quatre multiplications-additions par échantillon au lieu de
+// la réduction de phase et du polynôme de Oscillator::sine.
+//
+// La récurrence repart à chaque bloc de la phase exacte de l'oscillateur
+// (std::sin / std::cos) : c'est la renormalisation. L'arrondi ne
+// s'accumule que sur un bloc (~1e-15 en double), et la phase de
+// l'oscillateur reste la référence d'un bloc à l'autre.
+#pragma once
+#include <cmath>
+
+namespace bb {
+
+// Rotation d'un incrément de phase, recalculée seulement s'il change
+class SineRotation
+{
+public:
+    void setIncrement(double incCycles) noexcept
+    {
+        if (incCycles == inc)
+            return;
+        inc = incCycles;
+        cosInc = std::cos(kTwoPi * incCycles);
+        sinInc = std::sin(kTwoPi * incCycles);
+    }
+
+    double getCos() const noexcept { return cosInc; }
+    double getSin() const noexcept { return sinInc; }
+
+private:
+    static constexpr double kTwoPi = 2.0 * 3.14159265358979323846;
+    double inc = 0.0;
+    double cosInc = 1.0, sinInc = 0.0;
+};
+
+// (cos, sin) de la phase courante
+struct SinePhasor
+{
+    double c = 1.0, s = 0.0;
+
+    void start(double phaseCycles) noexcept
+    {
+        constexpr double kTwoPi = 2.0 * 3.14159265358979323846;
+        c = std::cos(kTwoPi * phaseCycles);
+        s = std::sin(kTwoPi * phaseCycles);
+    }
+
+    // Sinus courant, puis un pas de rotation
+    float next(double cosInc, double sinInc) noexcept
+    {
+        const double out = s;
+        const double c1 = c * cosInc - s * sinInc;
+        s = s * cosInc + c * sinInc;
+        c = c1;
+        return static_cast<float>(out);
+    }
+};
+
+// out[i] = sin(2π (phase + i · inc)), i ∈ [0, numSamples)
+inline void renderQuadratureSine(float* out, int numSamples, double phaseCycles,
+                                 const SineRotation& rotation) noexcept
+{
+    SinePhasor phasor;
+    phasor.start(phaseCycles);
+    const double cosInc = rotation.getCos();
+    const double sinInc = rotation.getSin();
+    for (int i = 0; i < numSamples; ++i)
+        out[i] = phasor.next(cosInc, sinInc);
+}
+
+} // namespace bb
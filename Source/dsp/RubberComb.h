@@ -8,6 +8,7 @@
 #include <cmath>
 #include <algorithm>
 #include <cstdint>
+#include "FastMath.h"
 
 namespace bb {
 
@@ -102,7 +103,7 @@ public:
             {
                 float fBase = std::clamp(freq[d], 30.0f, srf * 0.45f);
                 float ang = pi * fBase / srf;
-                float g0 = std::tan(ang);
+                float g0 = dspmath::tan(ang);
                 gSvf[0][d] = g0;
                 float detune = (d & 1) ? 0.025f : -0.025f;
                 gSvf[1][d] = g0 + ang * detune * (1.0f + g0 * g0);
@@ -119,7 +120,7 @@ public:
                 envState[ch] = ec * envState[ch] + (1.0f - ec) * absIn;
 
                 // Pre-saturate input → dense harmonics (the "plastic" base character)
-                float sat = std::tanh(dry * satDrive);
+                float sat = dspmath::tanh(dry * satDrive);
                 float in = sat + fbState[ch] * fbAmt;
 
                 // ALL 8 SVF bandpass resonators (always active, unlike Liquid)
@@ -143,7 +144,7 @@ public:
 
                 // Gain + gentle soft limit (ASMR: less crushed)
                 sum /= static_cast<float>(kNum);
-                sum = std::tanh(sum * 1.2f);
+                sum = dspmath::tanh(sum * 1.2f);
 
                 // Envelope-gated feedback (dies when input stops)
                 float envGate = std::min(envState[ch] * 20.0f, 1.0f);
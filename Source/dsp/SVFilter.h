@@ -5,6 +5,7 @@
 #pragma once
 #include <cmath>
 #include <algorithm>
+#include "FastMath.h"
 
 namespace bb {
 
@@ -28,7 +29,7 @@ public:
 
         // Coefficients Cytomic TPT SVF
         // g = tan(π × fc / sr) — la transformation bilinéaire
-        g = std::tan(3.14159265358979323846 * fc / sr);
+        g = dspmath::tan(3.14159265358979323846 * fc / sr);
         // k = damping = 2 - 2*resonance (Q = 1/k, k→0 = self-oscillation)
         // Limit k to small positive value to prevent destructive self-oscillation
         k = std::max(0.01, 2.0 - 2.0 * res);
@@ -74,6 +75,8 @@ public:
     }
 
 private:
+    friend class VoiceBank; // accès SoA direct à l'état (rendu par lanes)
+
     double sr = 44100.0;
     double g = 0.0, k = 0.0;
     double a1 = 0.0, a2 = 0.0, a3 = 0.0;
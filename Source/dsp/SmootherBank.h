@@ -0,0 +1,139 @@
+// SmootherBank.h — Smoothers linéaires d'une voix, rangés en SoA
+// Remplace N juce::SmoothedValue<float> (même rampe, même arithmétique,
+// donc mêmes valeurs) : courants, cibles, pas et décomptes sont contigus.
+// Au lieu d'un getNextValue() par smoother et par échantillon, render()
+// remplit d'un coup une rampe par smoother pour tout un sous-bloc et
+// renvoie le masque de ceux qui bougent. Un smoother stable (le cas
+// courant) coûte un remplissage constant, et l'appelant peut traiter sa
+// valeur comme une constante du sous-bloc.
+#pragma once
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace bb {
+
+template <int N>
+class SmootherBank
+{
+    static_assert(N > 0 && N <= 32, "le masque de render() tient sur 32 bits");
+
+public:
+    static constexpr int kSize = N;
+    static constexpr uint32_t kAll = N == 32 ? ~0u : (1u << N) - 1u;
+
+    // Comme SmoothedValue::reset : durée de rampe, valeur posée sur la cible
+    void reset(int i, double sampleRate, double rampLengthSeconds) noexcept
+    {
+        stepsToTarget[i] = static_cast<int>(std::floor(rampLengthSeconds * sampleRate));
+        setCurrentAndTargetValue(i, target[i]);
+    }
+
+    void setCurrentAndTargetValue(int i, float value) noexcept
+    {
+        target[i] = current[i] = value;
+        countdown[i] = 0;
+    }
+
+    void setTargetValue(int i, float value) noexcept
+    {
+        if (juce::approximatelyEqual(value, target[i]))
+            return;
+        if (stepsToTarget[i] <= 0)
+        {
+            setCurrentAndTargetValue(i, value);
+            return;
+        }
+        target[i] = value;
+        countdown[i] = stepsToTarget[i];
+        step[i] = (target[i] - current[i]) / static_cast<float>(countdown[i]);
+    }
+
+    // Tous les smoothers sur leur cible (point de départ reproductible)
+    void settleAll() noexcept
+    {
+        for (int i = 0; i < N; ++i)
+            setCurrentAndTargetValue(i, target[i]);
+    }
+
+    float getTargetValue(int i) const noexcept { return target[i]; }
+    float getCurrentValue(int i) const noexcept { return current[i]; }
+    bool isSmoothing(int i) const noexcept { return countdown[i] > 0; }
+
+    // Masque des smoothers encore en rampe (comparaison sur tout le banc)
+    uint32_t movingMask() const noexcept
+    {
+        uint32_t mask = 0;
+        for (int i = 0; i < N; ++i)
+            mask |= static_cast<uint32_t>(countdown[i] > 0) << i;
+        return mask;
+    }
+
+    // Comme SmoothedValue::skip
+    float skip(int i, int numSamples) noexcept
+    {
+        if (numSamples >= countdown[i])
+        {
+            setCurrentAndTargetValue(i, target[i]);
+            return target[i];
+        }
+        current[i] += step[i] * static_cast<float>(numSamples);
+        countdown[i] -= numSamples;
+        return current[i];
+    }
+
+    // Avance de numSamples les smoothers du masque `which` : out[i][n] =
+    // valeur qu'aurait rendue le n-ième getNextValue(). Retourne le masque
+    // de ceux qui étaient en rampe (les autres valent leur cible partout).
+    template <int MaxSamples>
+    uint32_t render(float (&out)[N][MaxSamples], int numSamples, uint32_t which = kAll) noexcept
+    {
+        jassert(numSamples <= MaxSamples);
+        const uint32_t moving = movingMask() & which;
+
+        for (int i = 0; i < N; ++i)
+        {
+            if ((which & (1u << i)) == 0)
+                continue;
+
+            float* dst = out[i];
+            if ((moving & (1u << i)) == 0)
+            {
+                std::fill(dst, dst + numSamples, target[i]);
+                continue;
+            }
+
+            // Rampe jusqu'à l'avant-dernier pas, puis la cible exacte
+            const int ramp = std::min(numSamples, countdown[i] - 1);
+            float value = current[i];
+            const float inc = step[i];
+            for (int n = 0; n < ramp; ++n)
+            {
+                value += inc;
+                dst[n] = value;
+            }
+            std::fill(dst + ramp, dst + numSamples, target[i]);
+
+            if (countdown[i] > numSamples)
+            {
+                current[i] = value;
+                countdown[i] -= numSamples;
+            }
+            else
+            {
+                setCurrentAndTargetValue(i, target[i]);
+            }
+        }
+        return moving;
+    }
+
+private:
+    float current[N] {};
+    float target[N] {};
+    float step[N] {};
+    int   countdown[N] {};
+    int   stepsToTarget[N] {};
+};
+
+} // namespace bb
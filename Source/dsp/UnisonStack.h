@@ -0,0 +1,286 @@
+// UnisonStack.h — Carriers unison d'une voix (1 à 8 copies désaccordées)
+// Les copies ne sont pas des Oscillator : leur état est rangé en SoA (une
+// lane par copie) et une seule boucle serrée les avance ensemble,
+// vectorisée pour le sinus (largeur fixe kMaxVoices). Toutes lisent la même PM —
+// les modulateurs sont calculés une seule fois par voix —, seules la
+// fréquence (désaccord), la phase de départ et le panoramique diffèrent.
+// Les lanes au-delà de numVoices ont un gain nul : calculées pour le
+// sinus (boucle sans branche), ignorées pour les autres formes.
+//
+// Detune : copies réparties sur ±kMaxDetuneCents × detune. Blend : niveau
+// des copies latérales face à la (ou aux deux) copie(s) centrale(s), total
+// normalisé en puissance. Width : panoramique des copies selon leur
+// désaccord (loi de balance : une copie au centre sort à plein niveau des
+// deux côtés, comme le carrier seul).
+//
+// Pas de bruit (pas de phase) ni de drift : FMVoice garde ses carriers
+// habituels pour la forme Noise, et le drift ne s'applique qu'à eux.
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include "Oscillator.h"
+#include "HarmonicTable.h"
+
+namespace bb {
+
+class UnisonStack
+{
+public:
+    static constexpr int kMaxVoices = 8;
+    static constexpr double kMaxDetuneCents = 50.0;
+
+    using Phase  = Oscillator::Phase;
+
+    void prepare(double sampleRate) noexcept
+    {
+        sr = sampleRate;
+        resetPhases();
+        getMinBlepTable(); // tables construites ici, pas sur le thread audio
+    }
+
+    // Change le taux sans toucher aux phases (suréchantillonnage du carrier)
+    void setSampleRate(double sampleRate) noexcept { sr = sampleRate; }
+
+    // Phases de départ étalées (suite du nombre d'or) : déterministes, donc
+    // une note rejouée repart du même état, et jamais en phase entre elles
+    void resetPhases() noexcept
+    {
+        for (int u = 0; u < kMaxVoices; ++u)
+        {
+            const double start = std::fmod(static_cast<double>(u) * 0.6180339887498949, 1.0);
+            if constexpr (Oscillator::kFixedPhase)
+                phase[u] = Oscillator::cyclesToPhase(start);
+            else
+                phase[u] = start;
+            syncJump[u] = 0.0f;
+            syncAge[u] = static_cast<float>(MinBlepTable::kLength);
+        }
+    }
+
+    void setWaveType(WaveType type) noexcept { waveType = type; }
+    void setHarmonicTable(HarmonicTable* t) noexcept { harmonicTable = t; }
+
+    // Par bloc : recalcule désaccords et gains si un réglage a changé
+    void setup(int numVoices, float detune, float blend, float width) noexcept
+    {
+        numVoices = std::clamp(numVoices, 1, kMaxVoices);
+        if (numVoices == voices && detune == lastDetune && blend == lastBlend && width == lastWidth)
+            return;
+        voices = numVoices;
+        lastDetune = detune;
+        lastBlend = blend;
+        lastWidth = width;
+
+        // Position de chaque copie dans [-1, 1] ; centrales = les plus proches de 0
+        const double half = static_cast<double>(numVoices - 1) * 0.5;
+        float weight[kMaxVoices] {};
+        float pan[kMaxVoices] {};
+        float power = 0.0f;
+        for (int u = 0; u < numVoices; ++u)
+        {
+            const double pos = half > 0.0 ? (static_cast<double>(u) - half) / half : 0.0;
+            const bool center = std::abs(static_cast<double>(u) - half) <= 0.5;
+            ratio[u] = std::exp2(pos * static_cast<double>(detune) * kMaxDetuneCents / 1200.0);
+            weight[u] = center ? 1.0f : blend;
+            pan[u] = static_cast<float>(pos) * width;
+            power += weight[u] * weight[u];
+        }
+
+        const float norm = power > 0.0f ? 1.0f / std::sqrt(power) : 0.0f;
+        for (int u = 0; u < kMaxVoices; ++u)
+        {
+            if (u >= numVoices)
+            {
+                ratio[u] = 1.0;
+                gainL[u] = gainR[u] = 0.0f;
+                continue;
+            }
+            const float g = weight[u] * norm;
+            gainL[u] = g * std::min(1.0f, 1.0f - pan[u]);
+            gainR[u] = g * std::min(1.0f, 1.0f + pan[u]);
+        }
+    }
+
+    int getNumVoices() const noexcept { return voices; }
+
+    // Rend numSamples échantillons de base (× Factor en sortie) : carFreq et
+    // phaseMod par échantillon de base, syncFrac < 0 = pas de sync pulse.
+    // Factor > 1 : PM interpolée depuis lastPhaseMod, sync reporté au
+    // sous-échantillon du crossing — comme FMVoice::renderCarrier.
+    template <int Factor, bool Sync>
+    void render(const double* carFreq, const double* phaseMod, const float* syncFrac,
+                double& lastPhaseMod, float* outL, float* outR, int numSamples) noexcept
+    {
+        switch (waveType)
+        {
+            case WaveType::Saw:      renderWave<WaveType::Saw, Factor, Sync>(carFreq, phaseMod, syncFrac, lastPhaseMod, outL, outR, numSamples); break;
+            case WaveType::Square:   renderWave<WaveType::Square, Factor, Sync>(carFreq, phaseMod, syncFrac, lastPhaseMod, outL, outR, numSamples); break;
+            case WaveType::Triangle: renderWave<WaveType::Triangle, Factor, Sync>(carFreq, phaseMod, syncFrac, lastPhaseMod, outL, outR, numSamples); break;
+            case WaveType::Pulse:    renderWave<WaveType::Pulse, Factor, Sync>(carFreq, phaseMod, syncFrac, lastPhaseMod, outL, outR, numSamples); break;
+            case WaveType::Custom:
+                if (harmonicTable != nullptr)
+                {
+                    renderWave<WaveType::Custom, Factor, Sync>(carFreq, phaseMod, syncFrac, lastPhaseMod, outL, outR, numSamples);
+                    break;
+                }
+                [[fallthrough]];
+            default:                 renderWave<WaveType::Sine, Factor, Sync>(carFreq, phaseMod, syncFrac, lastPhaseMod, outL, outR, numSamples); break;
+        }
+    }
+
+private:
+    template <WaveType Wave, int Factor, bool Sync>
+    void renderWave(const double* carFreq, const double* phaseMod, const float* syncFrac,
+                    double& lastPhaseMod, float* outL, float* outR, int numSamples) noexcept
+    {
+        constexpr double kInvTwoPi = 1.0 / (2.0 * 3.14159265358979323846);
+        constexpr double kSubStep = 1.0 / Factor;
+        // Sinus : largeur fixe kMaxVoices (les copies inutilisées ont un
+        // gain nul), sans branche ni lecture de table → boucle vectorisée.
+        // Les autres formes (minBLEP, table harmonique) restent sur n copies.
+        constexpr bool kFixedWidth = Wave == WaveType::Sine;
+        const int n = voices;
+        const int lanes = kFixedWidth ? kMaxVoices : n;
+        const auto& table = getMinBlepTable();
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            Phase inc[kMaxVoices];
+            for (int u = 0; u < lanes; ++u)
+                inc[u] = Oscillator::incrementFor(carFreq[i] * ratio[u], sr);
+
+            int syncSub = -1;
+            float syncSubFrac = 0.0f;
+            if (Sync && syncFrac[i] >= 0.0f)
+            {
+                const float pos = syncFrac[i] * static_cast<float>(Factor);
+                syncSub = std::min(Factor - 1, static_cast<int>(pos));
+                syncSubFrac = pos - static_cast<float>(syncSub);
+            }
+
+            const double pm0 = Factor == 1 ? phaseMod[i] : lastPhaseMod;
+            const double pmDelta = phaseMod[i] - pm0;
+            for (int k = 0; k < Factor; ++k)
+            {
+                const double pm = Factor == 1 ? pm0 : pm0 + pmDelta * (static_cast<double>(k + 1) * kSubStep);
+                const double pmCycles = pm * kInvTwoPi;
+
+                float out[kMaxVoices];
+                if constexpr (kFixedWidth)
+                    sineLanes(phase, inc, pmCycles, out);
+                else
+                {
+                    for (int u = 0; u < n; ++u)
+                    {
+                        Phase modPhase;
+                        if constexpr (Oscillator::kFixedPhase)
+                        {
+                            modPhase = phase[u] + Oscillator::cyclesToPhase(pmCycles);
+                            phase[u] += inc[u];
+                        }
+                        else
+                        {
+                            modPhase = Oscillator::wrapUnit(phase[u] + pmCycles);
+                            phase[u] = Oscillator::wrapUnit(phase[u] + inc[u]);
+                        }
+                        out[u] = waveSample<Wave>(modPhase, inc[u]);
+                    }
+                }
+
+                if constexpr (Sync)
+                {
+                    for (int u = 0; u < n; ++u)
+                    {
+                        out[u] += syncJump[u] * table.step(syncAge[u]);
+                        syncAge[u] = std::min(syncAge[u] + 1.0f, static_cast<float>(MinBlepTable::kLength));
+                    }
+                }
+
+                // Somme dans l'ordre des copies (pas de réassociation)
+                float sumL = 0.0f, sumR = 0.0f;
+                for (int u = 0; u < n; ++u)
+                {
+                    sumL += out[u] * gainL[u];
+                    sumR += out[u] * gainR[u];
+                }
+                outL[i * Factor + k] = sumL;
+                outR[i * Factor + k] = sumR;
+
+                // Reset de sync dans le pas qui suit cette lecture : chaque
+                // copie repart de 0 au crossing, saut en arête minBLEP —
+                // comme Oscillator::syncStep
+                if (Sync && k == syncSub)
+                {
+                    const float end = static_cast<float>(MinBlepTable::kLength);
+                    for (int u = 0; u < n; ++u)
+                    {
+                        const auto elapsed = static_cast<Phase>(static_cast<double>(1.0f - syncSubFrac) * static_cast<double>(inc[u]));
+                        const float age = syncAge[u] - (1.0f - syncSubFrac);
+                        const float pending = syncAge[u] < end ? syncJump[u] * table.step(age) : 0.0f;
+                        const float before = waveSample<Wave>(Oscillator::offsetPhase(phase[u] - elapsed, pmCycles), inc[u]) + pending;
+                        syncJump[u] = waveSample<Wave>(Oscillator::offsetPhase(Phase(0), pmCycles), inc[u]) - before;
+                        syncAge[u] = 1.0f - syncSubFrac;
+                        phase[u] = elapsed;
+                    }
+                }
+            }
+            if constexpr (Factor > 1)
+                lastPhaseMod = phaseMod[i];
+        }
+    }
+
+    // Sinus des kMaxVoices copies : avance les phases, écrit les sorties.
+    // Pointeurs __restrict pour que GCC vectorise les 8 lanes.
+    static void sineLanes(Phase* __restrict ph, const Phase* __restrict inc,
+                          double pmCycles, float* __restrict out) noexcept
+    {
+        if constexpr (Oscillator::kFixedPhase)
+        {
+            const Phase pmPhase = Oscillator::cyclesToPhase(pmCycles);
+            for (int u = 0; u < kMaxVoices; ++u)
+            {
+                out[u] = Oscillator::sine(ph[u] + pmPhase);
+                ph[u] += inc[u];
+            }
+        }
+        else
+        {
+            for (int u = 0; u < kMaxVoices; ++u)
+            {
+                out[u] = Oscillator::sine(Oscillator::wrapUnit(ph[u] + pmCycles));
+                ph[u] = Oscillator::wrapUnit(ph[u] + inc[u]);
+            }
+        }
+    }
+
+    // Mêmes formes que BasicOscillator::renderWave, sans état
+    template <WaveType Wave>
+    float waveSample(Phase modPhase, Phase inc) const noexcept
+    {
+        using Osc = Oscillator;
+        if constexpr (Wave == WaveType::Sine)
+            return Osc::sine(modPhase);
+        else if constexpr (Wave == WaveType::Custom)
+            return harmonicTable->lookup(Osc::toCycles(modPhase));
+        else
+            return static_cast<float>(Osc::bandLimited<Wave>(modPhase, inc));
+    }
+
+    // --- Par échantillon : une lane par copie ---
+    Phase  phase[kMaxVoices] {};
+    float  syncJump[kMaxVoices] {};   // hard sync : saut du dernier reset
+    float  syncAge[kMaxVoices] {};    // et son âge (kLength = éteint)
+    double ratio[kMaxVoices] { 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+    float  gainL[kMaxVoices] {};
+    float  gainR[kMaxVoices] {};
+
+    // --- Par bloc ---
+    WaveType waveType = WaveType::Sine;
+    HarmonicTable* harmonicTable = nullptr;
+    double sr = 44100.0;
+    int voices = 0;
+    float lastDetune = -1.0f, lastBlend = -1.0f, lastWidth = -1.0f;
+};
+
+} // namespace bb
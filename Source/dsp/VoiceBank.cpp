@@ -0,0 +1,912 @@
+// VoiceBank.cpp — Noyau lanes : mêmes calculs que FMVoice::renderAudio,
+// réorganisés en boucles "pour chaque lane" à l'intérieur de chaque étage.
+#include "VoiceBank.h"
+#include "FastMath.h"
+#include <algorithm>
+#include <cmath>
+
+namespace bb {
+
+static constexpr double kPi = 3.14159265358979323846;
+static constexpr double kMaxModIndex = 12.0;
+static constexpr int kLanes = VoiceBank::kMaxLanes;
+
+// Oscillator::tick() pour WaveType::Sine sans drift ni sync, dans le
+// format de phase des voix (double ou virgule fixe 32 bits). Sans branche
+// ni appel : wrap et conversions par arrondi de mantisse, sinus polynomial
+static inline float sineTick(Oscillator::Phase& phase, Oscillator::Phase inc, double phaseModulation) noexcept
+{
+    Oscillator::Phase modPhase;
+    if constexpr (Oscillator::kFixedPhase)
+    {
+        modPhase = phase + Oscillator::cyclesToPhase(phaseModulation / (2.0 * kPi));
+        phase += inc;
+    }
+    else
+    {
+        modPhase = Oscillator::wrapUnit(phase + phaseModulation / (2.0 * kPi));
+        phase = Oscillator::wrapUnit(phase + inc);
+    }
+    return Oscillator::sine(modPhase);
+}
+
+// Avance de phase seule (opérateur rendu en quadrature), comme sineTick
+static inline void stepPhase(Oscillator::Phase& phase, Oscillator::Phase inc) noexcept
+{
+    if constexpr (Oscillator::kFixedPhase)
+        phase += inc;
+    else
+        phase = Oscillator::wrapUnit(phase + inc);
+}
+
+// Fréquence de chaque lane pour un opérateur suivant ou non le clavier
+// (le test est uniforme : sorti de la boucle)
+static inline void laneFrequencies(bool keyboard, const double* base, const double* ratio,
+                                   double* freq) noexcept
+{
+    if (keyboard)
+    {
+        for (int l = 0; l < kLanes; ++l)
+            freq[l] = base[l] * ratio[l];
+    }
+    else
+    {
+        std::copy(ratio, ratio + kLanes, freq);
+    }
+}
+
+// --- Sélections par masque ---
+// Un ?: sur des float reste un saut pour GCC (-ftrapping-math),
+// ce qui empêche la vectorisation de la boucle de lanes
+using fastmath::detail::select;
+using fastmath::detail::toBits;
+
+static inline bool isFiniteBits(float x) noexcept
+{
+    return (toBits(x) & 0x7F800000u) != 0x7F800000u;
+}
+
+// XORDistortion::process, mêmes opérations
+static inline float xorLane(float x, uint32_t mask) noexcept
+{
+    const bool finite = isFiniteBits(x);
+    const float clamped = fastmath::detail::clamp(select(finite, x, 0.0f), -1.0f, 1.0f);
+    const auto quantized = static_cast<int16_t>(static_cast<int32_t>(clamped * 32767.0f) ^ static_cast<int32_t>(mask));
+    const float y = select(finite, static_cast<float>(quantized) / 32767.0f, 0.0f);
+    return select(mask == 0, x, y);
+}
+
+// SVFilter::tick pour un mode fixé à la compilation. Le seuil anti-
+// dénormaux est appliqué par flushSvfLanes, une fois par sous-bloc : une
+// comparaison en double dans cette boucle la rend scalaire.
+// __restrict : tableaux distincts, sinon GCC ne vectorise pas la boucle
+template <FilterMode Mode>
+static inline void svfLanes(float* __restrict io, double* __restrict ic1, double* __restrict ic2,
+                            const double* __restrict k, const double* __restrict a1,
+                            const double* __restrict a2, const double* __restrict a3) noexcept
+{
+    for (int l = 0; l < kLanes; ++l)
+    {
+        const double v0 = static_cast<double>(io[l]);
+        const double v3 = v0 - ic2[l];
+        const double v1 = a1[l] * ic1[l] + a2[l] * v3;
+        const double v2 = ic2[l] + a2[l] * ic1[l] + a3[l] * v3;
+        ic1[l] = 2.0 * v1 - ic1[l];
+        ic2[l] = 2.0 * v2 - ic2[l];
+        if constexpr (Mode == FilterMode::HP)
+            io[l] = static_cast<float>(v0 - k[l] * v1 - v2);
+        else if constexpr (Mode == FilterMode::BP)
+            io[l] = static_cast<float>(v1);
+        else if constexpr (Mode == FilterMode::Notch)
+            io[l] = static_cast<float>(v0 - k[l] * v1);
+        else
+            io[l] = static_cast<float>(v2);
+    }
+}
+
+// SVFilter::tick : états sous 1e-18 remis à zéro (filtre au repos). Entre
+// deux appels, ScopedNoDenormals (VoiceBank::render) évite les dénormaux
+static inline void flushSvfLanes(double* state) noexcept
+{
+    for (int l = 0; l < kLanes; ++l)
+        if (std::abs(state[l]) < 1e-18)
+            state[l] = 0.0;
+}
+
+// HemoFold::tick (sans ADAA), Stages = étages actifs sur au moins une
+// lane (1 à 3). Par lane, les étages et l'état ne sont appliqués que par
+// masque : même résultat que les branches de la voix
+template <int Stages>
+static inline void foldLanes(float* __restrict io, const float* __restrict amount,
+                             const float* __restrict dcCoeff, float* __restrict prevOutput,
+                             float* __restrict dcX1, float* __restrict dcY1) noexcept
+{
+    constexpr float kFoldPi = 3.14159265358979f;   // HemoFold::kPi
+    for (int l = 0; l < kLanes; ++l)
+    {
+        const float a = amount[l];
+        const float input = io[l];
+        const float gain = 1.0f + a * a * 15.0f;
+        const float fbGain = a * a * 0.35f;
+        const float bias = a * 0.15f;
+
+        float signal = input * gain + prevOutput[l] * fbGain;
+        signal += bias;
+        signal = dspmath::sin(signal * kFoldPi * 0.5f);
+
+        if constexpr (Stages >= 2)
+        {
+            const float blend2 = select(a > 0.3f, (a - 0.3f) * (1.0f / 0.7f), 0.0f);
+            const float folded = dspmath::sin(signal * kFoldPi);
+            signal += (folded - signal) * blend2 * 0.5f;
+        }
+        if constexpr (Stages >= 3)
+        {
+            const float blend3 = select(a > 0.6f, (a - 0.6f) * (1.0f / 0.4f), 0.0f);
+            const float saturated = dspmath::tanh(signal * 2.5f);
+            signal += (saturated - signal) * blend3;
+        }
+
+        const bool active = a >= 0.001f;
+        prevOutput[l] = select(active, signal, prevOutput[l]);
+        signal -= bias;
+
+        const float dcOut = signal - dcX1[l] + dcCoeff[l] * dcY1[l];
+        dcX1[l] = select(active, signal, dcX1[l]);
+        dcY1[l] = select(active, dcOut, dcY1[l]);
+
+        io[l] = select(active, input + (dcOut - input) * a, input);
+    }
+}
+
+// Opérateur sans PM rendu en quadrature sur toutes les lanes : un
+// SinePhasor par lane, rangé en SoA. Lanes sans voix : sortie nulle.
+struct LaneQuadrature
+{
+    alignas(64) double c[kLanes] {}, s[kLanes] {};
+    alignas(64) double cosInc[kLanes] {}, sinInc[kLanes] {};
+
+    void start(int l, double phaseCycles, const SineRotation& rotation) noexcept
+    {
+        SinePhasor phasor;
+        phasor.start(phaseCycles);
+        c[l] = phasor.c;
+        s[l] = phasor.s;
+        cosInc[l] = rotation.getCos();
+        sinInc[l] = rotation.getSin();
+    }
+
+    // Mêmes opérations que SinePhasor::next
+    void next(float* out) noexcept
+    {
+        for (int l = 0; l < kLanes; ++l)
+        {
+            out[l] = static_cast<float>(s[l]);
+            const double c1 = c[l] * cosInc[l] - s[l] * sinInc[l];
+            s[l] = s[l] * cosInc[l] + c[l] * sinInc[l];
+            c[l] = c1;
+        }
+    }
+};
+
+bool VoiceBank::isLaneCompatible(const FMVoice& v) noexcept
+{
+    const auto& b = v.block;
+    return b.mod1Wave == WaveType::Sine
+        && b.mod2Wave == WaveType::Sine
+        && b.carWave  == WaveType::Sine
+        && !b.syncEnabled
+        && b.driftParam <= 0.0f
+        && b.unisonVoices <= 1
+        && !b.opMatrix
+        && v.osFactor == 1
+        && v.cacheMode == FMVoice::CacheMode::Off;   // lecture / enregistrement : scalaire
+}
+
+bool VoiceBank::sameLayout(const FMVoice& a, const FMVoice& b) noexcept
+{
+    // Les paramètres sont partagés : seule une écriture concurrente pendant
+    // le bloc peut faire diverger deux voix. Dans ce cas on reste scalaire.
+    const auto& x = a.block;
+    const auto& y = b.block;
+    return x.fmAlgo == y.fmAlgo
+        && x.mod1KB == y.mod1KB && x.mod2KB == y.mod2KB && x.carKB == y.carKB
+        && x.xorEnabled == y.xorEnabled
+        && x.filtEnabled == y.filtEnabled
+        && x.filterMode == y.filterMode
+        && x.antialias == y.antialias;
+}
+
+void VoiceBank::render(FMVoice* const* voices, int numVoices,
+                       juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    juce::ScopedNoDenormals noDenormals;
+
+    FMVoice* group[kLanes];
+    int groupSize = 0;
+
+    auto flushGroup = [&]
+    {
+        if (groupSize == 1)
+            group[0]->renderPrepared(outputBuffer, startSample, numSamples);
+        else if (groupSize > 1)
+            renderLanes(group, groupSize, outputBuffer, startSample, numSamples);
+        groupSize = 0;
+    };
+
+    for (int v = 0; v < numVoices; ++v)
+    {
+        auto* voice = voices[v];
+        if (!voice->hot.env3.isActive())
+        {
+            voice->clearCurrentNote();
+            continue;
+        }
+
+        voice->beginBlock(numSamples);
+
+        if (!enabled || !isLaneCompatible(*voice))
+        {
+            voice->renderPrepared(outputBuffer, startSample, numSamples);
+            continue;
+        }
+
+        if (groupSize > 0 && !sameLayout(*group[0], *voice))
+        {
+            voice->renderPrepared(outputBuffer, startSample, numSamples);
+            continue;
+        }
+
+        group[groupSize++] = voice;
+        if (groupSize == kLanes)
+            flushGroup();
+    }
+
+    flushGroup();
+}
+
+void VoiceBank::clearLanes() noexcept
+{
+    std::fill(std::begin(ph1), std::end(ph1), Oscillator::Phase(0));
+    std::fill(std::begin(ph2), std::end(ph2), Oscillator::Phase(0));
+    std::fill(std::begin(phC), std::end(phC), Oscillator::Phase(0));
+    std::fill(std::begin(phR), std::end(phR), Oscillator::Phase(0));
+    std::fill(std::begin(ratio1), std::end(ratio1), 0.0);
+    std::fill(std::begin(ratio2), std::end(ratio2), 0.0);
+    std::fill(std::begin(ratioC), std::end(ratioC), 0.0);
+    std::fill(std::begin(fb), std::end(fb), 0.0f);
+    std::fill(std::begin(svfK), std::end(svfK), 0.0);
+    std::fill(std::begin(svfA1), std::end(svfA1), 0.0);
+    std::fill(std::begin(svfA2), std::end(svfA2), 0.0);
+    std::fill(std::begin(svfA3), std::end(svfA3), 0.0);
+    std::fill(std::begin(ic1L), std::end(ic1L), 0.0);
+    std::fill(std::begin(ic2L), std::end(ic2L), 0.0);
+    std::fill(std::begin(ic1R), std::end(ic1R), 0.0);
+    std::fill(std::begin(ic2R), std::end(ic2R), 0.0);
+    std::fill(std::begin(dcR), std::end(dcR), 0.0);
+    std::fill(std::begin(dcX1L), std::end(dcX1L), 0.0);
+    std::fill(std::begin(dcY1L), std::end(dcY1L), 0.0);
+    std::fill(std::begin(dcX1R), std::end(dcX1R), 0.0);
+    std::fill(std::begin(dcY1R), std::end(dcY1R), 0.0);
+    std::fill(std::begin(foldAmt), std::end(foldAmt), 0.0f);
+    std::fill(std::begin(foldPrevL), std::end(foldPrevL), 0.0f);
+    std::fill(std::begin(foldDcX1L), std::end(foldDcX1L), 0.0f);
+    std::fill(std::begin(foldDcY1L), std::end(foldDcY1L), 0.0f);
+    std::fill(std::begin(foldPrevR), std::end(foldPrevR), 0.0f);
+    std::fill(std::begin(foldDcX1R), std::end(foldDcX1R), 0.0f);
+    std::fill(std::begin(foldDcY1R), std::end(foldDcY1R), 0.0f);
+    std::fill(std::begin(xorMask), std::end(xorMask), 0u);
+    std::fill(std::begin(fadeIn), std::end(fadeIn), 0);
+    std::fill(std::begin(steal), std::end(steal), 0);
+    std::fill(std::begin(alive), std::end(alive), false);
+
+    // Lanes inactives : contrôle à zéro → sortie nulle sans branche
+    for (int i = 0; i < kCtrl; ++i)
+    {
+        std::fill(std::begin(cBase[i]), std::end(cBase[i]), 0.0);
+        std::fill(std::begin(cFlux[i]), std::end(cFlux[i]), 0.0f);
+        std::fill(std::begin(cVol[i]), std::end(cVol[i]), 0.0f);
+        std::fill(std::begin(cM1[i]), std::end(cM1[i]), 0.0f);
+        std::fill(std::begin(cM2[i]), std::end(cM2[i]), 0.0f);
+        std::fill(std::begin(cSpread[i]), std::end(cSpread[i]), 0.0f);
+        std::fill(std::begin(cNoise[i]), std::end(cNoise[i]), 0.0f);
+        std::fill(std::begin(cVel[i]), std::end(cVel[i]), 0.0f);
+        std::fill(std::begin(cDrive[i]), std::end(cDrive[i]), 1.0f);
+        std::fill(std::begin(cCut[i]), std::end(cCut[i]), 0.0f);
+        std::fill(std::begin(cRes[i]), std::end(cRes[i]), 0.0f);
+        std::fill(std::begin(cEnv1[i]), std::end(cEnv1[i]), 0.0f);
+        std::fill(std::begin(cEnv2[i]), std::end(cEnv2[i]), 0.0f);
+        std::fill(std::begin(cEnv3[i]), std::end(cEnv3[i]), 0.0f);
+    }
+}
+
+void VoiceBank::loadLane(int l, const FMVoice& v) noexcept
+{
+    ph1[l] = v.hot.mod1Osc.phase;
+    ph2[l] = v.hot.mod2Osc.phase;
+    phC[l] = v.hot.carrierOsc.phase;
+    phR[l] = v.hot.carrierOscR.phase;
+    ratio1[l] = v.block.mod1Ratio;
+    ratio2[l] = v.block.mod2Ratio;
+    ratioC[l] = v.block.carRatio;
+    fb[l] = v.hot.mod2FeedbackSample;
+
+    // L et R partagent les coefficients (mis à jour ensemble dans la voix)
+    svfK[l]  = v.hot.filterL.k;
+    svfA1[l] = v.hot.filterL.a1;
+    svfA2[l] = v.hot.filterL.a2;
+    svfA3[l] = v.hot.filterL.a3;
+    ic1L[l] = v.hot.filterL.ic1eq;
+    ic2L[l] = v.hot.filterL.ic2eq;
+    ic1R[l] = v.hot.filterR.ic1eq;
+    ic2R[l] = v.hot.filterR.ic2eq;
+    lastCut[l] = v.hot.lastFilterCutoff;
+    lastRes[l] = v.hot.lastFilterRes;
+
+    dcR[l]   = v.hot.dcBlockerL.R;
+    dcX1L[l] = v.hot.dcBlockerL.x1;
+    dcY1L[l] = v.hot.dcBlockerL.y1;
+    dcX1R[l] = v.hot.dcBlockerR.x1;
+    dcY1R[l] = v.hot.dcBlockerR.y1;
+
+    // Fold en ADAA : rendu par les objets de la voix (voir processSubBlock)
+    foldAmt[l]     = v.hot.hemoFoldL.amount;
+    foldDcCoeff[l] = v.hot.hemoFoldL.dcCoeff;
+    foldPrevL[l] = v.hot.hemoFoldL.prevOutput;
+    foldDcX1L[l] = v.hot.hemoFoldL.dcX1;
+    foldDcY1L[l] = v.hot.hemoFoldL.dcY1;
+    foldPrevR[l] = v.hot.hemoFoldR.prevOutput;
+    foldDcX1R[l] = v.hot.hemoFoldR.dcX1;
+    foldDcY1R[l] = v.hot.hemoFoldR.dcY1;
+    xorMask[l] = v.hot.xorDist.mask;
+
+    noiseKeyL[l] = v.hot.noiseL.getKey();
+    noiseKeyR[l] = v.hot.noiseR.getKey();
+    noisePosL[l] = v.hot.noiseL.getPosition();
+    noisePosR[l] = v.hot.noiseR.getPosition();
+    fadeIn[l]    = v.hot.noteFadeInSamples;
+    fadeInLen[l] = v.hot.noteFadeInLength;
+    steal[l]     = v.hot.stealFadeSamples;
+    stealLen[l]  = v.hot.stealFadeLength;
+    alive[l] = true;
+}
+
+void VoiceBank::storeLane(int l, FMVoice& v) const noexcept
+{
+    v.hot.mod1Osc.phase = ph1[l];
+    v.hot.mod2Osc.phase = ph2[l];
+    v.hot.carrierOsc.phase = phC[l];
+    v.hot.carrierOscR.phase = phR[l];
+    v.hot.mod1Osc.inc = inc1[l];
+    v.hot.mod2Osc.inc = inc2[l];
+    v.hot.carrierOsc.inc = incC[l];
+    v.hot.carrierOscR.inc = incR[l];
+    v.hot.mod2FeedbackSample = fb[l];
+
+    v.hot.filterL.ic1eq = ic1L[l];
+    v.hot.filterL.ic2eq = ic2L[l];
+    v.hot.filterR.ic1eq = ic1R[l];
+    v.hot.filterR.ic2eq = ic2R[l];
+    v.hot.lastFilterCutoff = lastCut[l];
+    v.hot.lastFilterRes    = lastRes[l];
+
+    v.hot.dcBlockerL.x1 = dcX1L[l];
+    v.hot.dcBlockerL.y1 = dcY1L[l];
+    v.hot.dcBlockerR.x1 = dcX1R[l];
+    v.hot.dcBlockerR.y1 = dcY1R[l];
+
+    if (!v.block.antialias)
+    {
+        v.hot.hemoFoldL.prevOutput = foldPrevL[l];
+        v.hot.hemoFoldL.dcX1 = foldDcX1L[l];
+        v.hot.hemoFoldL.dcY1 = foldDcY1L[l];
+        v.hot.hemoFoldR.prevOutput = foldPrevR[l];
+        v.hot.hemoFoldR.dcX1 = foldDcX1R[l];
+        v.hot.hemoFoldR.dcY1 = foldDcY1R[l];
+        // Comme FMVoice::renderPostChain : l'ADAA reprendra sans saut
+        v.hot.driveShaperL.track(driveInL[l]);
+        v.hot.driveShaperR.track(driveInR[l]);
+    }
+
+    v.hot.noiseL.setPosition(noisePosL[l]);
+    v.hot.noiseR.setPosition(noisePosR[l]);
+    v.hot.noteFadeInSamples = fadeIn[l];
+    v.hot.stealFadeSamples  = steal[l];
+}
+
+void VoiceBank::transposeControl(int l, const FMVoice& v, int numSamples) noexcept
+{
+    const auto& c = v.ctrl;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        cBase[i][l]   = c.baseFreq[i];
+        cFlux[i][l]   = c.fluxMod[i];
+        cVol[i][l]    = c.vol[i];
+        cM1[i][l]     = c.m1Level[i];
+        cM2[i][l]     = c.m2Level[i];
+        cSpread[i][l] = c.spread[i];
+        cNoise[i][l]  = c.noiseMix[i];
+        cVel[i][l]    = c.velGain[i];
+        cDrive[i][l]  = c.drive[i];
+        cEnv1[i][l]   = c.env1[i];
+        cEnv2[i][l]   = c.env2[i];
+        cEnv3[i][l]   = c.env3[i];
+    }
+    if (v.block.filtEnabled)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            cCut[i][l] = c.cutoffHz[i];
+            cRes[i][l] = c.res[i];
+        }
+    }
+}
+
+void VoiceBank::renderLanes(FMVoice* const* voices, int numLanes,
+                            juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    clearLanes();
+    for (int l = 0; l < numLanes; ++l)
+        loadLane(l, *voices[l]);
+    laneVoiceBlocks += static_cast<uint64_t>(numLanes);
+
+    const int numChannels = outputBuffer.getNumChannels();
+
+    static const auto kernels = makeKernelTable(std::make_index_sequence<6 * 4>());
+    const auto& b = voices[0]->block; // structure partagée (vérifiée par sameLayout)
+    const auto kernel = kernels[static_cast<std::size_t>(
+        b.fmAlgo * 4 + (b.xorEnabled ? 2 : 0) + (b.filtEnabled ? 1 : 0))];
+
+    for (int offset = 0; offset < numSamples; offset += kCtrl)
+    {
+        const int n = std::min(kCtrl, numSamples - offset);
+
+        int numAlive = 0;
+        for (int l = 0; l < numLanes; ++l)
+        {
+            if (!alive[l])
+                continue;
+            voices[l]->renderControl(n);
+            transposeControl(l, *voices[l], n);
+            ++numAlive;
+        }
+        if (numAlive == 0)
+            break;
+
+        (this->*kernel)(voices, numLanes, n);
+
+        outputBuffer.addFrom(0, startSample + offset, mixL, n);
+        if (numChannels >= 2)
+            outputBuffer.addFrom(1, startSample + offset, mixR, n);
+    }
+
+    for (int l = 0; l < numLanes; ++l)
+    {
+        if (!alive[l])
+            continue; // déjà réécrite au moment de la fin du steal fade
+        storeLane(l, *voices[l]);
+        voices[l]->cullIfInaudible();
+        if (!voices[l]->hot.env3.isActive())
+            voices[l]->clearCurrentNote();
+    }
+}
+
+template <int Algo, bool Xor, bool Filt>
+void VoiceBank::processSubBlock(FMVoice* const* voices, int numLanes, int numSamples) noexcept
+{
+    // Structure partagée par toutes les lanes (vérifiée par sameLayout)
+    const auto& b = voices[0]->block;
+    const double sr = voices[0]->sampleRate;
+    constexpr double kDetuneScale = 15.0 / 1200.0 * 0.693147180559945; // 15 cents × ln(2)
+
+    // Lanes vides ou mortes pendant le sous-bloc : sortie forcée à 0
+    alignas(32) int32_t live[kLanes];
+    for (int l = 0; l < kLanes; ++l)
+        live[l] = (l < numLanes && alive[l]) ? 1 : 0;
+
+    // Hauteur fixe sur le sous-bloc : les opérateurs sans PM (Mod1 ; Mod2
+    // en Parallel, Ring, Mix ; carriers en Mix) tournent en quadrature,
+    // comme dans FMVoice::renderModulators / renderCarrier
+    bool baseSteady = true, spreadSteady = true;
+    for (int i = 1; i < numSamples; ++i)
+    {
+        for (int l = 0; l < kLanes; ++l)
+        {
+            baseSteady &= (cBase[i][l] == cBase[0][l]);
+            spreadSteady &= (cSpread[i][l] == cSpread[0][l]);
+        }
+    }
+    // Bruit et étages du fold : sautés quand aucune lane ne s'en sert,
+    // comme les noyaux de FMVoice
+    bool anyNoise = false;
+    for (int i = 0; i < numSamples; ++i)
+        for (int l = 0; l < kLanes; ++l)
+            anyNoise |= cNoise[i][l] > 0.0001f;
+    int foldStages = 0;
+    for (int l = 0; l < numLanes; ++l)
+    {
+        const float a = foldAmt[l];
+        foldStages = std::max(foldStages, a > 0.6f ? 3 : a > 0.3f ? 2 : a >= 0.001f ? 1 : 0);
+    }
+
+    constexpr bool kMod2Free = Algo == 1 || Algo == 3 || Algo == 5;
+    const bool quad1 = !b.mod1KB || baseSteady;
+    const bool quad2 = kMod2Free && (!b.mod2KB || baseSteady);
+    const bool quadC = Algo == 5 && (!b.carKB || baseSteady) && spreadSteady;
+
+    LaneQuadrature q1, q2, qC, qR;
+    for (int l = 0; l < numLanes; ++l)
+    {
+        auto& rot = voices[l]->quadrature;
+        const double base = cBase[0][l];
+        if (quad1)
+        {
+            inc1[l] = Oscillator::incrementFor(b.mod1KB ? base * ratio1[l] : ratio1[l], sr);
+            rot.mod1.setIncrement(Oscillator::toCycles(inc1[l]));
+            q1.start(l, Oscillator::toCycles(ph1[l]), rot.mod1);
+        }
+        if (quad2)
+        {
+            inc2[l] = Oscillator::incrementFor(b.mod2KB ? base * ratio2[l] : ratio2[l], sr);
+            rot.mod2.setIncrement(Oscillator::toCycles(inc2[l]));
+            q2.start(l, Oscillator::toCycles(ph2[l]), rot.mod2);
+        }
+        if (quadC)
+        {
+            const double carrierFreq = b.carKB ? base * ratioC[l] : ratioC[l];
+            const double detuneR = 1.0 + static_cast<double>(cSpread[0][l]) * kDetuneScale;
+            incC[l] = Oscillator::incrementFor(carrierFreq, sr);
+            incR[l] = Oscillator::incrementFor(carrierFreq * detuneR, sr);
+            rot.carrier.setIncrement(Oscillator::toCycles(incC[l]));
+            rot.carrierR.setIncrement(Oscillator::toCycles(incR[l]));
+            qC.start(l, Oscillator::toCycles(phC[l]), rot.carrier);
+            qR.start(l, Oscillator::toCycles(phR[l]), rot.carrierR);
+        }
+    }
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const double* base = cBase[i];
+        const float* flux = cFlux[i];
+        const float* m1 = cM1[i];
+        const float* m2 = cM2[i];
+        const float* e1 = cEnv1[i];
+        const float* e2 = cEnv2[i];
+
+        alignas(64) double freq[kLanes], m1Sig[kLanes], pm[kLanes];
+        alignas(32) float  m1Out[kLanes], m2Out[kLanes], mixAudio[kLanes];
+        alignas(32) float  outL[kLanes], outR[kLanes];
+
+        // --- Modulateur 1 ---
+        if (quad1)
+        {
+            q1.next(m1Out);
+            for (int l = 0; l < kLanes; ++l)
+                stepPhase(ph1[l], inc1[l]);
+        }
+        else
+        {
+            laneFrequencies(b.mod1KB, base, ratio1, freq);
+            for (int l = 0; l < kLanes; ++l)
+                inc1[l] = Oscillator::incrementFor(freq[l], sr);
+            for (int l = 0; l < kLanes; ++l)
+                m1Out[l] = sineTick(ph1[l], inc1[l], 0.0);
+        }
+        for (int l = 0; l < kLanes; ++l)
+        {
+            m1Sig[l] = static_cast<double>(m1Out[l] * e1[l] * m1[l] * flux[l]) * kMaxModIndex;
+            mixAudio[l] = 0.0f;
+        }
+
+        // --- Modulateur 2 sans entrée (Parallel, Ring, Mix) ---
+        if (quad2)
+        {
+            q2.next(m2Out);
+            for (int l = 0; l < kLanes; ++l)
+                stepPhase(ph2[l], inc2[l]);
+        }
+        else
+        {
+            laneFrequencies(b.mod2KB, base, ratio2, freq);
+            for (int l = 0; l < kLanes; ++l)
+                inc2[l] = Oscillator::incrementFor(freq[l], sr);
+            if constexpr (kMod2Free)
+            {
+                for (int l = 0; l < kLanes; ++l)
+                    m2Out[l] = sineTick(ph2[l], inc2[l], 0.0);
+            }
+        }
+
+        // --- Modulateur 2 + routing (uniforme sur les lanes) ---
+        if constexpr (Algo == 1) // Parallel
+        {
+            for (int l = 0; l < kLanes; ++l)
+                pm[l] = m1Sig[l] + static_cast<double>(m2Out[l] * e2[l] * m2[l] * flux[l]) * kMaxModIndex;
+        }
+        else if constexpr (Algo == 2) // Stack
+        {
+            for (int l = 0; l < kLanes; ++l)
+            {
+                m2Out[l] = sineTick(ph2[l], inc2[l], m1Sig[l]);
+                pm[l] = m1Sig[l] + static_cast<double>(m2Out[l] * e2[l] * m2[l] * flux[l]) * kMaxModIndex;
+            }
+        }
+        else if constexpr (Algo == 3) // Ring
+        {
+            for (int l = 0; l < kLanes; ++l)
+            {
+                float ringOut = m1Out[l] * e1[l] * m2Out[l] * e2[l];
+                pm[l] = static_cast<double>(ringOut * m1[l] * m2[l] * flux[l]) * kMaxModIndex;
+            }
+        }
+        else if constexpr (Algo == 4) // Feedback
+        {
+            for (int l = 0; l < kLanes; ++l)
+            {
+                double fbSignal = static_cast<double>(fb[l]) * kMaxModIndex * 0.5;
+                m2Out[l] = sineTick(ph2[l], inc2[l], m1Sig[l] + fbSignal);
+                fb[l] = m2Out[l] * e2[l];
+                pm[l] = static_cast<double>(fb[l] * m2[l] * flux[l]) * kMaxModIndex;
+            }
+        }
+        else if constexpr (Algo == 5) // Mix
+        {
+            for (int l = 0; l < kLanes; ++l)
+            {
+                mixAudio[l] = m1Out[l] * e1[l] * m1[l] + m2Out[l] * e2[l] * m2[l];
+                pm[l] = 0.0;
+            }
+        }
+        else // Series
+        {
+            for (int l = 0; l < kLanes; ++l)
+            {
+                m2Out[l] = sineTick(ph2[l], inc2[l], m1Sig[l]);
+                pm[l] = static_cast<double>(m2Out[l] * e2[l] * m2[l] * flux[l]) * kMaxModIndex;
+            }
+        }
+
+        // --- Carrier L/R + bruit + VCA ---
+        const float* spread = cSpread[i];
+        const float* noise  = cNoise[i];
+        const float* vel    = cVel[i];
+        const float* e3     = cEnv3[i];
+        if (quadC)
+        {
+            qC.next(outL);
+            qR.next(outR);
+            for (int l = 0; l < kLanes; ++l)
+            {
+                stepPhase(phC[l], incC[l]);
+                stepPhase(phR[l], incR[l]);
+            }
+        }
+        else
+        {
+            laneFrequencies(b.carKB, base, ratioC, freq);
+            for (int l = 0; l < kLanes; ++l)
+            {
+                double detuneR = 1.0 + static_cast<double>(spread[l]) * kDetuneScale;
+                incC[l] = Oscillator::incrementFor(freq[l], sr);
+                incR[l] = Oscillator::incrementFor(freq[l] * detuneR, sr);
+                outL[l] = sineTick(phC[l], incC[l], pm[l]);
+                outR[l] = sineTick(phR[l], incR[l], pm[l]);
+            }
+        }
+        if (anyNoise)
+        {
+            for (int l = 0; l < kLanes; ++l)
+            {
+                // Mix nul sous le seuil : la voix saute le mélange, ici
+                // x·1 + n·0 rend x au bit près
+                const float mix = select(noise[l] > 0.0001f, noise[l], 0.0f);
+                const float nL = BlockNoise::sample(noiseKeyL[l], noisePosL[l]);
+                const float nR = BlockNoise::sample(noiseKeyR[l], noisePosR[l]);
+                outL[l] = (outL[l] * (1.0f - mix) + nL * mix) * e3[l] * vel[l];
+                outR[l] = (outR[l] * (1.0f - mix) + nR * mix) * e3[l] * vel[l];
+            }
+        }
+        else
+        {
+            for (int l = 0; l < kLanes; ++l)
+            {
+                outL[l] = outL[l] * e3[l] * vel[l];
+                outR[l] = outR[l] * e3[l] * vel[l];
+            }
+        }
+        // Flux à compteur : un index par échantillon, bruit ou non
+        // (comme FMVoice::renderPostChain)
+        for (int l = 0; l < kLanes; ++l)
+        {
+            ++noisePosL[l];
+            ++noisePosR[l];
+        }
+        if constexpr (Algo == 5)
+        {
+            for (int l = 0; l < kLanes; ++l)
+            {
+                float modAudio = mixAudio[l] * vel[l];
+                outL[l] += modAudio;
+                outR[l] += modAudio;
+            }
+        }
+
+        // --- XOR (quantification int16) ---
+        if constexpr (Xor)
+        {
+            for (int l = 0; l < kLanes; ++l)
+            {
+                outL[l] = xorLane(outL[l], xorMask[l]);
+                outR[l] = xorLane(outR[l], xorMask[l]);
+            }
+        }
+
+        // --- SVF TPT ---
+        if constexpr (Filt)
+        {
+            const float* cut = cCut[i];
+            const float* res = cRes[i];
+
+            // Nouveaux coefficients (tan) seulement quand le cutoff bouge
+            // audiblement : détection en lanes, calcul par voix
+            alignas(32) int32_t retune[kLanes];
+            int numRetune = 0;
+            for (int l = 0; l < kLanes; ++l)
+            {
+                retune[l] = live[l] & static_cast<int32_t>((std::abs(cut[l] - lastCut[l]) > 1.5f)
+                                                         | (std::abs(res[l] - lastRes[l]) > 0.002f));
+                numRetune += retune[l];
+            }
+            if (numRetune > 0)
+            {
+                for (int l = 0; l < numLanes; ++l)
+                {
+                    if (retune[l] == 0) continue;
+                    auto& f = voices[l]->hot.filterL;
+                    f.setParameters(cut[l], res[l]);
+                    voices[l]->hot.filterR.setParameters(cut[l], res[l]);
+                    svfK[l] = f.k; svfA1[l] = f.a1; svfA2[l] = f.a2; svfA3[l] = f.a3;
+                    lastCut[l] = cut[l];
+                    lastRes[l] = res[l];
+                }
+            }
+
+            switch (b.filterMode)
+            {
+                case FilterMode::HP:
+                    svfLanes<FilterMode::HP>(outL, ic1L, ic2L, svfK, svfA1, svfA2, svfA3);
+                    svfLanes<FilterMode::HP>(outR, ic1R, ic2R, svfK, svfA1, svfA2, svfA3);
+                    break;
+                case FilterMode::BP:
+                    svfLanes<FilterMode::BP>(outL, ic1L, ic2L, svfK, svfA1, svfA2, svfA3);
+                    svfLanes<FilterMode::BP>(outR, ic1R, ic2R, svfK, svfA1, svfA2, svfA3);
+                    break;
+                case FilterMode::Notch:
+                    svfLanes<FilterMode::Notch>(outL, ic1L, ic2L, svfK, svfA1, svfA2, svfA3);
+                    svfLanes<FilterMode::Notch>(outR, ic1R, ic2R, svfK, svfA1, svfA2, svfA3);
+                    break;
+                case FilterMode::LP:
+                default:
+                    svfLanes<FilterMode::LP>(outL, ic1L, ic2L, svfK, svfA1, svfA2, svfA3);
+                    svfLanes<FilterMode::LP>(outR, ic1R, ic2R, svfK, svfA1, svfA2, svfA3);
+                    break;
+            }
+        }
+
+        // --- DC blocker ---
+        for (int l = 0; l < kLanes; ++l)
+        {
+            double xL = static_cast<double>(outL[l]);
+            double yL = xL - dcX1L[l] + dcR[l] * dcY1L[l];
+            dcX1L[l] = xL;
+            dcY1L[l] = yL;
+            outL[l] = static_cast<float>(yL);
+
+            double xR = static_cast<double>(outR[l]);
+            double yR = xR - dcX1R[l] + dcR[l] * dcY1R[l];
+            dcX1R[l] = xR;
+            dcY1R[l] = yR;
+            outR[l] = static_cast<float>(yR);
+        }
+
+        // --- HemoFold + drive ---
+        const float* drv = cDrive[i];
+        const float* vol = cVol[i];
+        if (!b.antialias)
+        {
+            switch (foldStages)
+            {
+                case 1:
+                    foldLanes<1>(outL, foldAmt, foldDcCoeff, foldPrevL, foldDcX1L, foldDcY1L);
+                    foldLanes<1>(outR, foldAmt, foldDcCoeff, foldPrevR, foldDcX1R, foldDcY1R);
+                    break;
+                case 2:
+                    foldLanes<2>(outL, foldAmt, foldDcCoeff, foldPrevL, foldDcX1L, foldDcY1L);
+                    foldLanes<2>(outR, foldAmt, foldDcCoeff, foldPrevR, foldDcX1R, foldDcY1R);
+                    break;
+                case 3:
+                    foldLanes<3>(outL, foldAmt, foldDcCoeff, foldPrevL, foldDcX1L, foldDcY1L);
+                    foldLanes<3>(outR, foldAmt, foldDcCoeff, foldPrevR, foldDcX1R, foldDcY1R);
+                    break;
+                default:
+                    break;
+            }
+            for (int l = 0; l < kLanes; ++l)
+            {
+                driveInL[l] = outL[l] * drv[l];
+                driveInR[l] = outR[l] * drv[l];
+                outL[l] = dspmath::tanh(driveInL[l]) * vol[l];
+                outR[l] = dspmath::tanh(driveInR[l]) * vol[l];
+            }
+        }
+        else
+        {
+            // ADAA : primitives en double (log1p / exp), état propre à
+            // chaque objet — rendu voix par voix
+            for (int l = 0; l < numLanes; ++l)
+            {
+                if (live[l] == 0) continue;
+                auto& v = *voices[l];
+                outL[l] = v.hot.hemoFoldL.tick(outL[l]);
+                outR[l] = v.hot.hemoFoldR.tick(outR[l]);
+                outL[l] = v.hot.driveShaperL.process(outL[l] * drv[l]) * vol[l];
+                outR[l] = v.hot.driveShaperR.process(outR[l] * drv[l]) * vol[l];
+            }
+        }
+
+        // --- Fades anti-click + garde NaN ---
+        alignas(32) int32_t stealDone[kLanes];
+        int numStealDone = 0;
+        for (int l = 0; l < kLanes; ++l)
+        {
+            const bool fading = fadeIn[l] > 0;
+            const float fadeGain = 1.0f - static_cast<float>(fadeIn[l]) / static_cast<float>(fadeInLen[l]);
+            const float inGain = select(fading, fadeGain, 1.0f);
+            fadeIn[l] -= static_cast<int>(fading);
+
+            const bool stealing = steal[l] > 0;
+            const float stealGain = static_cast<float>(steal[l]) / static_cast<float>(stealLen[l]);
+            const float outGain = select(stealing, stealGain, 1.0f);
+            steal[l] -= static_cast<int>(stealing);
+            stealDone[l] = live[l] & static_cast<int32_t>(stealing & (steal[l] == 0));
+            numStealDone += stealDone[l];
+
+            const float yL = outL[l] * inGain * outGain;
+            const float yR = outR[l] * inGain * outGain;
+            outL[l] = select((live[l] != 0) & isFiniteBits(yL), yL, 0.0f);
+            outR[l] = select((live[l] != 0) & isFiniteBits(yR), yR, 0.0f);
+        }
+        if (numStealDone > 0)
+        {
+            for (int l = 0; l < numLanes; ++l)
+            {
+                if (stealDone[l] == 0) continue;
+                // Comme le chemin scalaire : cet échantillon n'est pas écrit
+                storeLane(l, *voices[l]);
+                voices[l]->finishStealFade();
+                alive[l] = false;
+                live[l] = 0;
+                outL[l] = outR[l] = 0.0f;
+            }
+        }
+
+        float sumL = 0.0f, sumR = 0.0f;
+        for (int l = 0; l < numLanes; ++l)
+        {
+            sumL += outL[l];
+            sumR += outR[l];
+        }
+        mixL[i] = sumL;
+        mixR[i] = sumR;
+    }
+
+    if constexpr (Filt)
+    {
+        flushSvfLanes(ic1L);
+        flushSvfLanes(ic2L);
+        flushSvfLanes(ic1R);
+        flushSvfLanes(ic2R);
+    }
+}
+
+} // namespace bb
@@ -0,0 +1,121 @@
+// VoiceBank.h — Rendu de plusieurs FMVoice en parallèle (lanes SIMD)
+// Structure-of-arrays : les phases des 4 oscillateurs, les états SVF / DC
+// blocker / HemoFold, les seeds de bruit et les compteurs de fade de
+// jusqu'à 8 voix sont rangés côte à côte (un élément par lane). Chaque
+// étage est une boucle sur les 8 lanes, sans branche ni appel : sinus
+// polynomial (Oscillator::sine), sélections par masque, mode du filtre
+// choisi hors de la boucle. Les lanes vides calculent sur un état nul et
+// leur sortie est masquée. GCC -O3 vectorise ces boucles en SSE2 sans
+// intrinsics ; fold et drive passent par fastmath, donc seulement avec
+// PARASITE_FAST_MATH (sinon ce sont des appels libm).
+//
+// Restent par voix, hors des boucles vectorisées : la mise à jour des
+// coefficients du SVF quand le cutoff bouge (rare, tan), la fin d'un steal
+// fade, et fold + drive en ADAA (option antialias : primitives en double
+// via log1p / exp).
+//
+// Les enveloppes, LFOs par voix et smoothers restent rendus par chaque voix
+// (FMVoice::renderControl) puis sont transposés en lanes par sous-bloc.
+// L'état est chargé depuis les voix au début du bloc et réécrit à la fin,
+// donc une voix peut passer du chemin scalaire au chemin lanes d'un bloc
+// à l'autre sans discontinuité.
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <array>
+#include <cstdint>
+#include <utility>
+#include "FMVoice.h"
+
+namespace bb {
+
+class VoiceBank
+{
+public:
+    // 8 lanes float = un registre AVX2 ou deux registres SSE/NEON
+    static constexpr int kMaxLanes = 8;
+
+    // Rend toutes les voix actives passées en argument. Les voix dont le
+    // patch est compatible avec le noyau lanes sont groupées par 8 ; les
+    // autres (ou une voix compatible isolée) passent par le chemin scalaire.
+    void render(FMVoice* const* voices, int numVoices,
+                juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples);
+
+    void setEnabled(bool shouldUseLanes) noexcept { enabled = shouldUseLanes; }
+    bool isEnabled() const noexcept { return enabled; }
+
+    // Voix rendues par le noyau lanes depuis la création, une par bloc
+    // (tests, mesure : le chemin lanes a bien servi)
+    uint64_t getNumLaneVoiceBlocks() const noexcept { return laneVoiceBlocks; }
+
+private:
+    // Le noyau lanes ne gère que les opérateurs sinus sans sync, drift ni
+    // suréchantillonnage — le cas FM classique. Le reste reste scalaire,
+    // comme les voix servies ou enregistrées par le cache de notes.
+    static bool isLaneCompatible(const FMVoice& v) noexcept;
+    static bool sameLayout(const FMVoice& a, const FMVoice& b) noexcept;
+
+    void renderLanes(FMVoice* const* voices, int numLanes,
+                     juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples);
+    void loadLane(int lane, const FMVoice& v) noexcept;
+    void storeLane(int lane, FMVoice& v) const noexcept;
+    void clearLanes() noexcept;
+    void transposeControl(int lane, const FMVoice& v, int numSamples) noexcept;
+    // Spécialisé par algo / XOR / filtre (même principe que les noyaux de FMVoice)
+    template <int Algo, bool Xor, bool Filt>
+    void processSubBlock(FMVoice* const* voices, int numLanes, int numSamples) noexcept;
+
+    using SubBlockKernel = void (VoiceBank::*)(FMVoice* const*, int, int) noexcept;
+    template <std::size_t... I>
+    static constexpr std::array<SubBlockKernel, sizeof...(I)> makeKernelTable(std::index_sequence<I...>)
+    {
+        return {{ &VoiceBank::processSubBlock<static_cast<int>(I >> 2), ((I >> 1) & 1) != 0, (I & 1) != 0>... }};
+    }
+
+    bool enabled = true;
+    uint64_t laneVoiceBlocks = 0;
+
+    // --- État SoA (une entrée par lane) ---
+    // Phases au format des oscillateurs (uint32 : 8 lanes par registre AVX2)
+    alignas(64) Oscillator::Phase ph1[kMaxLanes] {}, ph2[kMaxLanes] {}, phC[kMaxLanes] {}, phR[kMaxLanes] {};
+    alignas(64) Oscillator::Phase inc1[kMaxLanes] {}, inc2[kMaxLanes] {}, incC[kMaxLanes] {}, incR[kMaxLanes] {};
+    alignas(64) double ratio1[kMaxLanes] {}, ratio2[kMaxLanes] {}, ratioC[kMaxLanes] {};
+    alignas(32) float  fb[kMaxLanes] {};
+
+    // SVF TPT (L/R)
+    alignas(64) double svfK[kMaxLanes] {}, svfA1[kMaxLanes] {}, svfA2[kMaxLanes] {}, svfA3[kMaxLanes] {};
+    alignas(64) double ic1L[kMaxLanes] {}, ic2L[kMaxLanes] {}, ic1R[kMaxLanes] {}, ic2R[kMaxLanes] {};
+    alignas(32) float  lastCut[kMaxLanes] {}, lastRes[kMaxLanes] {};
+
+    // DC blocker (L/R)
+    alignas(64) double dcR[kMaxLanes] {};
+    alignas(64) double dcX1L[kMaxLanes] {}, dcY1L[kMaxLanes] {}, dcX1R[kMaxLanes] {}, dcY1R[kMaxLanes] {};
+
+    // HemoFold sans ADAA (L/R, amount commun) ; entrée du drive gardée
+    // pour reprendre l'ADAA sans saut (adaa::Tanh::track)
+    alignas(32) float foldAmt[kMaxLanes] {}, foldDcCoeff[kMaxLanes] {};
+    alignas(32) float foldPrevL[kMaxLanes] {}, foldDcX1L[kMaxLanes] {}, foldDcY1L[kMaxLanes] {};
+    alignas(32) float foldPrevR[kMaxLanes] {}, foldDcX1R[kMaxLanes] {}, foldDcY1R[kMaxLanes] {};
+    alignas(32) float driveInL[kMaxLanes] {}, driveInR[kMaxLanes] {};
+
+    alignas(32) uint32_t xorMask[kMaxLanes] {};
+    alignas(32) uint32_t noiseKeyL[kMaxLanes] {}, noiseKeyR[kMaxLanes] {};
+    alignas(32) uint32_t noisePosL[kMaxLanes] {}, noisePosR[kMaxLanes] {};
+    alignas(32) int fadeIn[kMaxLanes] {}, fadeInLen[kMaxLanes] {};
+    alignas(32) int steal[kMaxLanes] {}, stealLen[kMaxLanes] {};
+    bool alive[kMaxLanes] {};
+
+    // --- Contrôle transposé : [échantillon][lane] ---
+    static constexpr int kCtrl = FMVoice::kControlBlock;
+    alignas(64) double cBase[kCtrl][kMaxLanes] {};
+    alignas(64) float  cFlux[kCtrl][kMaxLanes] {}, cVol[kCtrl][kMaxLanes] {};
+    alignas(64) float  cM1[kCtrl][kMaxLanes] {}, cM2[kCtrl][kMaxLanes] {};
+    alignas(64) float  cSpread[kCtrl][kMaxLanes] {}, cNoise[kCtrl][kMaxLanes] {};
+    alignas(64) float  cVel[kCtrl][kMaxLanes] {}, cDrive[kCtrl][kMaxLanes] {};
+    alignas(64) float  cCut[kCtrl][kMaxLanes] {}, cRes[kCtrl][kMaxLanes] {};
+    alignas(64) float  cEnv1[kCtrl][kMaxLanes] {}, cEnv2[kCtrl][kMaxLanes] {}, cEnv3[kCtrl][kMaxLanes] {};
+
+    // Somme des lanes par sous-bloc, ajoutée au buffer en une passe
+    alignas(64) float mixL[kCtrl] {}, mixR[kCtrl] {};
+};
+
+} // namespace bb
@@ -0,0 +1,218 @@
+// VoiceWorkerPool.cpp — Workers, passage de job et attente active
+#include "VoiceWorkerPool.h"
+#include <algorithm>
+#include <cerrno>
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+ #include <immintrin.h>
+#endif
+#if defined(_WIN32)
+ #ifndef NOMINMAX
+  #define NOMINMAX
+ #endif
+ #include <windows.h>
+#elif defined(__APPLE__)
+ #include <dispatch/dispatch.h>
+#else
+ #include <semaphore.h>
+#endif
+
+namespace bb {
+
+// Pause d'attente active : libère les ressources du cœur voisin (SMT)
+static inline void cpuRelax() noexcept
+{
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+// Sémaphore du système, sans mutex côté post() : futex (Linux),
+// libdispatch (macOS), objet noyau (Windows). juce::WaitableEvent prend
+// un verrou à chaque signal(), hors de question sur le thread audio.
+class WakeSemaphore
+{
+public:
+#if defined(_WIN32)
+    WakeSemaphore() : handle(CreateSemaphoreW(nullptr, 0, 0x7fffffff, nullptr)) {}
+    ~WakeSemaphore() { CloseHandle(handle); }
+    void post() noexcept { ReleaseSemaphore(handle, 1, nullptr); }
+    void wait() noexcept { WaitForSingleObject(handle, INFINITE); }
+
+private:
+    HANDLE handle;
+#elif defined(__APPLE__)
+    WakeSemaphore() : sem(dispatch_semaphore_create(0)) {}
+    ~WakeSemaphore() { dispatch_release(sem); }
+    void post() noexcept { dispatch_semaphore_signal(sem); }
+    void wait() noexcept { dispatch_semaphore_wait(sem, DISPATCH_TIME_FOREVER); }
+
+private:
+    dispatch_semaphore_t sem;
+#else
+    WakeSemaphore() { sem_init(&sem, 0, 0); }
+    ~WakeSemaphore() { sem_destroy(&sem); }
+    void post() noexcept { sem_post(&sem); }
+    void wait() noexcept
+    {
+        while (sem_wait(&sem) != 0 && errno == EINTR) {}
+    }
+
+private:
+    sem_t sem;
+#endif
+
+    JUCE_DECLARE_NON_COPYABLE(WakeSemaphore)
+};
+
+class VoiceWorkerPool::Worker : public juce::Thread
+{
+public:
+    Worker(int index, const std::atomic<bool>& poolHolding)
+        : juce::Thread("Parasite voices " + juce::String(index + 1)),
+          jobIndex(index + 1),
+          holding(poolHolding)
+    {
+    }
+
+    // Thread audio : publie le job (job / context avant le compteur)
+    void post(JobFn fn, void* ctx) noexcept
+    {
+        job = fn;
+        context = ctx;
+        posted.store(posted.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Thread audio, après holding = true : réveille le worker s'il dort
+    void wakeIfSleeping() noexcept
+    {
+        if (sleeping.load())
+            wake.post();
+    }
+
+    bool isDone() const noexcept
+    {
+        return completed.load(std::memory_order_acquire) == posted.load(std::memory_order_relaxed);
+    }
+
+    void shutdown()
+    {
+        signalThreadShouldExit();
+        wake.post();
+        stopThread(2000);
+    }
+
+    void run() override
+    {
+        uint32_t seen = 0;
+        while (!threadShouldExit())
+        {
+            if (!waitForJob(seen))
+                continue;
+
+            seen = posted.load(std::memory_order_acquire);
+            job(context, jobIndex);
+            completed.store(seen, std::memory_order_release);
+        }
+    }
+
+private:
+    bool waitForJob(uint32_t seen)
+    {
+        // Attente active tant que le bloc hôte dure, puis kSpinIterations
+        for (int spins = 0; spins < kSpinIterations; ++spins)
+        {
+            if (posted.load(std::memory_order_acquire) != seen)
+                return true;
+            if (threadShouldExit())
+                return false;
+            if (holding.load(std::memory_order_relaxed))
+                spins = 0;
+            cpuRelax();
+        }
+
+        // sleeping puis relecture de holding, face à run() qui écrit
+        // holding puis lit sleeping (ordre séquentiel) : soit on voit le
+        // bloc commencer, soit run() voit qu'on dort et réveille
+        sleeping.store(true);
+        if (!holding.load() && posted.load() == seen && !threadShouldExit())
+            wake.wait();
+        sleeping.store(false);
+        return posted.load(std::memory_order_acquire) != seen;
+    }
+
+    const int jobIndex;
+    JobFn job = nullptr;
+    void* context = nullptr;
+    std::atomic<uint32_t> posted { 0 };
+    std::atomic<uint32_t> completed { 0 };
+    std::atomic<bool> sleeping { false };
+    const std::atomic<bool>& holding;
+    WakeSemaphore wake;
+};
+
+VoiceWorkerPool::VoiceWorkerPool() = default;
+
+VoiceWorkerPool::~VoiceWorkerPool()
+{
+    stop();
+}
+
+void VoiceWorkerPool::start(int count)
+{
+    count = std::clamp(count, 0, kMaxWorkers);
+    if (count == numWorkers)
+        return;
+
+    stop();
+
+    for (int i = 0; i < count; ++i)
+    {
+        auto worker = std::make_unique<Worker>(i, holding);
+        if (!worker->startRealtimeThread(juce::Thread::RealtimeOptions{}.withPriority(9)))
+            worker->startThread(juce::Thread::Priority::highest);
+        workers[static_cast<size_t>(i)] = std::move(worker);
+    }
+    numWorkers = count;
+}
+
+void VoiceWorkerPool::stop()
+{
+    for (auto& worker : workers)
+    {
+        if (worker != nullptr)
+            worker->shutdown();
+        worker.reset();
+    }
+    numWorkers = 0;
+    holding.store(false);
+}
+
+void VoiceWorkerPool::run(int numJobs, JobFn fn, void* context) noexcept
+{
+    numJobs = std::min(numJobs, numWorkers + 1);
+
+    // Premier run() du bloc hôte : les workers restent éveillés jusqu'à endBlock()
+    if (numJobs > 1 && !holding.load(std::memory_order_relaxed))
+    {
+        holding.store(true);
+        for (int j = 0; j < numWorkers; ++j)
+            workers[static_cast<size_t>(j)]->wakeIfSleeping();
+    }
+
+    for (int j = 1; j < numJobs; ++j)
+        workers[static_cast<size_t>(j - 1)]->post(fn, context);
+
+    fn(context, 0);
+
+    // Workers en attente active : le dernier job finit dans le sous-bloc
+    for (int j = 1; j < numJobs; ++j)
+    {
+        const auto& worker = *workers[static_cast<size_t>(j - 1)];
+        while (!worker.isDone())
+            cpuRelax();
+    }
+}
+
+} // namespace bb
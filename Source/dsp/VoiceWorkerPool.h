@@ -0,0 +1,59 @@
+// VoiceWorkerPool.h — Threads de rendu temps réel pour les voix
+// Un petit pool de threads en priorité temps réel, démarré seulement
+// quand le rendu multi-cœur est demandé. Le thread audio leur confie des
+// jobs sans verrou ni allocation : un compteur atomique par worker
+// annonce le job, un second signale sa fin.
+//
+// Dès le premier run() d'un bloc hôte, les workers restent en attente
+// active jusqu'à endBlock() : les sous-blocs de 32 échantillons
+// s'enchaînent sans jamais passer par le noyau. Après endBlock(), un
+// worker tourne encore kSpinIterations fois puis s'endort sur un
+// sémaphore. Le réveil (un post de sémaphore, sans mutex) a lieu au plus
+// une fois par bloc hôte, au premier run(). Le thread audio n'attend
+// jamais sur un objet système : il exécute le job 0 puis tourne jusqu'à
+// la fin des autres.
+#pragma once
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace bb {
+
+class VoiceWorkerPool
+{
+public:
+    // Workers + thread audio = jusqu'à 8 jobs par appel à run()
+    static constexpr int kMaxWorkers = 7;
+    static constexpr int kSpinIterations = 4096;
+
+    using JobFn = void (*)(void* context, int jobIndex) noexcept;
+
+    VoiceWorkerPool();
+    ~VoiceWorkerPool();
+
+    // Thread message uniquement. Sans effet si le pool tourne déjà avec
+    // ce nombre de workers. Threads sans affinité : l'OS les répartit.
+    void start(int numWorkers);
+    void stop();
+    int getNumWorkers() const noexcept { return numWorkers; }
+
+    // Thread audio. Exécute fn(context, 0) sur l'appelant et
+    // fn(context, 1..numJobs-1) sur les workers, retourne quand tous ont
+    // terminé. numJobs est borné à getNumWorkers() + 1.
+    void run(int numJobs, JobFn fn, void* context) noexcept;
+
+    // Thread audio, fin du bloc hôte : les workers peuvent s'endormir
+    void endBlock() noexcept { holding.store(false, std::memory_order_relaxed); }
+
+private:
+    class Worker;
+    std::array<std::unique_ptr<Worker>, kMaxWorkers> workers;
+    int numWorkers = 0;
+    std::atomic<bool> holding { false };   // workers en attente active jusqu'à endBlock()
+
+    JUCE_DECLARE_NON_COPYABLE(VoiceWorkerPool)
+};
+
+} // namespace bb
@@ -36,6 +36,8 @@ public:
     }
 
 private:
+    friend class VoiceBank; // masque lu par lane (rendu par lanes)
+
     uint16_t mask = 0;
 };
 
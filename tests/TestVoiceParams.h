@@ -0,0 +1,104 @@
+// TestVoiceParams.h — VoiceParams backed by local atomics (no APVTS needed)
+// Shared by the FMVoice / FMSynth tests.
+#pragma once
+#include <atomic>
+#include "dsp/FMVoice.h"
+
+namespace test {
+
+using bb::VoiceParams;
+using bb::HarmonicTable;
+
+// Helper: set up VoiceParams with local atomics (no APVTS needed)
+struct TestVoiceParams
+{
+    // Owned atomic storage
+    std::atomic<float> mod1On{1.0f}, mod1Wave{0.0f}, mod1KB{1.0f}, mod1Level{0.5f};
+    std::atomic<float> mod1Coarse{1.0f}, mod1Fine{0.0f}, mod1FixedFreq{440.0f}, mod1Multi{4.0f};
+    std::atomic<float> env1A{0.01f}, env1D{0.3f}, env1S{0.7f}, env1R{0.3f};
+
+    std::atomic<float> mod2On{1.0f}, mod2Wave{0.0f}, mod2KB{1.0f}, mod2Level{0.5f};
+    std::atomic<float> mod2Coarse{1.0f}, mod2Fine{0.0f}, mod2FixedFreq{440.0f}, mod2Multi{4.0f};
+    std::atomic<float> env2A{0.01f}, env2D{0.3f}, env2S{0.7f}, env2R{0.3f};
+
+    std::atomic<float> mod3On{0.0f}, opAlgo{0.0f}, mod3Wave{0.0f}, mod3KB{1.0f}, mod3Level{0.3f};
+    std::atomic<float> mod3Coarse{1.0f}, mod3Fine{0.0f}, mod3FixedFreq{440.0f}, mod3Multi{4.0f};
+    std::atomic<float> mod3Feedback{0.0f};
+    std::atomic<float> env4A{0.01f}, env4D{0.3f}, env4S{0.7f}, env4R{0.3f};
+
+    std::atomic<float> carWave{0.0f}, carCoarse{1.0f}, carFine{0.0f};
+    std::atomic<float> carFixedFreq{440.0f}, carMulti{4.0f}, carKB{1.0f};
+    std::atomic<float> carNoise{0.0f}, carSpread{0.0f};
+    std::atomic<float> unison{1.0f}, unisonDetune{0.25f}, unisonBlend{0.75f}, unisonWidth{0.5f};
+    std::atomic<float> env3A{0.01f}, env3D{0.3f}, env3S{1.0f}, env3R{0.3f};
+
+    std::atomic<float> tremor{0.0f}, vein{0.0f}, flux{0.0f};
+    std::atomic<float> xorOn{0.0f}, syncOn{0.0f}, fmAlgo{0.0f};
+
+    std::atomic<float> pitchEnvOn{0.0f}, pitchEnvAmt{0.0f};
+    std::atomic<float> pitchEnvA{0.001f}, pitchEnvD{0.15f}, pitchEnvS{0.0f}, pitchEnvR{0.1f};
+
+    std::atomic<float> filtOn{0.0f}, filtCutoff{20000.0f}, filtRes{0.0f}, filtType{0.0f};
+
+    std::atomic<float> volume{0.8f}, drive{0.0f}, mono{0.0f}, retrig{0.0f};
+    std::atomic<float> porta{0.0f}, dispAmt{0.0f}, carDrift{0.0f};
+    std::atomic<float> vortex{0.5f}, helix{0.0f}, plasma{0.5f}, macroTime{0.5f}, octave{0.0f};
+    std::atomic<float> modRate{0.0f}; // per-sample: reference output
+    std::atomic<float> oversampling{0.0f}; // 1×
+    std::atomic<float> antialias{0.0f};    // plain tanh / sin fold
+    std::atomic<float> noteCache{0.0f};    // live render for every note
+
+    HarmonicTable mod1Harmonics, mod2Harmonics, carHarmonics;
+    VoiceParams params;
+
+    TestVoiceParams()
+    {
+        params.mod1On = &mod1On; params.mod1Wave = &mod1Wave; params.mod1KB = &mod1KB;
+        params.mod1Level = &mod1Level; params.mod1Coarse = &mod1Coarse; params.mod1Fine = &mod1Fine;
+        params.mod1FixedFreq = &mod1FixedFreq; params.mod1Multi = &mod1Multi;
+        params.env1A = &env1A; params.env1D = &env1D; params.env1S = &env1S; params.env1R = &env1R;
+
+        params.mod2On = &mod2On; params.mod2Wave = &mod2Wave; params.mod2KB = &mod2KB;
+        params.mod2Level = &mod2Level; params.mod2Coarse = &mod2Coarse; params.mod2Fine = &mod2Fine;
+        params.mod2FixedFreq = &mod2FixedFreq; params.mod2Multi = &mod2Multi;
+        params.env2A = &env2A; params.env2D = &env2D; params.env2S = &env2S; params.env2R = &env2R;
+
+        params.mod3On = &mod3On; params.opAlgo = &opAlgo; params.mod3Wave = &mod3Wave;
+        params.mod3KB = &mod3KB; params.mod3Level = &mod3Level; params.mod3Coarse = &mod3Coarse;
+        params.mod3Fine = &mod3Fine; params.mod3FixedFreq = &mod3FixedFreq; params.mod3Multi = &mod3Multi;
+        params.mod3Feedback = &mod3Feedback;
+        params.env4A = &env4A; params.env4D = &env4D; params.env4S = &env4S; params.env4R = &env4R;
+
+        params.carWave = &carWave; params.carCoarse = &carCoarse; params.carFine = &carFine;
+        params.carFixedFreq = &carFixedFreq; params.carMulti = &carMulti; params.carKB = &carKB;
+        params.carNoise = &carNoise; params.carSpread = &carSpread;
+        params.unison = &unison; params.unisonDetune = &unisonDetune;
+        params.unisonBlend = &unisonBlend; params.unisonWidth = &unisonWidth;
+        params.env3A = &env3A; params.env3D = &env3D; params.env3S = &env3S; params.env3R = &env3R;
+
+        params.tremor = &tremor; params.vein = &vein; params.flux = &flux;
+        params.xorOn = &xorOn; params.syncOn = &syncOn; params.fmAlgo = &fmAlgo;
+
+        params.pitchEnvOn = &pitchEnvOn; params.pitchEnvAmt = &pitchEnvAmt;
+        params.pitchEnvA = &pitchEnvA; params.pitchEnvD = &pitchEnvD;
+        params.pitchEnvS = &pitchEnvS; params.pitchEnvR = &pitchEnvR;
+
+        params.filtOn = &filtOn; params.filtCutoff = &filtCutoff;
+        params.filtRes = &filtRes; params.filtType = &filtType;
+
+        params.volume = &volume; params.drive = &drive; params.mono = &mono;
+        params.retrig = &retrig; params.porta = &porta; params.dispAmt = &dispAmt;
+        params.carDrift = &carDrift; params.vortex = &vortex; params.helix = &helix;
+        params.plasma = &plasma; params.macroTime = &macroTime; params.octave = &octave;
+        params.modRate = &modRate;
+        params.oversampling = &oversampling;
+        params.antialias = &antialias;
+        params.noteCache = &noteCache;
+
+        params.mod1Harmonics = &mod1Harmonics;
+        params.mod2Harmonics = &mod2Harmonics;
+        params.carHarmonics = &carHarmonics;
+    }
+};
+
+} // namespace test
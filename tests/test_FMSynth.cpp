@@ -0,0 +1,654 @@
+// test_FMSynth.cpp — Tests for bb::FMSynth / bb::VoiceBank (lane rendering)
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "dsp/FMSynth.h"
+#include "dsp/FMSound.h"
+#include "TestHelpers.h"
+#include "TestVoiceParams.h"
+
+using namespace bb;
+using test::TestVoiceParams;
+
+static constexpr double kSR = 44100.0;
+static constexpr int kBlock = 4096;
+
+// numVoices FMVoices prepared for blockSize, lane rendering on or off
+static void prepareSynth(FMSynth& synth, VoiceParams& params, bool lanes,
+                         int numVoices, int blockSize)
+{
+    synth.setLaneRenderingEnabled(lanes);
+    synth.addSound(new FMSound());
+    for (int i = 0; i < numVoices; ++i)
+        synth.addVoice(new FMVoice(params));
+    synth.setCurrentPlaybackSampleRate(kSR);
+    for (int i = 0; i < synth.getNumVoices(); ++i)
+        static_cast<FMVoice*>(synth.getVoice(i))->prepareToPlay(kSR, blockSize);
+    // Même bruit d'un rendu à l'autre (scalaire / lanes comparés)
+    synth.setNoiseSeed(1);
+}
+
+// Build a synth with numVoices FMVoices, play the given chord and render
+// numSamples in blockSize chunks. Notes are released halfway through.
+static juce::AudioBuffer<float> renderChord(VoiceParams& params, bool lanes,
+                                            std::initializer_list<int> notes,
+                                            int numVoices = 8, int blockSize = 512,
+                                            int numSamples = kBlock,
+                                            VoiceWorkerPool* pool = nullptr)
+{
+    FMSynth synth;
+    if (pool != nullptr)
+    {
+        synth.setWorkerPool(pool, blockSize);
+        synth.setParallelVoiceThreshold(2);
+    }
+    prepareSynth(synth, params, lanes, numVoices, blockSize);
+
+    for (int n : notes)
+        synth.noteOn(1, n, 0.8f);
+
+    juce::AudioBuffer<float> buffer(2, numSamples);
+    buffer.clear();
+    juce::MidiBuffer midi;
+
+    for (int pos = 0; pos < numSamples; pos += blockSize)
+    {
+        if (pos == numSamples / 2)
+            for (int n : notes)
+                synth.noteOff(1, n, 0.0f, true);
+        synth.renderNextBlock(buffer, midi, pos, std::min(blockSize, numSamples - pos));
+        if (pool != nullptr)
+            pool->endBlock();
+    }
+    return buffer;
+}
+
+static float maxAbsDiff(const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b)
+{
+    float diff = 0.0f;
+    for (int ch = 0; ch < a.getNumChannels(); ++ch)
+        for (int i = 0; i < a.getNumSamples(); ++i)
+            diff = std::max(diff, std::fabs(a.getSample(ch, i) - b.getSample(ch, i)));
+    return diff;
+}
+
+TEST_CASE("FMSynth - Lane rendering matches scalar voices", "[synth]")
+{
+    // Only the order of the final voice summation differs between the paths
+    for (int algo = 0; algo < 6; ++algo)
+    {
+        TestVoiceParams tvp;
+        tvp.fmAlgo.store(static_cast<float>(algo));
+        tvp.mod1Level.store(0.7f);
+
+        auto scalar = renderChord(tvp.params, false, { 48, 55, 60, 64, 67 });
+        auto lanes  = renderChord(tvp.params, true,  { 48, 55, 60, 64, 67 });
+
+        REQUIRE_FALSE(test::hasNaN(lanes));
+        REQUIRE_FALSE(test::isSilent(lanes));
+        REQUIRE(maxAbsDiff(scalar, lanes) < 1.0e-5f);
+    }
+}
+
+TEST_CASE("FMSynth - Lane post-chain matches scalar voices", "[synth]")
+{
+    TestVoiceParams tvp;
+    tvp.filtOn.store(1.0f);
+    tvp.filtCutoff.store(1500.0f);
+    tvp.filtRes.store(0.6f);
+    tvp.filtType.store(2.0f);
+    tvp.xorOn.store(1.0f);
+    tvp.dispAmt.store(0.7f);
+    tvp.drive.store(3.0f);
+    tvp.carNoise.store(0.2f);
+    tvp.carSpread.store(0.8f);
+    tvp.vein.store(0.5f);
+    tvp.flux.store(0.4f);
+
+    // Odd block size exercises partial control sub-blocks
+    auto scalar = renderChord(tvp.params, false, { 40, 52, 59, 63 }, 8, 37);
+    auto lanes  = renderChord(tvp.params, true,  { 40, 52, 59, 63 }, 8, 37);
+
+    REQUIRE_FALSE(test::hasNaN(lanes));
+    REQUIRE(maxAbsDiff(scalar, lanes) < 1.0e-5f);
+}
+
+TEST_CASE("FMSynth - Non-sine patches fall back to scalar rendering", "[synth]")
+{
+    TestVoiceParams tvp;
+    tvp.carWave.store(1.0f); // Saw
+    tvp.syncOn.store(1.0f);
+
+    auto scalar = renderChord(tvp.params, false, { 48, 60, 67 });
+    auto lanes  = renderChord(tvp.params, true,  { 48, 60, 67 });
+
+    REQUIRE_FALSE(test::isSilent(lanes));
+    REQUIRE(maxAbsDiff(scalar, lanes) == 0.0f);
+}
+
+TEST_CASE("FMSynth - Sine patches are rendered by the lane kernel", "[synth]")
+{
+    TestVoiceParams tvp;
+    tvp.filtOn.store(1.0f);
+    tvp.drive.store(2.0f);
+    tvp.vein.store(0.5f);
+
+    auto laneVoiceBlocks = [&](bool lanes)
+    {
+        FMSynth synth;
+        prepareSynth(synth, tvp.params, lanes, 8, 512);
+        for (int n : { 48, 55, 60, 64, 67, 72 })
+            synth.noteOn(1, n, 0.8f);
+        juce::AudioBuffer<float> buffer(2, 512);
+        buffer.clear();
+        synth.renderNextBlock(buffer, juce::MidiBuffer(), 0, 512);
+        REQUIRE_FALSE(test::isSilent(buffer));
+        return synth.getNumLaneVoiceBlocks();
+    };
+
+    // One group of six lanes, none of them through the scalar voice path
+    REQUIRE(laneVoiceBlocks(true) == 6);
+    REQUIRE(laneVoiceBlocks(false) == 0);
+
+    tvp.carWave.store(1.0f); // Saw
+    REQUIRE(laneVoiceBlocks(true) == 0);
+}
+
+// Hors suite par défaut : ParasiteTests "[benchmark]"
+TEST_CASE("FMSynth - Lane rendering benchmark", "[.][benchmark]")
+{
+    // Eight sine voices through the whole post chain: one full lane group
+    // against the same voices rendered one by one
+    TestVoiceParams tvp;
+    tvp.mod1Level.store(0.7f);
+    tvp.filtOn.store(1.0f);
+    tvp.filtCutoff.store(3000.0f);
+    tvp.drive.store(2.0f);
+
+    for (bool lanes : { false, true })
+    {
+        FMSynth synth;
+        prepareSynth(synth, tvp.params, lanes, 8, 512);
+        for (int n : { 36, 43, 48, 55, 60, 64, 67, 72 })
+            synth.noteOn(1, n, 0.8f);
+        juce::AudioBuffer<float> buffer(2, 512);
+        juce::MidiBuffer midi;
+
+        BENCHMARK(lanes ? "8 voices, lanes" : "8 voices, scalar")
+        {
+            buffer.clear();
+            synth.renderNextBlock(buffer, midi, 0, 512);
+            return buffer.getSample(0, 511);
+        };
+        REQUIRE((synth.getNumLaneVoiceBlocks() > 0) == lanes);
+    }
+}
+
+TEST_CASE("FMSynth - More notes than lanes and voice stealing", "[synth]")
+{
+    TestVoiceParams tvp;
+
+    // 12 notes on 10 voices: two lane groups + steal fades inside a group
+    auto buf = renderChord(tvp.params, true,
+                           { 36, 40, 43, 48, 52, 55, 60, 64, 67, 72, 76, 79 }, 10);
+
+    REQUIRE_FALSE(test::hasNaN(buf));
+    REQUIRE_FALSE(test::isSilent(buf));
+    REQUIRE(test::peakAmplitude(buf) < 10.0f);
+}
+
+TEST_CASE("FMSynth - Worker pool rendering matches single-thread", "[synth]")
+{
+    TestVoiceParams tvp;
+    tvp.mod1Level.store(0.6f);
+    tvp.filtOn.store(1.0f);
+    tvp.filtCutoff.store(2000.0f);
+    const auto notes = { 36, 40, 43, 48, 52, 55, 60, 64, 67, 72, 76, 79 };
+
+    VoiceWorkerPool pool;
+    pool.start(3);
+    REQUIRE(pool.getNumWorkers() == 3);
+
+    for (bool lanes : { false, true })
+    {
+        // Saw keeps every voice scalar, Sine packs them into lane groups
+        tvp.carWave.store(lanes ? 0.0f : 1.0f);
+        auto single   = renderChord(tvp.params, lanes, notes, 16, 37);
+        auto parallel = renderChord(tvp.params, lanes, notes, 16, 37, kBlock, &pool);
+
+        REQUIRE_FALSE(test::isSilent(parallel));
+        // Jobs are summed in a fixed order: only the grouping differs
+        REQUIRE(maxAbsDiff(single, parallel) < 1.0e-5f);
+    }
+}
+
+static int countActiveVoices(const FMSynth& synth, int first, int last)
+{
+    int count = 0;
+    for (int i = first; i < last; ++i)
+        count += synth.getVoice(i)->isVoiceActive() ? 1 : 0;
+    return count;
+}
+
+TEST_CASE("FMSynth - Polyphony bounds the voices in use", "[synth]")
+{
+    TestVoiceParams tvp;
+    FMSynth synth;
+    synth.addSound(new FMSound());
+    for (int i = 0; i < 16; ++i)
+        synth.addVoice(new FMVoice(tvp.params));
+    synth.setCurrentPlaybackSampleRate(kSR);
+    for (int i = 0; i < synth.getNumVoices(); ++i)
+        static_cast<FMVoice*>(synth.getVoice(i))->prepareToPlay(kSR, 512);
+
+    juce::AudioBuffer<float> buffer(2, 512);
+    juce::MidiBuffer midi;
+    auto render = [&]
+    {
+        for (int b = 0; b < 40; ++b)
+        {
+            buffer.clear();
+            synth.renderNextBlock(buffer, midi, 0, 512);
+        }
+    };
+
+    synth.setPolyphony(4);
+    for (int n = 0; n < 8; ++n)
+        synth.noteOn(1, 48 + n, 0.8f);
+
+    // Extra notes steal inside the first four voices
+    REQUIRE(countActiveVoices(synth, 0, 4) == 4);
+    REQUIRE(countActiveVoices(synth, 4, 16) == 0);
+
+    // Raising it lets new notes spread over more voices
+    synth.setPolyphony(8);
+    for (int n = 0; n < 4; ++n)
+        synth.noteOn(1, 60 + n, 0.8f);
+    REQUIRE(countActiveVoices(synth, 0, 8) == 8);
+
+    // Lowering it releases the voices beyond the limit: they finish their
+    // release and stay idle, the others keep playing
+    synth.setPolyphony(2);
+    render();
+    REQUIRE(countActiveVoices(synth, 2, 16) == 0);
+    REQUIRE(countActiveVoices(synth, 0, 2) == 2);
+    REQUIRE_FALSE(test::isSilent(buffer));
+}
+
+static void addVoices(FMSynth& synth, VoiceParams& params, int numVoices)
+{
+    synth.addSound(new FMSound());
+    for (int i = 0; i < numVoices; ++i)
+        synth.addVoice(new FMVoice(params));
+    synth.setCurrentPlaybackSampleRate(kSR);
+    for (int i = 0; i < synth.getNumVoices(); ++i)
+        static_cast<FMVoice*>(synth.getVoice(i))->prepareToPlay(kSR, 512);
+}
+
+static bool isPlayingNote(const FMSynth& synth, int note)
+{
+    for (int i = 0; i < synth.getNumVoices(); ++i)
+        if (synth.getVoice(i)->isVoiceActive() && synth.getVoice(i)->getCurrentlyPlayingNote() == note)
+            return true;
+    return false;
+}
+
+TEST_CASE("FMSynth - MIDI events apply at their sample without splitting", "[synth]")
+{
+    TestVoiceParams tvp;
+    tvp.mod1Level.store(0.5f);
+
+    // One 512-sample block with note-on 60 at 192 and note-off 48 at 300,
+    // against the same events applied between blocks split at the events
+    FMSynth inBlock, split;
+    addVoices(inBlock, tvp.params, 4);
+    addVoices(split, tvp.params, 4);
+    inBlock.noteOn(1, 48, 0.8f);
+    split.noteOn(1, 48, 0.8f);
+
+    juce::AudioBuffer<float> a(2, 512), b(2, 512);
+    a.clear();
+    b.clear();
+    juce::MidiBuffer events, none;
+    events.addEvent(juce::MidiMessage::noteOn(1, 60, 0.8f), 192);
+    events.addEvent(juce::MidiMessage::noteOff(1, 48, 0.0f), 300);
+    inBlock.renderNextBlock(a, events, 0, 512);
+
+    split.renderNextBlock(b, none, 0, 192);
+    split.noteOn(1, 60, 0.8f);
+    split.renderNextBlock(b, none, 192, 108);
+    split.noteOff(1, 48, 0.0f, true);
+    split.renderNextBlock(b, none, 300, 212);
+
+    REQUIRE_FALSE(test::isSilent(a));
+    REQUIRE(maxAbsDiff(a, b) < 1.0e-5f);
+
+    // A note-on alone leaves the samples before it untouched
+    FMSynth late;
+    addVoices(late, tvp.params, 4);
+    juce::AudioBuffer<float> c(2, 512);
+    c.clear();
+    juce::MidiBuffer onAt300;
+    onAt300.addEvent(juce::MidiMessage::noteOn(1, 60, 0.8f), 300);
+    late.renderNextBlock(c, onAt300, 0, 512);
+    REQUIRE(test::peakAmplitude(c.getReadPointer(0), 300) == 0.0f);
+    REQUIRE(test::peakAmplitude(c.getReadPointer(0, 300), 212) > 0.0f);
+}
+
+TEST_CASE("FMSynth - Sustain pedal holds released notes", "[synth]")
+{
+    TestVoiceParams tvp;
+    tvp.env3R.store(0.01f);
+    FMSynth synth;
+    addVoices(synth, tvp.params, 4);
+
+    juce::AudioBuffer<float> buffer(2, 512);
+    juce::MidiBuffer midi;
+    auto render = [&](int numBlocks)
+    {
+        for (int i = 0; i < numBlocks; ++i)
+        {
+            buffer.clear();
+            synth.renderNextBlock(buffer, midi, 0, 512);
+        }
+    };
+
+    synth.noteOn(1, 48, 0.8f);
+    synth.handleController(1, 64, 127);
+    synth.noteOff(1, 48, 0.0f, true);
+    synth.noteOn(1, 52, 0.8f);   // pressed after the pedal: held by it too
+    synth.noteOff(1, 52, 0.0f, true);
+    render(20);
+    REQUIRE(countActiveVoices(synth, 0, 4) == 2);
+
+    synth.handleController(1, 64, 0);
+    render(20);
+    REQUIRE(countActiveVoices(synth, 0, 4) == 0);
+}
+
+TEST_CASE("FMSynth - Voice stealing policies", "[synth]")
+{
+    TestVoiceParams tvp;
+
+    // 48 played softly, then 60 loud, both held: Oldest keeps the low held
+    // note and takes the top one, Quietest takes the soft 48
+    auto playThird = [&tvp](FMSynth::StealPolicy policy)
+    {
+        auto synth = std::make_unique<FMSynth>();
+        addVoices(*synth, tvp.params, 2);
+        synth->setStealPolicy(policy);
+
+        juce::AudioBuffer<float> buffer(2, 512);
+        juce::MidiBuffer midi;
+        synth->noteOn(1, 48, 0.2f);
+        synth->renderNextBlock(buffer, midi, 0, 512);
+        synth->noteOn(1, 60, 1.0f);
+        for (int i = 0; i < 16; ++i)
+            synth->renderNextBlock(buffer, midi, 0, 512);
+        synth->noteOn(1, 72, 0.8f);
+        return synth;
+    };
+
+    auto oldest = playThird(FMSynth::StealPolicy::Oldest);
+    REQUIRE(isPlayingNote(*oldest, 48));
+    REQUIRE(isPlayingNote(*oldest, 72));
+
+    auto quietest = playThird(FMSynth::StealPolicy::Quietest);
+    REQUIRE(isPlayingNote(*quietest, 60));
+    REQUIRE(isPlayingNote(*quietest, 72));
+
+    // A repeated note: a second voice rings out the first one's release,
+    // unless SameNote restarts the voice already on it
+    for (auto policy : { FMSynth::StealPolicy::Oldest, FMSynth::StealPolicy::SameNote })
+    {
+        FMSynth synth;
+        addVoices(synth, tvp.params, 4);
+        synth.setStealPolicy(policy);
+
+        juce::AudioBuffer<float> buffer(2, 512);
+        juce::MidiBuffer midi;
+        synth.noteOn(1, 48, 0.8f);
+        synth.renderNextBlock(buffer, midi, 0, 512);
+        synth.noteOff(1, 48, 0.0f, true);
+        synth.renderNextBlock(buffer, midi, 0, 64);
+        synth.noteOn(1, 48, 0.8f);
+
+        REQUIRE(countActiveVoices(synth, 0, 4) == (policy == FMSynth::StealPolicy::SameNote ? 1 : 2));
+    }
+}
+
+TEST_CASE("FMSynth - Inaudible releases are retired early", "[synth]")
+{
+    // Pluck: fully decayed (sustain 0) before the key is released, then a
+    // 5 s release that would render silence until env3 ends
+    for (float sustain : { 0.0f, 0.5f })
+    {
+        TestVoiceParams tvp;
+        tvp.env3A.store(0.0f);
+        tvp.env3D.store(0.05f);
+        tvp.env3S.store(sustain);
+        tvp.env3R.store(5.0f);
+        FMSynth synth;
+        addVoices(synth, tvp.params, 2);
+
+        juce::AudioBuffer<float> buffer(2, 512);
+        juce::MidiBuffer midi;
+        synth.noteOn(1, 48, 0.8f);
+        for (int i = 0; i < 16; ++i)
+            synth.renderNextBlock(buffer, midi, 0, 512);
+
+        // Held: never culled, even once silent
+        REQUIRE(countActiveVoices(synth, 0, 2) == 1);
+
+        synth.noteOff(1, 48, 0.0f, true);
+        synth.renderNextBlock(buffer, midi, 0, 512);
+        REQUIRE(countActiveVoices(synth, 0, 2) == (sustain > 0.0f ? 1 : 0));
+    }
+}
+
+// Pitch of a plain sine voice, from its rising zero crossings
+static float estimateFrequency(const juce::AudioBuffer<float>& buffer)
+{
+    const float* x = buffer.getReadPointer(0);
+    int crossings = 0;
+    for (int i = 1; i < buffer.getNumSamples(); ++i)
+        crossings += (x[i - 1] < 0.0f && x[i] >= 0.0f) ? 1 : 0;
+    return static_cast<float>(crossings * kSR / buffer.getNumSamples());
+}
+
+TEST_CASE("FMSynth - Mono note priority and release to previous note", "[synth]")
+{
+    constexpr float f48 = 130.81f, f60 = 261.63f;
+    struct Case { FMSynth::NotePriority priority; float bothHeld; };
+
+    for (auto c : { Case { FMSynth::NotePriority::Last, f60 },
+                    Case { FMSynth::NotePriority::Low,  f48 },
+                    Case { FMSynth::NotePriority::High, f60 } })
+    {
+        TestVoiceParams tvp;
+        tvp.mono.store(1.0f);
+        tvp.mod1Level.store(0.0f);
+        tvp.mod2Level.store(0.0f);
+        FMSynth synth;
+        addVoices(synth, tvp.params, 4);
+        synth.setMonoMode(true, c.priority, /*legato*/ true);
+
+        juce::AudioBuffer<float> buffer(2, 4096);
+        juce::MidiBuffer midi;
+        auto pitch = [&]
+        {
+            buffer.clear();
+            synth.renderNextBlock(buffer, midi, 0, 4096);
+            buffer.clear();
+            synth.renderNextBlock(buffer, midi, 0, 4096);
+            return estimateFrequency(buffer);
+        };
+
+        synth.noteOn(1, 48, 0.8f);
+        synth.noteOn(1, 60, 0.8f);
+        REQUIRE(std::abs(pitch() - c.bothHeld) < 0.05f * c.bothHeld);
+        REQUIRE(countActiveVoices(synth, 0, 4) == 1);
+
+        // Released key: back to the one still held
+        synth.noteOff(1, 60, 0.0f, true);
+        REQUIRE(std::abs(pitch() - f48) < 0.05f * f48);
+        REQUIRE(countActiveVoices(synth, 0, 4) == 1);
+        REQUIRE(synth.getVoice(0)->isKeyDown());
+
+        synth.noteOff(1, 48, 0.0f, true);
+        REQUIRE(synth.getVoice(0)->isPlayingButReleased());
+    }
+}
+
+TEST_CASE("FMSynth - Mono legato keeps the envelopes running", "[synth]")
+{
+    // Decayed to the sustain level when the second key comes in: legato
+    // stays there, retrigger restarts the attack
+    float level[2] = {};
+    for (int legato = 0; legato < 2; ++legato)
+    {
+        TestVoiceParams tvp;
+        tvp.mono.store(1.0f);
+        tvp.retrig.store(legato ? 0.0f : 1.0f);
+        tvp.env3A.store(0.0f);
+        tvp.env3D.store(0.05f);
+        tvp.env3S.store(0.3f);
+        FMSynth synth;
+        addVoices(synth, tvp.params, 4);
+        synth.setMonoMode(true, FMSynth::NotePriority::Last, legato == 1);
+
+        juce::AudioBuffer<float> buffer(2, 512);
+        juce::MidiBuffer midi;
+        synth.noteOn(1, 48, 0.8f);
+        for (int i = 0; i < 16; ++i)
+            synth.renderNextBlock(buffer, midi, 0, 512);
+        synth.noteOn(1, 55, 0.8f);
+        synth.renderNextBlock(buffer, midi, 0, 64);
+
+        REQUIRE(countActiveVoices(synth, 0, 4) == 1);
+        level[legato] = static_cast<FMVoice*>(synth.getVoice(0))->getTrackedLevel();
+    }
+    REQUIRE(level[1] < 0.5f * level[0]);
+}
+
+TEST_CASE("FMSynth - Shared block snapshot renders like per-voice reads", "[synth]")
+{
+    // Same chord, same mid-note parameter change: with a snapshot captured
+    // once per block, or with every voice reading VoiceParams itself
+    TestVoiceParams tvp;
+    tvp.mod1Level.store(0.6f);
+    tvp.filtOn.store(1.0f);
+    tvp.filtCutoff.store(3000.0f);
+    tvp.vein.store(0.3f);
+    tvp.plasma.store(0.7f);
+    tvp.params.expression.store(0.9f);
+
+    juce::AudioBuffer<float> out[2];
+    for (int shared = 0; shared < 2; ++shared)
+    {
+        tvp.filtCutoff.store(3000.0f);
+        tvp.vortex.store(0.5f);
+
+        FMSynth synth;
+        VoiceBlockParams snapshot;
+        addVoices(synth, tvp.params, 4);
+        if (shared)
+            synth.setBlockParams(&snapshot);
+        for (int n : { 48, 55, 60, 64 })
+            synth.noteOn(1, n, 0.8f);
+
+        out[shared].setSize(2, kBlock);
+        out[shared].clear();
+        juce::MidiBuffer midi;
+        for (int pos = 0; pos < kBlock; pos += 512)
+        {
+            if (pos == kBlock / 2)
+            {
+                tvp.filtCutoff.store(800.0f);
+                tvp.vortex.store(0.8f);
+            }
+            snapshot.capture(tvp.params);
+            synth.renderNextBlock(out[shared], midi, pos, 512);
+        }
+    }
+
+    REQUIRE_FALSE(test::isSilent(out[1]));
+    REQUIRE(maxAbsDiff(out[0], out[1]) == 0.0f);
+}
+
+TEST_CASE("FMSynth - Snapshot recaptured only on change renders the same", "[synth]")
+{
+    // Le processeur ne recapture qu'à un changement de génération : les
+    // voix gardent alors leurs réglages dérivés, sans écart de rendu
+    TestVoiceParams tvp;
+    tvp.mod1Level.store(0.6f);
+    tvp.filtOn.store(1.0f);
+    tvp.unison.store(3.0f);
+    tvp.oversampling.store(1.0f);
+
+    juce::AudioBuffer<float> out[2];
+    for (int everyBlock = 0; everyBlock < 2; ++everyBlock)
+    {
+        tvp.filtCutoff.store(3000.0f);
+        tvp.carCoarse.store(1.0f);
+
+        FMSynth synth;
+        VoiceBlockParams snapshot;
+        addVoices(synth, tvp.params, 4);
+        synth.setBlockParams(&snapshot);
+        for (int n : { 48, 55, 60, 64 })
+            synth.noteOn(1, n, 0.8f);
+
+        out[everyBlock].setSize(2, kBlock);
+        out[everyBlock].clear();
+        juce::MidiBuffer midi;
+        for (int pos = 0; pos < kBlock; pos += 256)
+        {
+            const bool changed = pos == kBlock / 2;
+            if (changed)
+            {
+                tvp.filtCutoff.store(800.0f);
+                tvp.carCoarse.store(2.0f);
+            }
+            if (everyBlock || pos == 0 || changed)
+                snapshot.capture(tvp.params);
+            synth.renderNextBlock(out[everyBlock], midi, pos, 256);
+        }
+    }
+
+    REQUIRE_FALSE(test::isSilent(out[0]));
+    REQUIRE(maxAbsDiff(out[0], out[1]) == 0.0f);
+}
+
+TEST_CASE("FMSynth - Seeded noise renders reproducibly", "[synth]")
+{
+    TestVoiceParams tvp;
+    tvp.carNoise.store(1.0f);
+    tvp.mod1Level.store(0.0f);
+    tvp.mod2Level.store(0.0f);
+
+    auto render = [&](uint32_t seed)
+    {
+        FMSynth synth;
+        addVoices(synth, tvp.params, 2);
+        synth.setNoiseSeed(seed);
+        synth.noteOn(1, 60, 0.8f);
+        juce::AudioBuffer<float> out(2, kBlock);
+        out.clear();
+        juce::MidiBuffer midi;
+        synth.renderNextBlock(out, midi, 0, kBlock);
+        return out;
+    };
+
+    auto a = render(5);
+    auto b = render(5);
+    auto c = render(6);
+    REQUIRE_FALSE(test::isSilent(a));
+    REQUIRE(maxAbsDiff(a, b) == 0.0f);
+    REQUIRE(maxAbsDiff(a, c) > 0.0f);
+
+    // L et R tirés de flux distincts
+    float diffLR = 0.0f;
+    for (int i = 0; i < kBlock; ++i)
+        diffLR = std::max(diffLR, std::abs(a.getSample(0, i) - a.getSample(1, i)));
+    REQUIRE(diffLR > 0.1f);
+}
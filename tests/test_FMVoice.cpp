@@ -3,82 +3,14 @@
 #include "dsp/FMVoice.h"
 #include "dsp/FMSound.h"
 #include "TestHelpers.h"
+#include "TestVoiceParams.h"
 
 using namespace bb;
+using test::TestVoiceParams;
 
 static constexpr double kSR = 44100.0;
 static constexpr int kBlock = 4096;
 
-// Helper: set up VoiceParams with local atomics (no APVTS needed)
-struct TestVoiceParams
-{
-    // Owned atomic storage
-    std::atomic<float> mod1On{1.0f}, mod1Wave{0.0f}, mod1KB{1.0f}, mod1Level{0.5f};
-    std::atomic<float> mod1Coarse{1.0f}, mod1Fine{0.0f}, mod1FixedFreq{440.0f}, mod1Multi{4.0f};
-    std::atomic<float> env1A{0.01f}, env1D{0.3f}, env1S{0.7f}, env1R{0.3f};
-
-    std::atomic<float> mod2On{1.0f}, mod2Wave{0.0f}, mod2KB{1.0f}, mod2Level{0.5f};
-    std::atomic<float> mod2Coarse{1.0f}, mod2Fine{0.0f}, mod2FixedFreq{440.0f}, mod2Multi{4.0f};
-    std::atomic<float> env2A{0.01f}, env2D{0.3f}, env2S{0.7f}, env2R{0.3f};
-
-    std::atomic<float> carWave{0.0f}, carCoarse{1.0f}, carFine{0.0f};
-    std::atomic<float> carFixedFreq{440.0f}, carMulti{4.0f}, carKB{1.0f};
-    std::atomic<float> carNoise{0.0f}, carSpread{0.0f};
-    std::atomic<float> env3A{0.01f}, env3D{0.3f}, env3S{1.0f}, env3R{0.3f};
-
-    std::atomic<float> tremor{0.0f}, vein{0.0f}, flux{0.0f};
-    std::atomic<float> xorOn{0.0f}, syncOn{0.0f}, fmAlgo{0.0f};
-
-    std::atomic<float> pitchEnvOn{0.0f}, pitchEnvAmt{0.0f};
-    std::atomic<float> pitchEnvA{0.001f}, pitchEnvD{0.15f}, pitchEnvS{0.0f}, pitchEnvR{0.1f};
-
-    std::atomic<float> filtOn{0.0f}, filtCutoff{20000.0f}, filtRes{0.0f}, filtType{0.0f};
-
-    std::atomic<float> volume{0.8f}, drive{0.0f}, mono{0.0f}, retrig{0.0f};
-    std::atomic<float> porta{0.0f}, dispAmt{0.0f}, carDrift{0.0f};
-    std::atomic<float> cortex{0.5f}, ichor{0.0f}, plasma{0.5f}, macroTime{0.5f};
-
-    HarmonicTable mod1Harmonics, mod2Harmonics, carHarmonics;
-    VoiceParams params;
-
-    TestVoiceParams()
-    {
-        params.mod1On = &mod1On; params.mod1Wave = &mod1Wave; params.mod1KB = &mod1KB;
-        params.mod1Level = &mod1Level; params.mod1Coarse = &mod1Coarse; params.mod1Fine = &mod1Fine;
-        params.mod1FixedFreq = &mod1FixedFreq; params.mod1Multi = &mod1Multi;
-        params.env1A = &env1A; params.env1D = &env1D; params.env1S = &env1S; params.env1R = &env1R;
-
-        params.mod2On = &mod2On; params.mod2Wave = &mod2Wave; params.mod2KB = &mod2KB;
-        params.mod2Level = &mod2Level; params.mod2Coarse = &mod2Coarse; params.mod2Fine = &mod2Fine;
-        params.mod2FixedFreq = &mod2FixedFreq; params.mod2Multi = &mod2Multi;
-        params.env2A = &env2A; params.env2D = &env2D; params.env2S = &env2S; params.env2R = &env2R;
-
-        params.carWave = &carWave; params.carCoarse = &carCoarse; params.carFine = &carFine;
-        params.carFixedFreq = &carFixedFreq; params.carMulti = &carMulti; params.carKB = &carKB;
-        params.carNoise = &carNoise; params.carSpread = &carSpread;
-        params.env3A = &env3A; params.env3D = &env3D; params.env3S = &env3S; params.env3R = &env3R;
-
-        params.tremor = &tremor; params.vein = &vein; params.flux = &flux;
-        params.xorOn = &xorOn; params.syncOn = &syncOn; params.fmAlgo = &fmAlgo;
-
-        params.pitchEnvOn = &pitchEnvOn; params.pitchEnvAmt = &pitchEnvAmt;
-        params.pitchEnvA = &pitchEnvA; params.pitchEnvD = &pitchEnvD;
-        params.pitchEnvS = &pitchEnvS; params.pitchEnvR = &pitchEnvR;
-
-        params.filtOn = &filtOn; params.filtCutoff = &filtCutoff;
-        params.filtRes = &filtRes; params.filtType = &filtType;
-
-        params.volume = &volume; params.drive = &drive; params.mono = &mono;
-        params.retrig = &retrig; params.porta = &porta; params.dispAmt = &dispAmt;
-        params.carDrift = &carDrift; params.cortex = &cortex; params.ichor = &ichor;
-        params.plasma = &plasma; params.macroTime = &macroTime;
-
-        params.mod1Harmonics = &mod1Harmonics;
-        params.mod2Harmonics = &mod2Harmonics;
-        params.carHarmonics = &carHarmonics;
-    }
-};
-
 // Render a note through FMVoice and return the buffer
 static juce::AudioBuffer<float> renderNote(VoiceParams& params, int note = 60,
                                            float velocity = 0.8f, int numSamples = kBlock)
@@ -187,3 +119,263 @@ TEST_CASE("FMVoice - Voice stealing fade-out", "[voice]")
     float endRms = test::rms(buf.getReadPointer(0) + kBlock - 100, 100);
     REQUIRE(endRms < 0.1f);
 }
+
+TEST_CASE("FMVoice - Mono output buffer receives the left channel", "[voice]")
+{
+    TestVoiceParams tvp;
+    tvp.carSpread.store(0.5f);
+
+    auto stereo = renderNote(tvp.params);
+
+    FMVoice voice(tvp.params);
+    voice.prepareToPlay(kSR, 512);
+    juce::AudioBuffer<float> mono(1, kBlock);
+    mono.clear();
+    FMSound sound;
+    voice.startNote(60, 0.8f, &sound, 8192);
+    voice.renderNextBlock(mono, 0, kBlock);
+
+    for (int i = 0; i < kBlock; ++i)
+        REQUIRE(mono.getSample(0, i) == stereo.getSample(0, i));
+}
+
+TEST_CASE("FMVoice - Out-of-range algorithm renders as Series", "[voice]")
+{
+    TestVoiceParams series, invalid;
+    series.mod1Level.store(0.7f);
+    invalid.mod1Level.store(0.7f);
+    invalid.fmAlgo.store(9.0f);
+
+    auto a = renderNote(series.params);
+    auto b = renderNote(invalid.params);
+
+    for (int i = 0; i < kBlock; ++i)
+        REQUIRE(a.getSample(0, i) == b.getSample(0, i));
+}
+
+TEST_CASE("FMVoice - Muted modulator still drives hard sync", "[voice]")
+{
+    // Mod1 at level 0 is skipped by the kernel, but its phase keeps
+    // running so the sync pulses it emits must still reset the carrier.
+    TestVoiceParams free, synced;
+    for (auto* t : { &free, &synced })
+    {
+        t->mod1Level.store(0.0f);
+        t->mod2Level.store(0.0f);
+        t->mod1Coarse.store(3.0f);
+        t->carWave.store(1.0f); // Saw
+    }
+    synced.syncOn.store(1.0f);
+
+    auto a = renderNote(free.params);
+    auto b = renderNote(synced.params);
+
+    REQUIRE_FALSE(test::isSilent(b));
+    float diff = 0.0f;
+    for (int i = 0; i < kBlock; ++i)
+        diff = std::max(diff, std::fabs(a.getSample(0, i) - b.getSample(0, i)));
+    REQUIRE(diff > 0.1f);
+}
+
+TEST_CASE("FMVoice - Control-rate modulation stays close to per-sample", "[voice]")
+{
+    auto setup = [](TestVoiceParams& t, float rate)
+    {
+        t.modRate.store(rate);
+        t.tremor.store(0.8f);
+        t.vein.store(0.6f);
+        t.filtOn.store(1.0f);
+        t.filtCutoff.store(1200.0f);
+        t.filtRes.store(0.4f);
+    };
+
+    TestVoiceParams ref;
+    setup(ref, 0.0f);
+    auto a = renderNote(ref.params);
+
+    for (int rate = 1; rate < FMVoice::kNumModRates; ++rate)
+    {
+        TestVoiceParams t;
+        setup(t, static_cast<float>(rate));
+        auto b = renderNote(t.params);
+
+        REQUIRE_FALSE(test::hasNaN(b));
+        float diff = 0.0f;
+        for (int i = 0; i < kBlock; ++i)
+            diff = std::max(diff, std::fabs(a.getSample(0, i) - b.getSample(0, i)));
+        REQUIRE(diff < 1.0e-2f);
+    }
+}
+
+TEST_CASE("FMVoice - HQ render forces per-sample modulation", "[voice]")
+{
+    TestVoiceParams ref, hq;
+    for (auto* t : { &ref, &hq })
+    {
+        t->tremor.store(0.8f);
+        t->vein.store(0.6f);
+        t->filtOn.store(1.0f);
+        t->filtCutoff.store(1200.0f);
+    }
+    hq.modRate.store(3.0f);
+    hq.params.hqRender.store(true);
+
+    auto a = renderNote(ref.params);
+    auto b = renderNote(hq.params);
+
+    for (int i = 0; i < kBlock; ++i)
+        REQUIRE(a.getSample(0, i) == b.getSample(0, i));
+}
+
+TEST_CASE("FMVoice - Oversampled render keeps the level", "[voice]")
+{
+    auto setup = [](TestVoiceParams& t, float os)
+    {
+        t.oversampling.store(os);
+        t.filtOn.store(1.0f);
+        t.filtCutoff.store(3000.0f);
+        t.drive.store(0.5f);
+    };
+
+    TestVoiceParams ref;
+    setup(ref, 0.0f);
+    auto a = renderNote(ref.params);
+    const float refRms = test::rms(a.getReadPointer(0) + kBlock / 2, kBlock / 2);
+
+    for (int os = 1; os <= 2; ++os)
+    {
+        TestVoiceParams t;
+        setup(t, static_cast<float>(os));
+        auto b = renderNote(t.params);
+
+        REQUIRE_FALSE(test::hasNaN(b));
+        REQUIRE_FALSE(test::isSilent(b));
+        const float r = test::rms(b.getReadPointer(0) + kBlock / 2, kBlock / 2);
+        REQUIRE(std::fabs(r - refRms) < 0.1f * refRms);
+    }
+}
+
+TEST_CASE("FMVoice - Antialiased fold lands closer to the oversampled render", "[voice]")
+{
+    auto render = [](float aa, float os)
+    {
+        TestVoiceParams t;
+        t.antialias.store(aa);
+        t.oversampling.store(os);
+        t.dispAmt.store(0.7f);
+        auto buf = renderNote(t.params);
+        REQUIRE_FALSE(test::hasNaN(buf));
+        return test::rms(buf.getReadPointer(0) + kBlock / 2, kBlock / 2);
+    };
+
+    // Folding at 1x adds aliased energy; ADAA removes most of it
+    const float reference = render(0.0f, 2.0f);
+    const float plain = render(0.0f, 0.0f);
+    const float adaa  = render(1.0f, 0.0f);
+    REQUIRE(std::fabs(adaa - reference) < std::fabs(plain - reference));
+}
+
+TEST_CASE("FMVoice - Unison stack spreads the carrier copies", "[voice]")
+{
+    auto render = [](int voices, float width, float wave, float os, float sync)
+    {
+        TestVoiceParams t;
+        t.unison.store(static_cast<float>(voices));
+        t.unisonDetune.store(0.5f);
+        t.unisonWidth.store(width);
+        t.carWave.store(wave);
+        t.oversampling.store(os);
+        t.syncOn.store(sync);
+        return renderNote(t.params);
+    };
+
+    // Sans largeur, les copies restent au centre : L == R
+    auto narrow = render(4, 0.0f, 0.0f, 0.0f, 0.0f);
+    REQUIRE_FALSE(test::isSilent(narrow));
+    for (int i = 0; i < kBlock; ++i)
+        REQUIRE(narrow.getSample(0, i) == narrow.getSample(1, i));
+
+    // Toutes les formes, suréchantillonné ou non, sync ou non
+    for (int wave = 0; wave <= 5; ++wave)
+        for (int os = 0; os <= 1; ++os)
+            for (int sync = 0; sync <= 1; ++sync)
+            {
+                auto buf = render(7, 1.0f, static_cast<float>(wave),
+                                  static_cast<float>(os), static_cast<float>(sync));
+                REQUIRE_FALSE(test::hasNaN(buf));
+                REQUIRE_FALSE(test::isSilent(buf));
+                REQUIRE(test::peakAmplitude(buf) < 3.0f);
+
+                float diff = 0.0f;
+                for (int i = 0; i < kBlock; ++i)
+                    diff = std::max(diff, std::fabs(buf.getSample(0, i) - buf.getSample(1, i)));
+                REQUIRE(diff > 0.01f);
+            }
+
+    // Niveau normalisé : 8 copies restent du même ordre qu'une seule
+    const float single = test::rms(render(1, 0.0f, 0.0f, 0.0f, 0.0f).getReadPointer(0) + kBlock / 2, kBlock / 2);
+    const float stack  = test::rms(render(8, 0.0f, 0.0f, 0.0f, 0.0f).getReadPointer(0) + kBlock / 2, kBlock / 2);
+    REQUIRE(stack > 0.3f * single);
+    REQUIRE(stack < 2.0f * single);
+}
+
+TEST_CASE("FMVoice - 4-operator algorithms render", "[voice]")
+{
+    for (int algo = 0; algo < opgraph::kNumAlgos; ++algo)
+    {
+        TestVoiceParams tvp;
+        tvp.mod3On.store(1.0f);
+        tvp.opAlgo.store(static_cast<float>(algo));
+        tvp.mod3Level.store(0.6f);
+        tvp.mod3Feedback.store(0.5f);
+        tvp.mod3Coarse.store(3.0f);
+
+        auto buf = renderNote(tvp.params);
+        REQUIRE_FALSE(test::hasNaN(buf));
+        REQUIRE_FALSE(test::isSilent(buf));
+        REQUIRE(test::peakAmplitude(buf) < 3.0f);
+    }
+}
+
+TEST_CASE("FMVoice - 4-operator graphs prune operators that cannot be heard", "[voice]")
+{
+    using opgraph::bit;
+    // 4 → 3 → 2 → 1 sans op 3 : op 4 ne module plus rien d'audible
+    STATIC_REQUIRE(opgraph::liveOperators(opgraph::kRoutes[0], bit(1) | bit(3)) == (bit(0) | bit(1)));
+    // 4 → (1, 2, 3) : op 4 reste utile via le carrier
+    STATIC_REQUIRE(opgraph::liveOperators(opgraph::kRoutes[5], bit(3)) == (bit(0) | bit(3)));
+
+    auto render = [](float algo, float mod2Level, float mod3Level)
+    {
+        TestVoiceParams t;
+        t.mod3On.store(1.0f);
+        t.opAlgo.store(algo);
+        t.mod2Level.store(mod2Level);
+        t.mod3Level.store(mod3Level);
+        return renderNote(t.params);
+    };
+
+    // 2 → 1 | 4 → 3 : op 3 muet, op 4 élagué → même rendu que sans op 4
+    auto pruned = render(4.0f, 0.0f, 0.6f);
+    auto silent = render(4.0f, 0.0f, 0.0f);
+    for (int i = 0; i < kBlock; ++i)
+        REQUIRE(pruned.getSample(0, i) == silent.getSample(0, i));
+
+    // Quatre carriers, op 4 muet : identique à l'algo Mix classique
+    auto allOut = render(7.0f, 0.5f, 0.0f);
+    TestVoiceParams mix;
+    mix.fmAlgo.store(5.0f);
+    auto classic = renderNote(mix.params);
+    for (int i = 0; i < kBlock; ++i)
+        REQUIRE(allOut.getSample(0, i) == classic.getSample(0, i));
+}
+
+TEST_CASE("FMVoice - Hot state fits its cache-line budget", "[voice]")
+{
+    // Everything the per-sample loops touch: oscillators, envelopes,
+    // per-voice LFOs, filters, smoothers. Growing past this budget means
+    // something cold slipped into HotState.
+    static constexpr std::size_t kBudgetLines = 28;
+    REQUIRE(FMVoice::getHotStateCacheLines() <= kBudgetLines);
+    REQUIRE(FMVoice::getHotStateSize() <= kBudgetLines * FMVoice::kCacheLineSize);
+}
@@ -0,0 +1,81 @@
+// test_FastMath.cpp — Tests for bb::fastmath (accuracy against libm)
+#include <catch2/catch_test_macros.hpp>
+#include "dsp/FastMath.h"
+#include <cmath>
+
+using namespace bb;
+
+// Sweep [lo, hi] in `steps` points and return the max error of approx vs
+// reference, absolute or relative to |reference|
+template <typename Approx, typename Ref>
+static double maxError(Approx approx, Ref ref, double lo, double hi, int steps, bool relative)
+{
+    double worst = 0.0;
+    for (int i = 0; i <= steps; ++i)
+    {
+        float x = static_cast<float>(lo + (hi - lo) * i / steps);
+        double want = ref(static_cast<double>(x));
+        double err = std::fabs(static_cast<double>(approx(x)) - want);
+        if (relative)
+            err /= std::max(std::fabs(want), 1.0e-30);
+        worst = std::max(worst, err);
+    }
+    return worst;
+}
+
+static constexpr int kSteps = 200000;
+static constexpr double kPi = 3.14159265358979323846;
+
+TEST_CASE("FastMath - exp2 relative error", "[fastmath]")
+{
+    auto ref = [](double x) { return std::exp2(x); };
+    REQUIRE(maxError(fastmath::exp2, ref, -126.0, 127.0, kSteps, true) < 3.0e-7);
+    REQUIRE(maxError(fastmath::exp2, ref, -4.0, 4.0, kSteps, true) < 3.0e-7);
+    REQUIRE(fastmath::exp2(0.0f) == 1.0f);
+    REQUIRE(std::isfinite(fastmath::exp2(500.0f)));
+    REQUIRE(fastmath::exp2(-500.0f) >= 0.0f);
+}
+
+TEST_CASE("FastMath - log2 absolute error", "[fastmath]")
+{
+    auto ref = [](double x) { return std::log2(x); };
+    REQUIRE(maxError(fastmath::log2, ref, 1.0e-6, 1.0, kSteps, false) < 1.0e-6);
+    REQUIRE(maxError(fastmath::log2, ref, 1.0, 20000.0, kSteps, false) < 1.0e-6);
+}
+
+TEST_CASE("FastMath - pow relative error", "[fastmath]")
+{
+    // Cutoff skew mapping and exponential ranges used by the effects
+    for (float b : { 0.2299f, 4.3497f, 0.5f, 2.0f, -1.0f })
+    {
+        auto approx = [b](float a) { return fastmath::pow(a, b); };
+        auto ref = [b](double a) { return std::pow(a, static_cast<double>(b)); };
+        REQUIRE(maxError(approx, ref, 1.0e-3, 1.0, kSteps / 10, true) < 4.0e-6);
+        REQUIRE(maxError(approx, ref, 1.0, 40.0, kSteps / 10, true) < 4.0e-6);
+    }
+    REQUIRE(fastmath::pow(0.0f, 0.2299f) == 0.0f);
+}
+
+TEST_CASE("FastMath - sin absolute error", "[fastmath]")
+{
+    auto ref = [](double x) { return std::sin(x); };
+    REQUIRE(maxError(fastmath::sin, ref, -kPi, kPi, kSteps, false) < 2.0e-7);
+    REQUIRE(maxError(fastmath::sin, ref, -1000.0, 1000.0, kSteps, false) < 2.0e-6);
+}
+
+TEST_CASE("FastMath - tan relative error up to 0.49 pi", "[fastmath]")
+{
+    auto ref = [](double x) { return std::tan(x); };
+    REQUIRE(maxError(fastmath::tan, ref, 1.0e-5, 0.49 * kPi, kSteps, true) < 5.0e-6);
+    REQUIRE(maxError(fastmath::tan, ref, -0.49 * kPi, -1.0e-5, kSteps, true) < 5.0e-6);
+}
+
+TEST_CASE("FastMath - tanh absolute error and saturation", "[fastmath]")
+{
+    auto ref = [](double x) { return std::tanh(x); };
+    REQUIRE(maxError(fastmath::tanh, ref, -20.0, 20.0, kSteps, false) < 2.0e-7);
+    REQUIRE(maxError(fastmath::tanh, ref, -0.5, 0.5, kSteps, false) < 2.0e-7);
+    REQUIRE(fastmath::tanh(0.0f) == 0.0f);
+    REQUIRE(fastmath::tanh(1.0e6f) <= 1.0f);
+    REQUIRE(fastmath::tanh(-1.0e6f) >= -1.0f);
+}
@@ -0,0 +1,133 @@
+// test_HalfBand.cpp — Tests for bb::OversamplingDecimator (half-band polyphase)
+#include <catch2/catch_test_macros.hpp>
+#include "dsp/HalfBand.h"
+#include "TestHelpers.h"
+#include <cmath>
+#include <vector>
+
+using namespace bb;
+
+static constexpr double kPi = 3.14159265358979323846;
+
+// Decimate a sine at `cyclesPerInput` (fraction of the oversampled rate) and
+// return the steady-state gain (output RMS / input RMS)
+static float decimatedGain(int factor, double cyclesPerInput, int numOut = 2048)
+{
+    OversamplingDecimator dec;
+    dec.reset();
+    std::vector<float> in(static_cast<size_t>(numOut * factor));
+    std::vector<float> out(static_cast<size_t>(numOut));
+    for (size_t i = 0; i < in.size(); ++i)
+        in[i] = static_cast<float>(std::sin(2.0 * kPi * cyclesPerInput * static_cast<double>(i)));
+    dec.process(in.data(), out.data(), numOut, factor);
+    return test::rms(out.data() + numOut / 2, numOut / 2) * std::sqrt(2.0f);
+}
+
+TEST_CASE("HalfBand - DC passes with unity gain", "[halfband]")
+{
+    for (int factor : { 2, 4 })
+    {
+        OversamplingDecimator dec;
+        dec.reset();
+        std::vector<float> in(static_cast<size_t>(256 * factor), 1.0f), out(256);
+        dec.process(in.data(), out.data(), 256, factor);
+        REQUIRE(std::fabs(out[255] - 1.0f) < 1.0e-4f);
+    }
+}
+
+TEST_CASE("HalfBand - Passband flat, images rejected", "[halfband]")
+{
+    for (int factor : { 2, 4 })
+    {
+        // 0.2 of the base rate: audible band, must pass
+        REQUIRE(std::fabs(decimatedGain(factor, 0.2 / factor) - 1.0f) < 2.0e-3f);
+        // 0.65 of the base rate: would fold back to 0.35, must be gone (< -70 dB)
+        REQUIRE(decimatedGain(factor, 0.65 / factor) < 3.0e-4f);
+    }
+    // 4×: content between 2× Nyquist and 4× Nyquist is removed by stage 1
+    REQUIRE(decimatedGain(4, 0.45) < 3.0e-4f);
+}
+
+TEST_CASE("HalfBand - Reported latency matches the impulse response peak", "[halfband]")
+{
+    REQUIRE(OversamplingDecimator::latency(1) == 0);
+    for (int factor : { 2, 4 })
+    {
+        OversamplingDecimator dec;
+        dec.reset();
+        std::vector<float> in(static_cast<size_t>(64 * factor), 0.0f), out(64);
+        in[0] = 1.0f;
+        dec.process(in.data(), out.data(), 64, factor);
+
+        int peakAt = 0;
+        for (int i = 1; i < 64; ++i)
+            if (std::fabs(out[i]) > std::fabs(out[peakAt])) peakAt = i;
+        REQUIRE(peakAt == OversamplingDecimator::latency(factor));
+    }
+}
+
+// Amplitude of the `cycles` component (fraction of the sample rate) in the
+// second half of `x`, by correlation with a complex exponential
+static double toneAmplitude(const std::vector<float>& x, double cycles)
+{
+    const size_t start = x.size() / 2;
+    double re = 0.0, im = 0.0;
+    for (size_t n = start; n < x.size(); ++n)
+    {
+        re += x[n] * std::cos(2.0 * kPi * cycles * static_cast<double>(n));
+        im += x[n] * std::sin(2.0 * kPi * cycles * static_cast<double>(n));
+    }
+    return 2.0 * std::sqrt(re * re + im * im) / static_cast<double>(x.size() - start);
+}
+
+static std::vector<float> interpolateSine(int factor, double cyclesPerInput, int numIn = 4096)
+{
+    OversamplingInterpolator up;
+    up.reset();
+    std::vector<float> in(static_cast<size_t>(numIn));
+    std::vector<float> out(static_cast<size_t>(numIn * factor));
+    for (size_t i = 0; i < in.size(); ++i)
+        in[i] = static_cast<float>(std::sin(2.0 * kPi * cyclesPerInput * static_cast<double>(i)));
+    up.process(in.data(), out.data(), numIn, factor);
+    return out;
+}
+
+TEST_CASE("HalfBand - Interpolator keeps the tone and rejects images", "[halfband]")
+{
+    for (int factor : { 2, 4 })
+    {
+        auto out = interpolateSine(factor, 0.2);
+        REQUIRE(std::fabs(toneAmplitude(out, 0.2 / factor) - 1.0) < 2.0e-3);
+        // First image at 0.8 of the input rate (< -70 dB)
+        REQUIRE(toneAmplitude(out, 0.8 / factor) < 3.0e-4);
+    }
+    // 4×: the 2× → 4× stage removes the image around the 2× rate
+    REQUIRE(toneAmplitude(interpolateSine(4, 0.2), 1.8 / 4.0) < 3.0e-4);
+}
+
+TEST_CASE("HalfBand - Interpolate then decimate is a pure fractional delay", "[halfband]")
+{
+    OversamplingInterpolator up;
+    OversamplingDecimator down;
+    up.reset();
+    down.reset();
+
+    constexpr int kN = 512;
+    std::vector<float> in(kN), wide(kN * 2), back(kN);
+    for (int i = 0; i < kN; ++i)
+        in[static_cast<size_t>(i)] = static_cast<float>(std::sin(2.0 * kPi * 0.05 * i) + 0.3 * std::sin(2.0 * kPi * 0.17 * i));
+
+    up.process(in.data(), wide.data(), kN, 2);
+    down.process(wide.data(), back.data(), kN, 2);
+
+    // Interpolator delay (2× samples) + decimator delay (1× samples)
+    const double delay = OversamplingInterpolator::latency(2) / 2.0 + OversamplingDecimator::latency(2);
+    float worst = 0.0f;
+    for (int i = 128; i < kN; ++i)
+    {
+        const double t = i - delay;
+        const float want = static_cast<float>(std::sin(2.0 * kPi * 0.05 * t) + 0.3 * std::sin(2.0 * kPi * 0.17 * t));
+        worst = std::max(worst, std::fabs(back[static_cast<size_t>(i)] - want));
+    }
+    REQUIRE(worst < 2.0e-3f);
+}
@@ -3,6 +3,7 @@
 #include "dsp/HemoFold.h"
 #include "dsp/Oscillator.h"
 #include "TestHelpers.h"
+#include <vector>
 
 using namespace bb;
 
@@ -81,3 +82,55 @@ TEST_CASE("HemoFold - Stability at max amount with loud input", "[fold]")
     // Should not blow up (bounded by tanh/sin)
     REQUIRE(test::peakAmplitude(buf, kBlock) < 3.0f);
 }
+
+// Energy away from the harmonics of f0 (aliases) relative to the total,
+// Hann-windowed DFT of the steady-state output
+static double inharmonicRatio(HemoFold& fold, double f0)
+{
+    constexpr int kSettle = 2048, kN = 4096;
+    constexpr double kTwoPi = 6.283185307179586;
+    std::vector<double> y(kN);
+    for (int i = 0; i < kSettle + kN; ++i)
+    {
+        float x = 0.8f * static_cast<float>(std::sin(kTwoPi * f0 * i / kSR));
+        float out = fold.tick(x);
+        if (i >= kSettle) y[static_cast<size_t>(i - kSettle)] = out * (0.5 - 0.5 * std::cos(kTwoPi * (i - kSettle) / kN));
+    }
+
+    const double binHz = kSR / kN;
+    double total = 0.0, inharmonic = 0.0;
+    for (int bin = 1; bin < kN / 2; ++bin)
+    {
+        double re = 0.0, im = 0.0;
+        for (int n = 0; n < kN; ++n)
+        {
+            re += y[static_cast<size_t>(n)] * std::cos(kTwoPi * bin * n / kN);
+            im -= y[static_cast<size_t>(n)] * std::sin(kTwoPi * bin * n / kN);
+        }
+        double p = re * re + im * im;
+        double hz = bin * binHz;
+        double nearest = std::round(hz / f0) * f0;
+        total += p;
+        if (std::fabs(hz - nearest) > 4.0 * binHz)
+            inharmonic += p;
+    }
+    return inharmonic / total;
+}
+
+TEST_CASE("HemoFold - Antialias reduces aliasing", "[fold]")
+{
+    for (float amount : { 0.5f, 0.7f })
+    {
+        HemoFold plain, adaa;
+        for (auto* f : { &plain, &adaa })
+        {
+            f->prepare(kSR);
+            f->setAmount(amount);
+        }
+        adaa.setAntialias(true);
+
+        double aliasPlain = inharmonicRatio(plain, 2950.0);
+        double aliasAdaa  = inharmonicRatio(adaa, 2950.0);
+        REQUIRE(aliasAdaa < aliasPlain * 0.5);
+    }
+}
@@ -202,3 +202,31 @@ TEST_CASE("LFO - getUniPeak for standard vs custom", "[lfo]")
     lfo.resetCurve();
     REQUIRE_THAT(static_cast<double>(lfo.getUniPeak()), WithinAbs(0.5, 0.01));
 }
+
+TEST_CASE("LFO - Block render matches per-sample ticks", "[lfo]")
+{
+    // Per-voice LFOs render a sub-block at once: quadrature for Sine,
+    // plain ticks for the other shapes
+    for (auto wave : { LFOWaveType::Sine, LFOWaveType::Triangle, LFOWaveType::Square })
+    {
+        LFOCore ref, block;
+        SineRotation rotation;
+        for (auto* l : { &ref, &block })
+        {
+            l->prepare(kSR);
+            l->setRate(3.5f);
+            l->setWaveType(wave);
+        }
+
+        float out[32];
+        float maxDiff = 0.0f;
+        for (int b = 0; b < 200; ++b)
+        {
+            block.renderBlock(out, 32, rotation);
+            for (int i = 0; i < 32; ++i)
+                maxDiff = std::max(maxDiff, std::fabs(ref.tick() - out[i]));
+        }
+        REQUIRE(maxDiff < 1.0e-4f);
+        REQUIRE_THAT(block.getPhase(), WithinAbs(ref.getPhase(), 1.0e-6));
+    }
+}
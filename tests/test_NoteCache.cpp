@@ -0,0 +1,171 @@
+// test_NoteCache.cpp — Tests for bb::NoteCache (replay of repeated notes)
+#include <catch2/catch_test_macros.hpp>
+#include "dsp/FMSynth.h"
+#include "dsp/FMSound.h"
+#include "dsp/NoteCache.h"
+#include "TestHelpers.h"
+#include "TestVoiceParams.h"
+
+using namespace bb;
+using test::TestVoiceParams;
+
+static constexpr double kSR = 44100.0;
+static constexpr int kHitLength = 16384;
+
+// Percussive patch: FM + filter + fold, decays to silence after release
+static void setupDrumPatch(TestVoiceParams& tvp)
+{
+    tvp.noteCache.store(1.0f);
+    tvp.mod1Level.store(0.7f);
+    tvp.env1A.store(0.0f);  tvp.env1D.store(0.08f); tvp.env1S.store(0.1f); tvp.env1R.store(0.05f);
+    tvp.env3A.store(0.0f);  tvp.env3D.store(0.2f);  tvp.env3S.store(0.3f); tvp.env3R.store(0.05f);
+    tvp.pitchEnvOn.store(1.0f);
+    tvp.pitchEnvAmt.store(24.0f);
+    tvp.filtOn.store(1.0f);
+    tvp.filtCutoff.store(3000.0f);
+    tvp.filtRes.store(0.4f);
+    tvp.dispAmt.store(0.3f);
+}
+
+struct CachedSynth
+{
+    FMSynth synth;
+    NoteCache cache;
+
+    explicit CachedSynth(TestVoiceParams& tvp, int numVoices = 2)
+    {
+        tvp.params.renderCache = &cache;
+        cache.prepare(kSR);
+        synth.addSound(new FMSound());
+        for (int i = 0; i < numVoices; ++i)
+            synth.addVoice(new FMVoice(tvp.params));
+        synth.setCurrentPlaybackSampleRate(kSR);
+        for (int i = 0; i < synth.getNumVoices(); ++i)
+            static_cast<FMVoice*>(synth.getVoice(i))->prepareToPlay(kSR, 512);
+    }
+
+    // One hit: note-on at 0, note-off after holdSamples (a multiple of
+    // blockSize), then the tail.
+    // onBlock(pos) runs before each block (parameter changes).
+    template <typename OnBlock>
+    juce::AudioBuffer<float> hit(int holdSamples, int blockSize, OnBlock&& onBlock)
+    {
+        juce::AudioBuffer<float> buffer(2, kHitLength);
+        buffer.clear();
+        juce::MidiBuffer midi;
+
+        synth.noteOn(1, 48, 0.9f);
+        for (int pos = 0; pos < kHitLength; pos += blockSize)
+        {
+            if (pos == holdSamples)
+                synth.noteOff(1, 48, 0.0f, true);
+            onBlock(pos);
+            synth.renderNextBlock(buffer, midi, pos, std::min(blockSize, kHitLength - pos));
+        }
+        return buffer;
+    }
+
+    juce::AudioBuffer<float> hit(int holdSamples, int blockSize = 128)
+    {
+        return hit(holdSamples, blockSize, [](int) {});
+    }
+};
+
+static float maxAbsDiff(const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b)
+{
+    float diff = 0.0f;
+    for (int ch = 0; ch < a.getNumChannels(); ++ch)
+        for (int i = 0; i < a.getNumSamples(); ++i)
+            diff = std::max(diff, std::fabs(a.getSample(ch, i) - b.getSample(ch, i)));
+    return diff;
+}
+
+TEST_CASE("NoteCache - Replayed hit matches the recorded hit", "[notecache]")
+{
+    TestVoiceParams tvp;
+    setupDrumPatch(tvp);
+    CachedSynth s(tvp);
+
+    // Released inside the window, then held past it
+    for (int hold : { 2048, 8192 })
+    {
+        auto recorded = s.hit(hold);
+        const auto hitsBefore = s.cache.getHitCount();
+        auto replayed = s.hit(hold);
+
+        REQUIRE(s.cache.getHitCount() == hitsBefore + 1);
+        REQUIRE_FALSE(test::isSilent(recorded));
+        REQUIRE_FALSE(test::hasNaN(replayed));
+        // Tail decayed: the voice is free again for the next hit
+        REQUIRE(test::peakAmplitude(recorded.getReadPointer(0, kHitLength - 512), 512) < 1.0e-4f);
+        REQUIRE(maxAbsDiff(recorded, replayed) == 0.0f);
+    }
+}
+
+TEST_CASE("NoteCache - Early release resumes from a snapshot", "[notecache]")
+{
+    TestVoiceParams tvp;
+    setupDrumPatch(tvp);
+
+    // Reference: the short hit rendered live (first hit of a fresh cache)
+    CachedSynth ref(tvp);
+    auto expected = ref.hit(1000, 200);
+
+    // Same short hit, replayed from an entry recorded by a longer hit:
+    // note-off lands between two snapshots
+    CachedSynth s(tvp);
+    s.hit(8000, 200);
+    auto replayed = s.hit(1000, 200);
+
+    REQUIRE(s.cache.getHitCount() == 1);
+    REQUIRE(maxAbsDiff(expected, replayed) < 1.0e-5f);
+}
+
+TEST_CASE("NoteCache - Parameter change leaves playback", "[notecache]")
+{
+    TestVoiceParams tvp;
+    setupDrumPatch(tvp);
+    auto sweep = [&tvp](int pos) { tvp.filtCutoff.store(pos >= 1024 ? 800.0f : 3000.0f); };
+
+    CachedSynth ref(tvp);
+    auto expected = ref.hit(8192, 128, sweep);
+
+    tvp.filtCutoff.store(3000.0f);
+    CachedSynth s(tvp);
+    s.hit(8192);
+    auto replayed = s.hit(8192, 128, sweep);
+
+    REQUIRE(s.cache.getHitCount() == 1);
+    REQUIRE(maxAbsDiff(expected, replayed) < 1.0e-5f);
+}
+
+TEST_CASE("NoteCache - Non-deterministic patches render live", "[notecache]")
+{
+    for (int variant = 0; variant < 3; ++variant)
+    {
+        TestVoiceParams tvp;
+        setupDrumPatch(tvp);
+        if (variant == 0) tvp.carDrift.store(0.3f);
+        if (variant == 1) tvp.carNoise.store(0.2f);
+        if (variant == 2) tvp.tremor.store(0.5f);
+
+        CachedSynth s(tvp);
+        s.hit(2048);
+        auto second = s.hit(2048);
+
+        REQUIRE(s.cache.getHitCount() == 0);
+        REQUIRE_FALSE(test::isSilent(second));
+    }
+}
+
+TEST_CASE("NoteCache - Disabled by default", "[notecache]")
+{
+    TestVoiceParams tvp;
+    setupDrumPatch(tvp);
+    tvp.noteCache.store(0.0f);
+
+    CachedSynth s(tvp);
+    s.hit(2048);
+    s.hit(2048);
+    REQUIRE(s.cache.getHitCount() == 0);
+}
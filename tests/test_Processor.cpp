@@ -68,3 +68,70 @@ TEST_CASE("Processor - Parameter layout is complete", "[processor]")
     REQUIRE(proc.apvts.getParameter("CORTEX") != nullptr);
     REQUIRE(proc.apvts.getParameter("ICHOR") != nullptr);
 }
+
+TEST_CASE("Processor - Internal rate resamples at high host rates", "[processor]")
+{
+    ParasiteProcessor proc;
+    proc.apvts.getParameter("INTERNAL_RATE")->setValueNotifyingHost(1.0f);
+
+    // 44.1k host: nothing to gain, runs at the host rate
+    proc.prepareToPlay(kSR, kBlock);
+    REQUIRE(proc.getLatencySamples() == 0);
+
+    for (double hostRate : { 96000.0, 192000.0 })
+    {
+        proc.prepareToPlay(hostRate, kBlock);
+        // Half-band interpolator delay at the host rate (31 at 2×, 71 at 4×)
+        REQUIRE(proc.getLatencySamples() == (hostRate > 100000.0 ? 71 : 31));
+
+        // Block sizes that aren't multiples of the factor
+        auto midi = test::createNoteOnBuffer(60, 0.8f, 3);
+        float peak = 0.0f;
+        for (int blockSize : { 333, 511, 2, 1, 480 })
+        {
+            juce::AudioBuffer<float> buffer(2, blockSize);
+            proc.processBlock(buffer, midi);
+            midi.clear();
+            REQUIRE_FALSE(test::hasNaN(buffer));
+            peak = std::max(peak, test::peakAmplitude(buffer));
+        }
+        REQUIRE(peak > 1.0e-3f);
+    }
+}
+
+TEST_CASE("Processor - Output independent of host block size on the sub-block grid", "[processor]")
+{
+    auto render = [](int blockSize)
+    {
+        ParasiteProcessor proc;
+        auto set = [&proc](const char* id, float value)
+        {
+            auto* p = proc.apvts.getParameter(id);
+            p->setValueNotifyingHost(p->convertTo0to1(value));
+        };
+        // Global LFO on pitch: per-host-block ticking would show up here
+        set("LFO1_DEST1", static_cast<float>(bb::LFODest::Pitch));
+        set("LFO1_AMT1", 0.5f);
+        set("LFO1_RATE", 6.0f);
+        proc.prepareToPlay(kSR, blockSize);
+
+        constexpr int kTotal = 4096;
+        juce::AudioBuffer<float> out(2, kTotal);
+        auto midi = test::createNoteOnBuffer(60, 0.8f, 0);
+        for (int pos = 0; pos < kTotal; pos += blockSize)
+        {
+            juce::AudioBuffer<float> block(2, blockSize);
+            proc.processBlock(block, midi);
+            midi.clear();
+            for (int ch = 0; ch < 2; ++ch)
+                out.copyFrom(ch, pos, block, ch, 0, blockSize);
+        }
+        return out;
+    };
+
+    auto a = render(512);
+    auto b = render(64);
+    for (int ch = 0; ch < 2; ++ch)
+        for (int i = 0; i < a.getNumSamples(); ++i)
+            REQUIRE(a.getSample(ch, i) == b.getSample(ch, i));
+}
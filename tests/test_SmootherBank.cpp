@@ -0,0 +1,79 @@
+// test_SmootherBank.cpp — Tests for bb::SmootherBank
+#include <catch2/catch_test_macros.hpp>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "dsp/SmootherBank.h"
+
+using namespace bb;
+
+static constexpr double kSR = 44100.0;
+static constexpr int kSub = 32;
+
+TEST_CASE("SmootherBank - Ramps match juce::SmoothedValue exactly", "[smoother]")
+{
+    constexpr int N = 4;
+    SmootherBank<N> bank;
+    juce::SmoothedValue<float> expected[N];
+    const double times[N] = { 0.02, 0.01, 0.005, 0.0 };
+    for (int k = 0; k < N; ++k)
+    {
+        bank.reset(k, kSR, times[k]);
+        expected[k].reset(kSR, times[k]);
+    }
+
+    // Cibles changées en cours de rampe, sous-blocs de tailles diverses
+    const float targets[] = { 0.3f, -1.0f, 0.3001f, 5.0f, 5.0f, 0.0f };
+    const int sizes[] = { 7, 32, 1, 19, 32, 32 };
+    float ramp[N][kSub];
+    for (int blk = 0; blk < 40; ++blk)
+    {
+        for (int k = 0; k < N; ++k)
+        {
+            const float t = targets[(blk / 3 + k) % 6] * static_cast<float>(k + 1);
+            bank.setTargetValue(k, t);
+            expected[k].setTargetValue(t);
+        }
+
+        const int n = sizes[blk % 6];
+        uint32_t wasMoving = 0;
+        for (int k = 0; k < N; ++k)
+            wasMoving |= static_cast<uint32_t>(expected[k].isSmoothing()) << k;
+
+        const uint32_t moving = bank.render(ramp, n);
+        REQUIRE(moving == wasMoving);
+        for (int k = 0; k < N; ++k)
+        {
+            for (int i = 0; i < n; ++i)
+                REQUIRE(ramp[k][i] == expected[k].getNextValue());
+            REQUIRE(bank.getCurrentValue(k) == expected[k].getCurrentValue());
+            REQUIRE(bank.isSmoothing(k) == expected[k].isSmoothing());
+        }
+    }
+}
+
+TEST_CASE("SmootherBank - Settled smoothers are constant and unmasked ones stay put", "[smoother]")
+{
+    SmootherBank<3> bank;
+    for (int k = 0; k < 3; ++k)
+        bank.reset(k, kSR, 0.02);
+    bank.setCurrentAndTargetValue(0, 0.5f);
+    bank.setTargetValue(1, 1.0f);
+    bank.setTargetValue(2, 1.0f);
+
+    float ramp[3][kSub];
+    const uint32_t moving = bank.render(ramp, kSub, 0b011);
+    REQUIRE(moving == 0b010);
+    for (int i = 0; i < kSub; ++i)
+        REQUIRE(ramp[0][i] == 0.5f);
+    REQUIRE(ramp[1][kSub - 1] > 0.0f);
+
+    // Hors masque : n'avance pas
+    REQUIRE(bank.getCurrentValue(2) == 0.0f);
+    REQUIRE(bank.isSmoothing(2));
+
+    // skip jusqu'au bout : sur la cible, plus rien ne bouge
+    REQUIRE(bank.skip(2, 100000) == 1.0f);
+    bank.settleAll();
+    REQUIRE(bank.movingMask() == 0u);
+    REQUIRE(bank.render(ramp, kSub) == 0u);
+    REQUIRE(ramp[1][0] == 1.0f);
+}
@@ -0,0 +1,61 @@
+// test_VoiceWorkerPool.cpp — Tests for bb::VoiceWorkerPool
+#include <catch2/catch_test_macros.hpp>
+#include "dsp/VoiceWorkerPool.h"
+#include <array>
+
+using namespace bb;
+
+namespace {
+struct Counters
+{
+    std::array<int, VoiceWorkerPool::kMaxWorkers + 1> runs {};
+};
+
+void countJob(void* context, int jobIndex) noexcept
+{
+    ++static_cast<Counters*>(context)->runs[static_cast<size_t>(jobIndex)];
+}
+}
+
+TEST_CASE("VoiceWorkerPool - Every job runs once per call", "[pool]")
+{
+    VoiceWorkerPool pool;
+    pool.start(3);
+    REQUIRE(pool.getNumWorkers() == 3);
+
+    // Back-to-back calls (workers held spinning for the block) and calls
+    // after endBlock and a pause (sleeping workers) both complete every
+    // job before returning
+    Counters c;
+    for (int call = 0; call < 2000; ++call)
+    {
+        pool.run(4, &countJob, &c);
+        if (call % 500 == 0)
+        {
+            pool.endBlock();
+            juce::Thread::sleep(20);
+        }
+    }
+    for (int j = 0; j < 4; ++j)
+        REQUIRE(c.runs[static_cast<size_t>(j)] == 2000);
+}
+
+TEST_CASE("VoiceWorkerPool - Jobs beyond the workers are not run", "[pool]")
+{
+    Counters c;
+    VoiceWorkerPool pool;
+
+    // No workers: only the caller's job
+    pool.run(4, &countJob, &c);
+    REQUIRE(c.runs[0] == 1);
+    REQUIRE(c.runs[1] == 0);
+
+    pool.start(1);
+    pool.run(4, &countJob, &c);
+    REQUIRE(c.runs[0] == 2);
+    REQUIRE(c.runs[1] == 1);
+    REQUIRE(c.runs[2] == 0);
+
+    pool.stop();
+    REQUIRE(pool.getNumWorkers() == 0);
+}